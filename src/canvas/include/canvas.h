@@ -42,6 +42,9 @@ class Canvas final {
     // write the current canvas contents to a PPM file
     std::string WritePPM() const;
 
+    // as above, in the binary (P6) variant of the format; far smaller and faster to write
+    std::string WriteBinaryPPM() const;
+
    private:
     static double Clamp(double d, double min = 0.0, double max = 0.999);
 
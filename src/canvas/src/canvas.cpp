@@ -63,3 +63,24 @@ std::string canvas::Canvas::WritePPM() const {
 
     return out_str.str();
 }
+
+std::string canvas::Canvas::WriteBinaryPPM() const {
+    std::string out_str =
+        "P6\n" + std::to_string(width_) + " " + std::to_string(height_) + "\n255\n";
+    const size_t header_size = out_str.size();
+    out_str.resize(header_size + width_ * height_ * 3);
+
+    size_t idx = header_size;
+    for (size_t y = 0; y < height_; ++y) {
+        for (size_t x = 0; x < width_; ++x) {
+            const commontypes::Color color = GetPixel(x, y);
+            for (size_t i = 0; i < 3; ++i) {
+                // same scaling as the text variant
+                const int out_val = static_cast<int>(256.0 * Canvas::Clamp(color[i]));
+                out_str[idx++] = static_cast<char>(out_val);
+            }
+        }
+    }
+
+    return out_str;
+}
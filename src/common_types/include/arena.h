@@ -0,0 +1,147 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace commontypes {
+// bytes requested from one (or more) Arenas over their lifetime, split by where they came from.
+// allocations that never go through an Arena aren't counted here; the process-wide heap totals
+// are among the render instrumentation's counters
+struct ArenaStats {
+    size_t arena_bytes_{0};      // served by bumping a pointer in one of the Arena's blocks
+    size_t oversized_bytes_{0};  // too large (or over-aligned) for a block; went to the heap
+
+    ArenaStats& operator+=(const ArenaStats& other) {
+        arena_bytes_ += other.arena_bytes_;
+        oversized_bytes_ += other.oversized_bytes_;
+        return *this;
+    }
+};
+
+// Bump allocator for render-time temporaries. Nothing is freed individually; `Reset` rewinds
+// the Arena, retaining its blocks for reuse. Each render thread owns one, and it's expected to
+// be reset once every temporary allocated from it is gone (e.g. after each pixel).
+class Arena {
+   public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    explicit Arena(size_t block_size = DEFAULT_BLOCK_SIZE);
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* Allocate(size_t n_bytes, size_t alignment = alignof(std::max_align_t));
+
+    // rewind to the start of the first block; invalidates everything allocated so far
+    void Reset();
+
+    inline size_t block_size() const { return block_size_; }
+    inline size_t n_blocks() const { return blocks_.size(); }
+    inline const ArenaStats& stats() const { return stats_; }
+    inline void ResetStats() { stats_ = {}; }
+
+    // the Arena bound to the calling thread by an `ArenaScope`; nullptr when none is active
+    static Arena* Current();
+
+   private:
+    friend class ArenaScope;
+
+    struct Block {
+        std::unique_ptr<std::byte[]> data_;
+        size_t size_;
+    };
+
+    // an allocation that didn't fit a block; released on the next `Reset`
+    struct HeapAllocation {
+        void* ptr_;
+        size_t alignment_;
+    };
+
+    void* AllocateFromHeap(size_t n_bytes, size_t alignment);
+    void ReleaseHeapAllocations();
+
+    size_t block_size_;
+    std::vector<Block> blocks_;
+    size_t current_block_{0};  // index of the block currently being bumped
+    size_t offset_{0};         // offset of the next free byte in the current block
+    std::vector<HeapAllocation> heap_allocations_;
+    ArenaStats stats_;
+};
+
+// binds an Arena to the calling thread for the lifetime of the scope, restoring the previously
+// bound Arena (if any) afterward
+class ArenaScope {
+   public:
+    explicit ArenaScope(Arena& arena);
+    ~ArenaScope();
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+   private:
+    Arena* previous_;
+};
+
+// Standard allocator that draws from the Arena bound to the constructing thread. Without a bound
+// Arena it falls back to the global heap, so containers using it work identically outside a
+// render (e.g. in the test suite). Deallocation of Arena memory is a no-op.
+template <typename T>
+class ArenaAllocator {
+   public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    ArenaAllocator() noexcept : arena_(Arena::Current()) {}
+
+    explicit ArenaAllocator(Arena* arena) noexcept : arena_(arena) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena()) {}
+
+    inline Arena* arena() const { return arena_; }
+
+    T* allocate(const size_t n) {
+        if (arena_ != nullptr) {
+            return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+        }
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* ptr, const size_t n) noexcept {
+        if (arena_ == nullptr) {
+            std::allocator<T>{}.deallocate(ptr, n);
+        }
+    }
+
+   private:
+    Arena* arena_;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a1, const ArenaAllocator<U>& a2) {
+    return a1.arena() == a2.arena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a1, const ArenaAllocator<U>& a2) {
+    return !(a1 == a2);
+}
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+// as std::make_shared, but the object and its control block are placed in the current Arena
+template <typename T, typename... Args>
+std::shared_ptr<T> MakeArenaShared(Args&&... args) {
+    return std::allocate_shared<T>(ArenaAllocator<T>{}, std::forward<Args>(args)...);
+}
+}  // namespace commontypes
+
+#endif  // ARENA_H
@@ -0,0 +1,132 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+// Opt-in counters for the render hot paths. The counters themselves are always available, but the
+// INSTRUMENT_* macros placed throughout the renderer compile to nothing unless the build is
+// configured with -DRAYTRACER_INSTRUMENTATION=ON.
+namespace instrumentation {
+#ifdef RAYTRACER_INSTRUMENTATION
+constexpr bool ENABLED = true;
+#else
+constexpr bool ENABLED = false;
+#endif
+
+enum class RayKind : uint8_t { kPrimary, kShadow, kReflect, kRefract, kCount };
+
+enum class ShapeKind : uint8_t {
+    kSphere,
+    kPlane,
+    kCube,
+    kCylinder,
+    kCone,
+    kTriangle,
+    kGroup,
+    kMeshTriangle,  // one per triangle of a TriangleMesh tested
+    kInstance,
+    kCSG,
+    kCount
+};
+
+// timings are inclusive; e.g. `kIntersect` includes the time spent in nested Intersect calls.
+// a hit's surface color is found once, outside `kLighting`, and timed as `kPatternAtShape`
+enum class Phase : uint8_t {
+    kIntersect,
+    kPrepareComputations,
+    kLighting,
+    kPatternAtShape,
+    kCount
+};
+
+constexpr size_t N_RAY_KINDS = static_cast<size_t>(RayKind::kCount);
+constexpr size_t N_SHAPE_KINDS = static_cast<size_t>(ShapeKind::kCount);
+constexpr size_t N_PHASES = static_cast<size_t>(Phase::kCount);
+
+const char* RayKindName(RayKind kind);
+const char* ShapeKindName(ShapeKind kind);
+const char* PhaseName(Phase phase);
+
+struct Counters {
+    uint64_t rays_[N_RAY_KINDS];
+    uint64_t intersection_tests_[N_SHAPE_KINDS];
+    uint64_t matrix_inversions_;
+    uint64_t heap_allocations_;
+    uint64_t heap_bytes_;
+    uint64_t phase_calls_[N_PHASES];
+    uint64_t phase_nanoseconds_[N_PHASES];
+
+    Counters& operator+=(const Counters& other);
+};
+
+// counters for the calling thread; these are only ever touched by their owning thread
+Counters& ThreadCounters();
+
+// add the calling thread's counters to the process-wide totals and zero them; invoked by each
+// render thread once it has finished its share of the frame
+void MergeThreadCounters();
+
+Counters TotalCounters();
+
+void ResetTotalCounters();
+
+// write the process-wide totals in a human-readable form
+void OutputReport(std::ostream& out);
+
+inline void CountRay(const RayKind kind) {
+    ++ThreadCounters().rays_[static_cast<size_t>(kind)];
+}
+
+inline void CountIntersectionTest(const ShapeKind kind) {
+    ++ThreadCounters().intersection_tests_[static_cast<size_t>(kind)];
+}
+
+inline void CountMatrixInversion() {
+    ++ThreadCounters().matrix_inversions_;
+}
+
+// accumulates the time spent between construction and destruction against `phase`
+class ScopedPhaseTimer {
+   public:
+    explicit ScopedPhaseTimer(const Phase phase)
+        : phase_(phase), start_(std::chrono::steady_clock::now()) {}
+
+    ~ScopedPhaseTimer() {
+        const auto elapsed = std::chrono::steady_clock::now() - start_;
+        Counters& counters = ThreadCounters();
+        ++counters.phase_calls_[static_cast<size_t>(phase_)];
+        counters.phase_nanoseconds_[static_cast<size_t>(phase_)] +=
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    }
+
+    ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+    ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+
+   private:
+    Phase phase_;
+    std::chrono::steady_clock::time_point start_;
+};
+}  // namespace instrumentation
+
+#define INSTRUMENT_CONCAT_IMPL(a, b) a##b
+#define INSTRUMENT_CONCAT(a, b) INSTRUMENT_CONCAT_IMPL(a, b)
+
+#ifdef RAYTRACER_INSTRUMENTATION
+#define INSTRUMENT_COUNT_RAY(kind) instrumentation::CountRay(instrumentation::RayKind::kind)
+#define INSTRUMENT_COUNT_INTERSECTION_TEST(kind) \
+    instrumentation::CountIntersectionTest(instrumentation::ShapeKind::kind)
+#define INSTRUMENT_COUNT_MATRIX_INVERSION() instrumentation::CountMatrixInversion()
+#define INSTRUMENT_PHASE(phase)                                 \
+    const instrumentation::ScopedPhaseTimer INSTRUMENT_CONCAT(  \
+        phase_timer_, __LINE__)(instrumentation::Phase::phase)
+#else
+#define INSTRUMENT_COUNT_RAY(kind) ((void)0)
+#define INSTRUMENT_COUNT_INTERSECTION_TEST(kind) ((void)0)
+#define INSTRUMENT_COUNT_MATRIX_INVERSION() ((void)0)
+#define INSTRUMENT_PHASE(phase) ((void)0)
+#endif
+
+#endif  // INSTRUMENTATION_H
@@ -3,6 +3,8 @@
 
 #include <chrono>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <iomanip>
 #include <iostream>
@@ -24,6 +26,65 @@ inline bool NearEquals(const double a, const double b) {
     return (fabs(a - b) <= EPSILON_ || a == b);
 }
 
+// 2^x, to a relative error of about 2e-5, for x <= 0
+inline double FastExp2(const double x) {
+    if (x < -1022.0) {
+        return 0.0;
+    }
+    const double floor_x = std::floor(x);
+    const double f = (x - floor_x) * 0.6931471805599453;  // 2^frac(x) is e^(frac(x) * ln 2)
+    const double exp_f =
+        1 + f * (1 + f * (1 / 2.0 + f * (1 / 6.0 + f * (1 / 24.0 + f * (1 / 120.0 + f / 720)))));
+
+    // 2^floor(x), built directly from its exponent bits
+    const uint64_t bits = static_cast<uint64_t>(static_cast<int64_t>(floor_x) + 1023) << 52;
+    double scale;
+    std::memcpy(&scale, &bits, sizeof(scale));
+    return exp_f * scale;
+}
+
+// log2(x), to an absolute error of about 2e-6, for (normal) x > 0
+inline double FastLog2(const double x) {
+    uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    const auto exponent = static_cast<int64_t>((bits >> 52) & 0x7ff) - 1023;
+
+    // x's mantissa m, in [1, 2); ln(m) = 2 atanh(s) for s = (m - 1) / (m + 1), which is < 1/3
+    bits = (bits & 0xfffffffffffffULL) | (1023ULL << 52);
+    double m;
+    std::memcpy(&m, &bits, sizeof(m));
+    const double s = (m - 1.0) / (m + 1.0);
+    const double s2 = s * s;
+    const double ln_m = 2 * s * (1 + s2 * (1 / 3.0 + s2 * (1 / 5.0 + s2 * (1 / 7.0 + s2 / 9))));
+    return static_cast<double>(exponent) + ln_m * 1.4426950408889634;
+}
+
+// an approximation of pow(base, exponent) for base in [0, 1] and exponent >= 0, such as a
+// specular highlight. the integral part of the exponent is applied exactly (by repeated
+// squaring) and only the fractional part is approximated, so the relative error is about 2e-5
+inline double FastPow(const double base, const double exponent) {
+    auto n = static_cast<uint64_t>(exponent);
+    const double fraction = exponent - static_cast<double>(n);
+
+    double result = 1.0;
+    double square = base;
+    while (n > 0) {
+        if (n & 1) {
+            result *= square;
+        }
+        square *= square;
+        n >>= 1;
+    }
+
+    if (fraction == 0.0 || result == 0.0) {
+        return result;
+    }
+    if (base <= 0.0) {
+        return 0.0;
+    }
+    return result * FastExp2(fraction * FastLog2(base));
+}
+
 inline std::string CurrentDateStr() {
     auto t = std::time(nullptr);
     auto tm = *std::localtime(&t);
@@ -0,0 +1,76 @@
+#include "arena.h"
+#include <cstdint>
+
+namespace {
+thread_local commontypes::Arena* current_arena = nullptr;
+
+inline size_t AlignUp(const uintptr_t address, const size_t alignment) {
+    return (address + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+}
+}  // namespace
+
+commontypes::Arena::Arena(const size_t block_size) : block_size_(block_size) {}
+
+commontypes::Arena::~Arena() {
+    ReleaseHeapAllocations();
+}
+
+void* commontypes::Arena::Allocate(const size_t n_bytes, const size_t alignment) {
+    // blocks are only guaranteed to be aligned for fundamental types
+    if (n_bytes > block_size_ || alignment > alignof(std::max_align_t)) {
+        return AllocateFromHeap(n_bytes, alignment);
+    }
+
+    while (true) {
+        if (current_block_ == blocks_.size()) {
+            blocks_.push_back(Block{std::make_unique<std::byte[]>(block_size_), block_size_});
+            offset_ = 0;
+        }
+
+        Block& block = blocks_[current_block_];
+        const auto base = reinterpret_cast<uintptr_t>(block.data_.get());
+        const size_t aligned_offset = AlignUp(base + offset_, alignment) - base;
+
+        if (aligned_offset + n_bytes <= block.size_) {
+            offset_ = aligned_offset + n_bytes;
+            stats_.arena_bytes_ += n_bytes;
+            return block.data_.get() + aligned_offset;
+        }
+
+        // current block is exhausted; move on to the next (allocating it if needed)
+        ++current_block_;
+        offset_ = 0;
+    }
+}
+
+void commontypes::Arena::Reset() {
+    ReleaseHeapAllocations();
+    current_block_ = 0;
+    offset_ = 0;
+}
+
+commontypes::Arena* commontypes::Arena::Current() {
+    return current_arena;
+}
+
+void* commontypes::Arena::AllocateFromHeap(const size_t n_bytes, const size_t alignment) {
+    void* ptr = ::operator new(n_bytes, std::align_val_t{alignment});
+    heap_allocations_.push_back(HeapAllocation{ptr, alignment});
+    stats_.oversized_bytes_ += n_bytes;
+    return ptr;
+}
+
+void commontypes::Arena::ReleaseHeapAllocations() {
+    for (const auto& allocation : heap_allocations_) {
+        ::operator delete(allocation.ptr_, std::align_val_t{allocation.alignment_});
+    }
+    heap_allocations_.clear();
+}
+
+commontypes::ArenaScope::ArenaScope(commontypes::Arena& arena) : previous_(current_arena) {
+    current_arena = &arena;
+}
+
+commontypes::ArenaScope::~ArenaScope() {
+    current_arena = previous_;
+}
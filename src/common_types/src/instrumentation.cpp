@@ -0,0 +1,214 @@
+#include "instrumentation.h"
+#include <cstdlib>
+#include <iomanip>
+#include <mutex>
+#include <new>
+
+namespace {
+// constant-initialized, so accessing it (including from `operator new` below) never allocates
+thread_local instrumentation::Counters thread_counters{};
+
+std::mutex total_counters_mutex;
+instrumentation::Counters total_counters{};
+
+constexpr const char* RAY_KIND_NAMES[] = {"primary", "shadow", "reflect", "refract"};
+constexpr const char* SHAPE_KIND_NAMES[] = {"Sphere",   "Plane",    "Cube",
+                                            "Cylinder", "Cone",     "Triangle",
+                                            "Group",    "MeshTriangle", "Instance",
+                                            "CSG"};
+constexpr const char* PHASE_NAMES[] = {"Intersect", "PrepareComputations", "Lighting",
+                                       "PatternAtShape"};
+}  // namespace
+
+const char* instrumentation::RayKindName(const instrumentation::RayKind kind) {
+    return RAY_KIND_NAMES[static_cast<size_t>(kind)];
+}
+
+const char* instrumentation::ShapeKindName(const instrumentation::ShapeKind kind) {
+    return SHAPE_KIND_NAMES[static_cast<size_t>(kind)];
+}
+
+const char* instrumentation::PhaseName(const instrumentation::Phase phase) {
+    return PHASE_NAMES[static_cast<size_t>(phase)];
+}
+
+instrumentation::Counters& instrumentation::Counters::operator+=(
+    const instrumentation::Counters& other) {
+    for (size_t i = 0; i < N_RAY_KINDS; ++i) {
+        rays_[i] += other.rays_[i];
+    }
+
+    for (size_t i = 0; i < N_SHAPE_KINDS; ++i) {
+        intersection_tests_[i] += other.intersection_tests_[i];
+    }
+
+    matrix_inversions_ += other.matrix_inversions_;
+    heap_allocations_ += other.heap_allocations_;
+    heap_bytes_ += other.heap_bytes_;
+
+    for (size_t i = 0; i < N_PHASES; ++i) {
+        phase_calls_[i] += other.phase_calls_[i];
+        phase_nanoseconds_[i] += other.phase_nanoseconds_[i];
+    }
+
+    return *this;
+}
+
+instrumentation::Counters& instrumentation::ThreadCounters() {
+    return thread_counters;
+}
+
+void instrumentation::MergeThreadCounters() {
+    const std::lock_guard<std::mutex> lock{total_counters_mutex};
+    total_counters += thread_counters;
+    thread_counters = {};
+}
+
+instrumentation::Counters instrumentation::TotalCounters() {
+    const std::lock_guard<std::mutex> lock{total_counters_mutex};
+    return total_counters;
+}
+
+void instrumentation::ResetTotalCounters() {
+    const std::lock_guard<std::mutex> lock{total_counters_mutex};
+    total_counters = {};
+}
+
+void instrumentation::OutputReport(std::ostream& out) {
+    const Counters totals = TotalCounters();
+
+    out << "Rays:";
+    for (size_t i = 0; i < N_RAY_KINDS; ++i) {
+        out << " " << RayKindName(static_cast<RayKind>(i)) << "=" << totals.rays_[i];
+    }
+
+    out << "\nIntersection tests:";
+    for (size_t i = 0; i < N_SHAPE_KINDS; ++i) {
+        out << " " << ShapeKindName(static_cast<ShapeKind>(i)) << "="
+            << totals.intersection_tests_[i];
+    }
+
+    out << "\nMatrix inversions: " << totals.matrix_inversions_;
+    out << "\nHeap allocations: " << totals.heap_allocations_ << " (" << totals.heap_bytes_ / 1024
+        << " KiB)";
+
+    for (size_t i = 0; i < N_PHASES; ++i) {
+        const double milliseconds = static_cast<double>(totals.phase_nanoseconds_[i]) / 1e6;
+        out << "\n" << std::setw(20) << std::left << PhaseName(static_cast<Phase>(i)) << " "
+            << totals.phase_calls_[i] << " calls, " << std::fixed << std::setprecision(2)
+            << milliseconds << " ms" << std::defaultfloat;
+    }
+
+    out << "\n";
+}
+
+#ifdef RAYTRACER_INSTRUMENTATION
+// count every heap allocation made by the process. every form of new and delete is replaced,
+// including the nothrow and aligned ones (used by e.g. std::get_temporary_buffer and
+// over-aligned types), so that each allocation is counted and freed by the allocator it came from
+namespace {
+void* CountedAllocate(const size_t n_bytes, const size_t alignment) noexcept {
+    ++thread_counters.heap_allocations_;
+    thread_counters.heap_bytes_ += n_bytes;
+
+    const size_t size = n_bytes == 0 ? 1 : n_bytes;
+    if (alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+        return std::malloc(size);
+    }
+    // aligned_alloc needs a size that's a multiple of the alignment
+    return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+void* CountedAllocateOrThrow(const size_t n_bytes, const size_t alignment) {
+    if (void* ptr = CountedAllocate(n_bytes, alignment)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+}  // namespace
+
+void* operator new(const size_t n_bytes) {
+    return CountedAllocateOrThrow(n_bytes, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new[](const size_t n_bytes) {
+    return CountedAllocateOrThrow(n_bytes, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new(const size_t n_bytes, const std::nothrow_t&) noexcept {
+    return CountedAllocate(n_bytes, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new[](const size_t n_bytes, const std::nothrow_t&) noexcept {
+    return CountedAllocate(n_bytes, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void* operator new(const size_t n_bytes, const std::align_val_t alignment) {
+    return CountedAllocateOrThrow(n_bytes, static_cast<size_t>(alignment));
+}
+
+void* operator new[](const size_t n_bytes, const std::align_val_t alignment) {
+    return CountedAllocateOrThrow(n_bytes, static_cast<size_t>(alignment));
+}
+
+void* operator new(const size_t n_bytes,
+                   const std::align_val_t alignment,
+                   const std::nothrow_t&) noexcept {
+    return CountedAllocate(n_bytes, static_cast<size_t>(alignment));
+}
+
+void* operator new[](const size_t n_bytes,
+                     const std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept {
+    return CountedAllocate(n_bytes, static_cast<size_t>(alignment));
+}
+
+// malloc and aligned_alloc are both released by free
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    std::free(ptr);
+}
+#endif
@@ -1,5 +1,6 @@
 #include "matrix.h"
 #include <stdexcept>
+#include "instrumentation.h"
 #include "utility.h"
 
 commontypes::Matrix commontypes::Matrix::Transpose() const {
@@ -76,6 +77,8 @@ bool commontypes::Matrix::IsInvertible() const {
 }
 
 commontypes::Matrix commontypes::Matrix::Inverse() const {
+    INSTRUMENT_COUNT_MATRIX_INVERSION();
+
     if (!IsInvertible()) {
         throw std::invalid_argument("Matrix is not invertible");
     }
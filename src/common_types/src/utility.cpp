@@ -2,6 +2,7 @@
 #include <chrono>
 #include <filesystem>
 #include <string_view>
+#include "instrumentation.h"
 
 void utility::CreateImageOutdir(const std::string_view dirname) {
     if (!std::filesystem::exists(dirname)) {
@@ -44,4 +45,8 @@ void utility::OutputMeasuredDuration(const std::function<void()>& render_fn) {
     std::clog << "\n\rTotal Duration: " << duration.elapsed_minutes_ << "m " << output_seconds
               << "s " << output_milliseconds << " ms "
               << "\n";
+
+    if (instrumentation::ENABLED) {
+        instrumentation::OutputReport(std::clog);
+    }
 }
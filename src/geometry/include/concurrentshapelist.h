@@ -0,0 +1,38 @@
+#ifndef CONCURRENT_SHAPE_LIST_H
+#define CONCURRENT_SHAPE_LIST_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace geometry {
+class Shape;
+
+// Shapes added by any number of threads at once, without locking (the list is a Treiber stack),
+// and later taken all together by whichever thread is assembling the scene.
+class ConcurrentShapeList {
+   public:
+    ConcurrentShapeList() = default;
+    ConcurrentShapeList(const ConcurrentShapeList&) = delete;
+    ConcurrentShapeList& operator=(const ConcurrentShapeList&) = delete;
+    ~ConcurrentShapeList();
+
+    void Push(std::shared_ptr<Shape> shape);
+
+    // removes and returns every Shape pushed so far. Shapes pushed by any one thread are in the
+    // order that thread pushed them; the order across threads is unspecified
+    std::vector<std::shared_ptr<Shape>> TakeAll();
+
+    inline bool empty() const { return head_.load(std::memory_order_acquire) == nullptr; }
+
+   private:
+    struct Node {
+        std::shared_ptr<Shape> shape_;
+        Node* next_;
+    };
+
+    std::atomic<Node*> head_{nullptr};
+};
+}  // namespace geometry
+
+#endif  // CONCURRENT_SHAPE_LIST_H
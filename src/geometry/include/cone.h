@@ -22,6 +22,8 @@ class Cone : public Shape {
 
     commontypes::Vector LocalNormalAt(const commontypes::Point& local_point) const override;
 
+    bool ToPrimitive(Primitive& primitive) const override;
+
    private:
     // used to constrain args for CheckCap, as only the min or max values are valid arguments
     enum PlaneYCoord { kUseMaximum, kUseMinimum };
@@ -0,0 +1,56 @@
+#ifndef CSG_H
+#define CSG_H
+
+#include <memory>
+#include <vector>
+#include "shape.h"
+
+namespace geometry {
+// Constructive Solid Geometry: the union, intersection or difference of two Shapes (either of
+// which may itself be a Group or CSG), acting as their parent as a Group does (see pg. 227)
+class CSG : public Shape {
+   public:
+    enum class Operation { kUnion, kIntersection, kDifference };
+
+    // throws std::invalid_argument if either Shape is missing or already has a parent
+    CSG(Operation operation, std::shared_ptr<Shape> left, std::shared_ptr<Shape> right);
+
+    inline Operation operation() const { return operation_; }
+    inline const std::shared_ptr<Shape>& left() const { return left_; }
+    inline const std::shared_ptr<Shape>& right() const { return right_; }
+
+    // whether an intersection with the left (`left_hit`) or right Shape survives `operation`,
+    // given whether it lies inside the left (`in_left`) and right (`in_right`) Shapes (see
+    // pg. 230)
+    static bool IntersectionAllowed(Operation operation,
+                                    bool left_hit,
+                                    bool in_left,
+                                    bool in_right);
+
+    // the intersections (in ascending order) that lie on the surface of the combined Shape
+    std::vector<Intersection> FilterIntersections(const std::vector<Intersection>& xs) const;
+
+    // merges the children's intersections, which are each already in ascending order, rather
+    // than sorting them. the right Shape isn't intersected at all when the left one is missed and
+    // the result would be empty regardless (for an intersection or difference)
+    std::vector<Intersection> LocalIntersect(const commontypes::Ray& ray) const override;
+
+    // the normal is always that of the child that was hit, so this throws std::logic_error
+    commontypes::Vector LocalNormalAt(const commontypes::Point& local_point) const override;
+
+    void CacheTransforms() const override;
+
+    void InvalidateTransforms() override;
+
+    void IndexMaterials(lighting::MaterialTable& table) const override;
+
+    bool Includes(const Shape& other) const override;
+
+   private:
+    Operation operation_;
+    std::shared_ptr<Shape> left_;
+    std::shared_ptr<Shape> right_;
+};
+}  // namespace geometry
+
+#endif  // CSG_H
@@ -14,6 +14,8 @@ class Cube : public Shape {
 
     commontypes::Vector LocalNormalAt(const commontypes::Point& local_point) const override;
 
+    bool ToPrimitive(Primitive& primitive) const override;
+
    private:
     std::tuple<double, double> CheckAxis(double origin, double direction) const;
 };
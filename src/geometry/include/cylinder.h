@@ -29,6 +29,8 @@ class Cylinder : public Shape {
 
     commontypes::Vector LocalNormalAt(const commontypes::Point& local_point) const override;
 
+    bool ToPrimitive(Primitive& primitive) const override;
+
    private:
     static bool CheckCap(const commontypes::Ray& ray, double t);
 
@@ -1,6 +1,8 @@
 #ifndef GROUP_H
 #define GROUP_H
 
+#include <memory>
+#include "concurrentshapelist.h"
 #include "shape.h"
 
 // Group allows for collecting several Shapes as a single unit, where the Group acts as the parent
@@ -8,7 +10,7 @@
 namespace geometry {
 class Group : public Shape {
    public:
-    Group() : Shape() {}
+    Group() : Shape(), pending_children_(std::make_unique<ConcurrentShapeList>()) {}
 
     const std::vector<std::shared_ptr<Shape>> GetChildren() const { return this->children_; }
 
@@ -16,12 +18,29 @@ class Group : public Shape {
 
     void AddChildrenToGroup(std::initializer_list<std::shared_ptr<Shape>>& children);
 
+    // may be called from any number of threads at once (e.g. by loader threads), unlike the
+    // above. the Shape only becomes a child at the next `CommitPendingChildren`
+    void AddChildConcurrently(std::shared_ptr<Shape> shape_ptr);
+
+    // adds the Shapes passed to `AddChildConcurrently` as children, here and in every Group
+    // beneath this one. World::Finalize does this for every Group in the World
+    void CommitPendingChildren();
+
     std::vector<Intersection> LocalIntersect(const commontypes::Ray& ray) const override;
 
     commontypes::Vector LocalNormalAt(const commontypes::Point& local_point) const override;
 
+    void CacheTransforms() const override;
+
+    void InvalidateTransforms() override;
+
+    void IndexMaterials(lighting::MaterialTable& table) const override;
+
+    bool Includes(const Shape& other) const override;
+
    private:
     std::vector<std::shared_ptr<Shape>> children_;
+    std::unique_ptr<ConcurrentShapeList> pending_children_;
 };
 }  // namespace geometry
 
@@ -0,0 +1,60 @@
+#ifndef INSTANCE_H
+#define INSTANCE_H
+
+#include <memory>
+#include "shape.h"
+
+namespace geometry {
+// Places a shared prototype (a Shape, Group or TriangleMesh that isn't itself part of the scene)
+// under a transform of its own, so the same geometry may appear any number of times without being
+// copied. The prototype's own transforms and Materials apply as usual, unless this Instance
+// overrides the Material of everything in it.
+class Instance : public Shape {
+   public:
+    // throws std::invalid_argument if `prototype` belongs to a Group; its parents' transforms
+    // would otherwise apply to its normals but not to its intersections
+    explicit Instance(std::shared_ptr<const Shape> prototype);
+
+    inline const std::shared_ptr<const Shape>& prototype() const { return prototype_; }
+
+    // nullptr (the default) for the prototype's own Materials
+    inline const std::shared_ptr<lighting::Material>& material_override() const {
+        return material_override_;
+    }
+
+    inline void SetMaterialOverride(const std::shared_ptr<lighting::Material>& material) {
+        material_override_ = material;
+        override_index_ = lighting::MaterialTable::NO_INDEX;
+    }
+
+    // each Intersection refers to a copy of this Instance, which records the prototype's own
+    // Intersection and has the Material of the Shape that was hit
+    std::vector<Intersection> LocalIntersect(const commontypes::Ray& ray) const override;
+
+    // a normal needs the prototype's Intersection, so this throws std::logic_error
+    commontypes::Vector LocalNormalAt(const commontypes::Point& local_point) const override;
+
+    // the normal of the Shape hit within the prototype, in this Instance's object space
+    commontypes::Vector LocalNormalAt(const commontypes::Point& local_point,
+                                      const Intersection& hit) const override;
+
+    // for a copy held by an Intersection, the prototype hit's SurfaceId combined with this
+    // Instance's id, so that hits on different Shapes within one Instance (e.g. a glass Sphere
+    // and an air bubble inside it) are told apart, as are the same Shape's hits in two Instances
+    uint64_t SurfaceId() const override;
+
+    // along with the prototype's, which don't depend on this Instance's transform
+    void CacheTransforms() const override;
+
+    // along with the prototype's and the override
+    void IndexMaterials(lighting::MaterialTable& table) const override;
+
+   private:
+    std::shared_ptr<const Shape> prototype_;
+    std::shared_ptr<lighting::Material> material_override_;
+    mutable uint32_t override_index_{lighting::MaterialTable::NO_INDEX};
+    Intersection prototype_hit_;  // only for the copies held by Intersections
+};
+}  // namespace geometry
+
+#endif  // INSTANCE_H
@@ -41,11 +41,27 @@ struct Computations {
 
 class Intersection {
    public:
-    Intersection() : t_(0), object_(nullptr) {}
+    Intersection() : t_(0), object_(nullptr), u_(0), v_(0), triangle_idx_(0) {}
 
     explicit Intersection(const double t, const std::shared_ptr<Shape>& object_ptr)
-        : t_(t), object_(object_ptr) {}
-
+        : t_(t), object_(object_ptr), u_(0), v_(0), triangle_idx_(0) {}
+
+    // for Intersections with triangles, which record where on the triangle the hit occurred
+    explicit Intersection(const double t,
+                          const std::shared_ptr<Shape>& object_ptr,
+                          const double u,
+                          const double v)
+        : t_(t), object_(object_ptr), u_(u), v_(v), triangle_idx_(0) {}
+
+    // as above, for a TriangleMesh, which also records which of its triangles was hit
+    explicit Intersection(const double t,
+                          const std::shared_ptr<Shape>& object_ptr,
+                          const double u,
+                          const double v,
+                          const uint32_t triangle_idx)
+        : t_(t), object_(object_ptr), u_(u), v_(v), triangle_idx_(triangle_idx) {}
+
+    // the Intersection with the lowest non-negative t, whatever the order of `xs`
     static std::optional<Intersection> Hit(const std::vector<Intersection>& xs);
 
     // see details of the addition and purpose of the `intersections` parameter on pg. 153
@@ -63,9 +79,22 @@ class Intersection {
     double t_;
 
     std::shared_ptr<Shape> object_;  //  the Shape for which this intersection was located
+
+    // barycentric coordinates of the hit, relative to p2 and p3, for triangles (see pg. 221)
+    double u_;
+    double v_;
+
+    // of the triangle hit within a TriangleMesh; 0 for any other Shape
+    uint32_t triangle_idx_;
 };
 
 double Schlick(const Computations& comps);
+
+// merges the Intersections from `run_begin` on (one Shape's, which are usually, but needn't be,
+// in ascending order of t) into those before it, which must already be in ascending order. a
+// short run is inserted one Intersection at a time and a longer one merged in place, so a list
+// built up a Shape at a time is never sorted as a whole
+void MergeIntersections(std::vector<Intersection>& xs, size_t run_begin);
 }  // namespace geometry
 
 bool operator==(const geometry::Intersection& i1, const geometry::Intersection& i2);
@@ -0,0 +1,96 @@
+#ifndef OBJ_PARSER_H
+#define OBJ_PARSER_H
+
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "group.h"
+#include "material.h"
+#include "point.h"
+#include "trianglemesh.h"
+#include "vector.h"
+
+namespace geometry {
+// thrown for unreadable files and malformed statements; the message includes the line number
+class ObjParseError : public std::runtime_error {
+   public:
+    explicit ObjParseError(const std::string& message) : std::runtime_error(message) {}
+};
+
+// Reads Wavefront OBJ geometry (see pg. 212): vertices ("v"), vertex normals ("vn"), faces ("f")
+// and named groups ("g"). Polygons are triangulated as fans about their first vertex, and every
+// Triangle is added to the default Group or to the Group named by the most recent "g" statement.
+// Faces giving a normal for each vertex become SmoothTriangles (see pg. 224). Any other statement
+// is ignored. Files are mapped into memory and parsed in place; no string is
+// allocated per line.
+class ObjParser {
+   public:
+    enum class Output {
+        kTriangles,  // a Triangle Shape per triangle, in Groups
+        kMesh,       // only the vertex indices of each triangle, for `ToMesh`
+    };
+
+    static ObjParser ParseFile(const std::filesystem::path& path,
+                               Output output = Output::kTriangles);
+
+    static ObjParser ParseString(std::string_view text, Output output = Output::kTriangles);
+
+    // number of lines that were skipped, as the statement isn't supported
+    inline size_t ignored_lines() const { return ignored_lines_; }
+
+    inline size_t n_vertices() const { return vertices_.size(); }
+    inline size_t n_normals() const { return normals_.size(); }
+    inline size_t n_triangles() const { return n_triangles_; }
+
+    // indexed from 1, as in the file
+    const commontypes::Point& Vertex(size_t idx) const { return vertices_.at(idx - 1); }
+    const commontypes::Vector& Normal(size_t idx) const { return normals_.at(idx - 1); }
+
+    inline std::shared_ptr<Group> DefaultGroup() const { return default_group_; }
+
+    // the Group introduced by "g `name`"; nullptr if there's no such group
+    std::shared_ptr<Group> NamedGroup(std::string_view name) const;
+
+    // a single Group holding every Triangle: the default Group's Triangles along with each named
+    // Group (as a child Group). the groups are re-parented, so this should only be called once
+    std::shared_ptr<Group> ToGroup() const;
+
+    // a single TriangleMesh of every triangle, whichever group it's in; throws std::logic_error
+    // unless parsed with `Output::kMesh`
+    std::shared_ptr<TriangleMesh> ToMesh() const;
+
+   private:
+    explicit ObjParser(Output output);
+
+    void Parse(std::string_view text);
+    void ParseLine(std::string_view line);
+    void ParseFace(std::string_view rest);
+
+    // 1-based (or negative, i.e. relative to the end) index into a list of `n_elements`
+    size_t ResolveIndex(std::string_view token, size_t n_elements) const;
+
+    [[noreturn]] void Fail(const std::string& message) const;
+
+    std::vector<commontypes::Point> vertices_;
+    std::vector<commontypes::Vector> normals_;
+    std::shared_ptr<lighting::Material> material_;  // shared by every Triangle
+    std::shared_ptr<Group> default_group_;
+    std::vector<std::pair<std::string, std::shared_ptr<Group>>> named_groups_;  // in file order
+    Group* current_group_;
+    std::vector<size_t> face_vertices_;              // reused for every face
+    std::vector<size_t> face_normals_;               // empty unless each vertex has a normal
+    std::vector<uint32_t> triangle_indices_;         // three vertex indices per triangle
+    std::vector<uint32_t> triangle_normal_indices_;  // as above, or MeshData::NO_NORMAL
+    bool has_vertex_normals_;                        // true if any face gave normals
+    Output output_;
+    size_t ignored_lines_;
+    size_t n_triangles_;
+    size_t line_;
+};
+}  // namespace geometry
+
+#endif  // OBJ_PARSER_H
@@ -14,6 +14,8 @@ class Plane : public Shape {
     std::vector<Intersection> LocalIntersect(const commontypes::Ray& ray) const override;
 
     commontypes::Vector LocalNormalAt(const commontypes::Point& local_point) const override;
+
+    bool ToPrimitive(Primitive& primitive) const override;
 };
 }  // namespace geometry
 
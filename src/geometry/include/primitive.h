@@ -0,0 +1,92 @@
+#ifndef PRIMITIVE_H
+#define PRIMITIVE_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "arena.h"
+#include "intersection.h"
+#include "point.h"
+#include "ray.h"
+#include "vector.h"
+
+namespace geometry {
+class Shape;
+
+enum class PrimitiveKind : uint8_t { kSphere, kPlane, kCube, kCylinder, kCone, kTriangle };
+
+// A compact copy of a simple Shape's geometry, along with the inverse of its transform composed
+// with those of its parents; no virtual calls are needed to intersect it. The Shape itself is
+// still used for normals and Materials.
+struct Primitive {
+    struct CylinderData {
+        double minimum_, maximum_;
+        bool capped_;
+    };
+
+    struct TriangleData {
+        double p1_[3], e1_[3], e2_[3];
+    };
+
+    PrimitiveKind kind_;
+    double world_to_object_[3][4];  // the bottom row is always (0, 0, 0, 1)
+    union {
+        CylinderData cylinder_;  // for kCylinder and kCone
+        TriangleData triangle_;  // for kTriangle
+    };
+};
+
+// a ray from a point toward a light, which is occluded by any hit with 0 <= t < distance_
+struct ShadowRay {
+    static constexpr uint32_t NO_OCCLUDER = UINT32_MAX;
+
+    commontypes::Vector direction_;
+    double distance_;
+    bool occluded_;
+    uint32_t cache_slot_{0};          // see World::FindOccluded
+    uint32_t occluder_{NO_OCCLUDER};  // see PrimitiveList::FindOccluded
+};
+
+// The simple Shapes of a scene stored contiguously as Primitives and intersected by one
+// switch-dispatched loop. Groups are flattened into their children; any other Shape (a
+// TriangleMesh, Instance, etc.) is kept as is and intersected through `Shape::Intersect`.
+class PrimitiveList {
+   public:
+    // adds `shape`, or each of its descendants if it's a Group. the Primitives are copies, so the
+    // Shapes must be re-added after a transform changes
+    void Add(const std::shared_ptr<Shape>& shape);
+
+    void Clear();
+
+    // brings the Primitives up to date with Shapes whose transforms (or whose parents'
+    // transforms) changed since they were added, which are those whose cached transforms were
+    // discarded (see Shape::InvalidateTransforms), caching them again. the other Shapes are
+    // skipped, as is every Shape that was added or removed; returns the number of Primitives
+    // updated
+    size_t Refit();
+
+    inline size_t n_primitives() const { return primitives_.size(); }
+    inline const std::vector<std::shared_ptr<Shape>>& others() const { return others_; }
+
+    // adds every intersection of `ray` with the Shapes to `xs`, which is (and is kept) in
+    // ascending order of t; each Shape's intersections are merged in as they're found
+    void Intersect(const commontypes::Ray& ray, std::vector<Intersection>& xs) const;
+
+    // sets `occluded_` for each of `rays`, which all start from `origin`, and `occluder_` to the
+    // index (as for `Occludes`) of what occluded it. the rays are traced together, and each stops
+    // being traced once it's known to be occluded; rays already occluded are skipped
+    void FindOccluded(const commontypes::Point& origin,
+                      commontypes::ArenaVector<ShadowRay>& rays) const;
+
+    // whether the Shape at `idx` alone occludes `ray`; indices past the Primitives refer to
+    // `others()`
+    bool Occludes(uint32_t idx, const commontypes::Point& origin, const ShadowRay& ray) const;
+
+   private:
+    std::vector<Primitive> primitives_;
+    std::vector<std::shared_ptr<Shape>> shapes_;  // the Shape each Primitive was made from
+    std::vector<std::shared_ptr<Shape>> others_;
+};
+}  // namespace geometry
+
+#endif  // PRIMITIVE_H
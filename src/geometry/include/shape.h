@@ -1,38 +1,54 @@
 #ifndef SHAPE_H
 #define SHAPE_H
 
+#include <atomic>
 #include <memory>
+#include "arena.h"
 #include "identitymatrix.h"
 #include "intersection.h"
 #include "material.h"
+#include "materialtable.h"
 #include "matrix.h"
 #include "point.h"
 
 namespace geometry {
+struct Primitive;
+
 class Shape {
    public:
     Shape()
-        : id_(SHAPE_ID++),
-          transform_(commontypes::IdentityMatrix{}),
+        : id_(NextId()),
+          transform_(IdentityTransform()),
           material_ptr_(std::make_shared<lighting::Material>()),
           parent_(nullptr) {}
 
     explicit Shape(commontypes::Matrix& transformation_matrix,
                    std::shared_ptr<lighting::Material>& material_ptr)
-        : id_(SHAPE_ID++), transform_(transformation_matrix), material_ptr_(material_ptr) {}
+        : id_(NextId()),
+          transform_(std::make_shared<const commontypes::Matrix>(transformation_matrix)),
+          material_ptr_(material_ptr) {}
 
     inline uint64_t id() const { return id_; }
-    inline commontypes::Matrix Transform() const { return transform_; }
+    inline commontypes::Matrix Transform() const { return *transform_; }
     inline std::shared_ptr<lighting::Material> Material() const { return material_ptr_; }
 
+    // as above, without copying the shared_ptr
+    inline const lighting::Material* material() const { return material_ptr_.get(); }
+
+    // of the Material's ShadingRecord in the MaterialTable last passed to `IndexMaterials`;
+    // MaterialTable::NO_INDEX if there's none
+    inline uint32_t material_index() const { return material_index_; }
+
     inline void SetTransform(const commontypes::Matrix& transformation_matrix) {
-        transform_ = transformation_matrix;
+        transform_ = std::make_shared<const commontypes::Matrix>(transformation_matrix);
+        InvalidateTransforms();
     }
 
-    inline commontypes::Matrix GetTransform() const { return transform_; }
+    inline commontypes::Matrix GetTransform() const { return *transform_; }
 
     inline void SetMaterial(const std::shared_ptr<lighting::Material>& material) {
         material_ptr_ = material;
+        material_index_ = lighting::MaterialTable::NO_INDEX;
     }
 
     inline const bool HasParent() const { return parent_ != nullptr; }
@@ -40,7 +56,41 @@ class Shape {
     inline const Shape* GetParent() const { return parent_; }
 
     // should NOT be invoked directly, as this depends on the Group adding this Shape as a child
-    inline void SetParent(Shape* parent) { parent_ = parent; }
+    inline void SetParent(Shape* parent) {
+        parent_ = parent;
+        InvalidateTransforms();
+    }
+
+    // precompute the inverse of this Shape's transform composed with those of all its parents,
+    // for this Shape and (for a Group or Instance) every Shape beneath it. Shapes whose cached
+    // transforms are still valid are skipped. Without a cache, transforms are composed on every
+    // call to `Intersect`, `WorldToObject` and `NormalToWorld`. Not thread-safe; see
+    // World::Finalize
+    virtual void CacheTransforms() const;
+
+    inline bool HasCachedTransforms() const { return transform_cache_ != nullptr; }
+
+    // adds the Material of this Shape and (for a Group or Instance) of every Shape beneath it to
+    // `table`, recording each one's index. Not thread-safe; see World::Finalize
+    virtual void IndexMaterials(lighting::MaterialTable& table) const;
+
+    // fills in the kind and object-space geometry of a Primitive equivalent to this Shape (the
+    // transform is filled in by PrimitiveList). false for Shapes that can only be intersected
+    // through `LocalIntersect`
+    virtual bool ToPrimitive(Primitive&) const { return false; }
+
+    // identifies the surface an Intersection with this Shape (or with the copy of it the
+    // Intersection holds) entered or left, for tracking which objects contain a refracted Ray
+    // (see pg. 151). this Shape's id, except for an Instance, where it's the Shape hit within the
+    // prototype
+    virtual uint64_t SurfaceId() const { return id_; }
+
+    // whether `other` (or the copy of it held by an Intersection) is this Shape or, for a Group
+    // or CSG, one beneath it (see pg. 234)
+    virtual bool Includes(const Shape& other) const { return other.id() == id_; }
+
+    // discards the cached transforms of this Shape and, for a Group, of its descendants
+    virtual void InvalidateTransforms() { transform_cache_.reset(); }
 
     // when intersecting the shape with a Ray, all shapes need to first convert the Ray into
     // object space, transforming it by the inverse of the shape's transformation Matrix
@@ -50,17 +100,27 @@ class Shape {
     // fn, transforms and returns the resulting normal
     commontypes::Vector NormalAt(const commontypes::Point& world_point) const;
 
+    // as above, for Shapes whose normal depends on the Intersection itself (see pg. 222)
+    commontypes::Vector NormalAt(const commontypes::Point& world_point,
+                                 const Intersection& hit) const;
+
     // convert a Point from World space to Object space
     commontypes::Point WorldToObject(const commontypes::Point& point) const;
 
+    // the inverse of this Shape's transform composed with those of all its parents
+    commontypes::Matrix WorldToObjectMatrix() const;
+
     // convert Normal in Object space to World space
     commontypes::Vector NormalToWorld(const commontypes::Vector& normal) const;
 
    protected:
-    commontypes::Matrix transform_;  // each Shape has a transformation matrix (see page 118); here
-                                     // it's the IdentityMatrix
+    // each Shape has a transformation matrix (see page 118); by default the IdentityMatrix. it's
+    // never modified in place, so the copies of this Shape held by Intersections share it rather
+    // than copying its rows
+    std::shared_ptr<const commontypes::Matrix> transform_;
     std::shared_ptr<lighting::Material>
         material_ptr_;  // each Shape has a Material (the default one (see pg. 118 & 83)
+    mutable uint32_t material_index_{lighting::MaterialTable::NO_INDEX};
 
     // each shape provides its own appropriate implementation for both local intersection and
     // local normal calculation
@@ -68,10 +128,37 @@ class Shape {
 
     virtual commontypes::Vector LocalNormalAt(const commontypes::Point& local_point) const = 0;
 
+    // only overridden by Shapes that need the `hit`, such as SmoothTriangle
+    virtual commontypes::Vector LocalNormalAt(const commontypes::Point& local_point,
+                                              const Intersection&) const {
+        return LocalNormalAt(local_point);
+    }
+
+    // shared by every Shape constructed without a transform
+    static const std::shared_ptr<const commontypes::Matrix>& IdentityTransform();
+
    private:
-    static uint64_t SHAPE_ID;  // each shape must have a unique identifier
-    uint64_t id_;              // this shape's identifier
-    Shape* parent_;            // refers to the Group that contains this Shape (optional)
+    struct TransformCache {
+        commontypes::Matrix inverse_;          // of `transform_` alone
+        commontypes::Matrix world_to_object_;  // inverse of the transform composed with parents'
+        commontypes::Matrix normal_to_world_;  // transpose of `world_to_object_`
+    };
+
+    // computes this Shape's cache, along with any missing caches of its parents
+    void CacheOwnTransforms() const;
+
+    // shared with the copies of this Shape held by Intersections
+    mutable std::shared_ptr<const TransformCache> transform_cache_;
+
+    // each shape must have a unique identifier. ids are handed out to each thread in blocks of
+    // ID_BLOCK_SIZE, so Shapes may be constructed on any number of threads at once without
+    // contending on the shared counter
+    static uint64_t NextId();
+    static constexpr uint64_t ID_BLOCK_SIZE = 1024;
+    static std::atomic<uint64_t> NEXT_ID_BLOCK;  // first id of the next unclaimed block
+
+    uint64_t id_;    // this shape's identifier
+    Shape* parent_;  // refers to the Group that contains this Shape (optional)
 };
 }  // namespace geometry
 
@@ -0,0 +1,36 @@
+#ifndef SMOOTH_TRIANGLE_H
+#define SMOOTH_TRIANGLE_H
+
+#include "triangle.h"
+
+namespace geometry {
+// a Triangle with a normal at each corner; the normal at a hit is interpolated from these using
+// the hit's barycentric coordinates, so a coarse mesh can look smoothly curved (see pg. 221)
+class SmoothTriangle : public Triangle {
+   public:
+    explicit SmoothTriangle(const commontypes::Point& p1,
+                            const commontypes::Point& p2,
+                            const commontypes::Point& p3,
+                            const commontypes::Vector& n1,
+                            const commontypes::Vector& n2,
+                            const commontypes::Vector& n3)
+        : Triangle(p1, p2, p3), n1_(n1), n2_(n2), n3_(n3) {}
+
+    inline const commontypes::Vector& N1() const { return n1_; }
+    inline const commontypes::Vector& N2() const { return n2_; }
+    inline const commontypes::Vector& N3() const { return n3_; }
+
+    std::vector<Intersection> LocalIntersect(const commontypes::Ray& ray) const override;
+
+    // without a hit there's nothing to interpolate with; this is the flat Triangle's normal
+    commontypes::Vector LocalNormalAt(const commontypes::Point& local_point) const override;
+
+    commontypes::Vector LocalNormalAt(const commontypes::Point& local_point,
+                                      const Intersection& hit) const override;
+
+   private:
+    commontypes::Vector n1_, n2_, n3_;  // the normal at p1, p2 and p3
+};
+}  // namespace geometry
+
+#endif  // SMOOTH_TRIANGLE_H
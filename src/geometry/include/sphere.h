@@ -25,9 +25,11 @@ class Sphere : public Shape {
 
     commontypes::Vector LocalNormalAt(const commontypes::Point& local_point) const override;
 
+    bool ToPrimitive(Primitive& primitive) const override;
+
     inline static Sphere GlassSphere() {
         Sphere glass_sphere{};
-        glass_sphere.transform_ = commontypes::IdentityMatrix{};
+        glass_sphere.transform_ = IdentityTransform();
         glass_sphere.material_ptr_->SetTransparency(1.0);
         glass_sphere.material_ptr_->SetRefractiveIndex(1.5);
         return glass_sphere;
@@ -38,6 +38,12 @@ class Triangle : public Shape {
 
     commontypes::Vector LocalNormalAt(const commontypes::Point& local_point) const override;
 
+    bool ToPrimitive(Primitive& primitive) const override;
+
+   protected:
+    // Moller-Trumbore; on a hit, sets `t` along with the barycentric `u` and `v` of the hit
+    bool IntersectBarycentric(const commontypes::Ray& ray, double& t, double& u, double& v) const;
+
    private:
     commontypes::Point p1_, p2_, p3_;  // each location of each corner in object space
     commontypes::Vector e1_, e2_;      // two edge Vectors
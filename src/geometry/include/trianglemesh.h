@@ -0,0 +1,131 @@
+#ifndef TRIANGLE_MESH_H
+#define TRIANGLE_MESH_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "arena.h"
+#include "point.h"
+#include "ray.h"
+#include "shape.h"
+#include "vector.h"
+
+namespace geometry {
+// Vertex positions (one array per axis, in single precision) and an index buffer of three vertex
+// indices per triangle, along with a bounding volume hierarchy over the triangles. Immutable once
+// constructed, so any number of TriangleMeshes can share one. Triangles may also index a
+// second array of vertex normals, in which case they're shaded as SmoothTriangles.
+class MeshData {
+   public:
+    struct TriangleHit {
+        double t_;
+        double u_, v_;  // as for Intersection
+        uint32_t triangle_idx_;
+    };
+
+    // in `normal_indices`, for a triangle without vertex normals
+    static const uint32_t NO_NORMAL = UINT32_MAX;
+
+    // the triangles are reordered while building the hierarchy; triangle indices used anywhere
+    // else refer to that order
+    MeshData(std::vector<float> xs,
+             std::vector<float> ys,
+             std::vector<float> zs,
+             std::vector<uint32_t> indices);
+
+    // `normal_indices` has three entries per triangle, either all NO_NORMAL or all valid
+    MeshData(std::vector<float> xs,
+             std::vector<float> ys,
+             std::vector<float> zs,
+             std::vector<uint32_t> indices,
+             std::vector<float> normal_xs,
+             std::vector<float> normal_ys,
+             std::vector<float> normal_zs,
+             std::vector<uint32_t> normal_indices);
+
+    inline size_t n_vertices() const { return xs_.size(); }
+    inline size_t n_triangles() const { return indices_.size() / 3; }
+    inline size_t n_bvh_nodes() const { return nodes_.size(); }
+
+    inline commontypes::Point Vertex(const size_t vertex_idx) const {
+        return commontypes::Point{xs_[vertex_idx], ys_[vertex_idx], zs_[vertex_idx]};
+    }
+
+    // `corner` is 0, 1 or 2
+    inline commontypes::Point TriangleVertex(const size_t triangle_idx,
+                                             const size_t corner) const {
+        return Vertex(indices_[triangle_idx * 3 + corner]);
+    }
+
+    // as for a Triangle, (p3 - p1) x (p2 - p1), normalized
+    commontypes::Vector TriangleNormal(size_t triangle_idx) const;
+
+    inline bool HasVertexNormals(const size_t triangle_idx) const {
+        return !normal_indices_.empty() && normal_indices_[triangle_idx * 3] != NO_NORMAL;
+    }
+
+    // the vertex normals interpolated as for a SmoothTriangle; the flat normal for a triangle
+    // without vertex normals
+    commontypes::Vector InterpolatedNormal(size_t triangle_idx, double u, double v) const;
+
+    // appends the intersections of the line through `ray` with every triangle (including those
+    // behind the ray's origin, as for other Shapes), in no particular order
+    void Intersect(const commontypes::Ray& ray,
+                   commontypes::ArenaVector<TriangleHit>& hits) const;
+
+    // bytes held by the vertex, index and hierarchy buffers
+    size_t MemoryBytes() const;
+
+   private:
+    // nodes are stored depth first, so an interior node's left child immediately follows it
+    struct BvhNode {
+        float min_[3];
+        float max_[3];
+        uint32_t offset_;  // first triangle for a leaf; the right child for an interior node
+        uint32_t count_;   // number of triangles for a leaf; 0 for an interior node
+    };
+
+    static const uint32_t MAX_LEAF_TRIANGLES = 4;
+
+    uint32_t BuildNode(std::vector<uint32_t>& order,
+                       const std::vector<float>& centroids,
+                       uint32_t first,
+                       uint32_t count);
+
+    bool IntersectTriangle(const commontypes::Ray& ray,
+                           uint32_t triangle_idx,
+                           TriangleHit& hit) const;
+
+    std::vector<float> xs_, ys_, zs_;
+    std::vector<uint32_t> indices_;
+    std::vector<float> normal_xs_, normal_ys_, normal_zs_;  // empty without vertex normals
+    std::vector<uint32_t> normal_indices_;                  // parallel to `indices_`
+    std::vector<BvhNode> nodes_;
+};
+
+// Any number of triangles sharing one transform and Material. The triangles are not Shapes of
+// their own; an Intersection with the mesh refers to the mesh itself and records which triangle
+// was hit (see Intersection::triangle_idx_) for calculating the normal.
+class TriangleMesh : public Shape {
+   public:
+    explicit TriangleMesh(std::shared_ptr<const MeshData> mesh)
+        : Shape(), mesh_(std::move(mesh)) {}
+
+    inline const std::shared_ptr<const MeshData>& mesh() const { return mesh_; }
+
+    // the Intersections refer to (without owning) this mesh, which must outlive them; unlike
+    // other Shapes, no copy is made per hit
+    std::vector<Intersection> LocalIntersect(const commontypes::Ray& ray) const override;
+
+    // a normal needs the triangle that was hit, so this throws std::logic_error
+    commontypes::Vector LocalNormalAt(const commontypes::Point& local_point) const override;
+
+    commontypes::Vector LocalNormalAt(const commontypes::Point& local_point,
+                                      const Intersection& hit) const override;
+
+   private:
+    std::shared_ptr<const MeshData> mesh_;
+};
+}  // namespace geometry
+
+#endif  // TRIANGLE_MESH_H
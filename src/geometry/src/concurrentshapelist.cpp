@@ -0,0 +1,30 @@
+#include "concurrentshapelist.h"
+#include <algorithm>
+
+geometry::ConcurrentShapeList::~ConcurrentShapeList() {
+    TakeAll();
+}
+
+void geometry::ConcurrentShapeList::Push(std::shared_ptr<Shape> shape) {
+    Node* node = new Node{std::move(shape), head_.load(std::memory_order_relaxed)};
+    while (!head_.compare_exchange_weak(node->next_, node, std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+    }
+}
+
+std::vector<std::shared_ptr<geometry::Shape>> geometry::ConcurrentShapeList::TakeAll() {
+    // nodes are only ever removed all at once, so there's no ABA problem
+    Node* node = head_.exchange(nullptr, std::memory_order_acquire);
+
+    std::vector<std::shared_ptr<Shape>> shapes{};
+    while (node != nullptr) {
+        shapes.push_back(std::move(node->shape_));
+        Node* next = node->next_;
+        delete node;
+        node = next;
+    }
+
+    // newest first, as pushed onto the stack
+    std::reverse(shapes.begin(), shapes.end());
+    return shapes;
+}
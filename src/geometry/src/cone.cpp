@@ -1,18 +1,23 @@
 #include "cone.h"
+#include "instrumentation.h"
+#include "primitive.h"
+
 std::vector<geometry::Intersection> geometry::Cone::LocalIntersect(
     const commontypes::Ray& ray) const {
+    INSTRUMENT_COUNT_INTERSECTION_TEST(kCone);
+
     // TODO: refactor this logic out as it's duplicated
 
     // see pg. 189
-    const double a =
-        pow(ray.direction().x(), 2) - pow(ray.direction().y(), 2) + pow(ray.direction().z(), 2);
+    const commontypes::Vector direction = ray.direction();
+    const commontypes::Point origin = ray.origin();
+    const double a = direction.x() * direction.x() - direction.y() * direction.y() +
+                     direction.z() * direction.z();
 
-    const double b = 2 * ray.origin().x() * ray.direction().x() -
-                     2 * ray.origin().y() * ray.direction().y() +
-                     2 * ray.origin().z() * ray.direction().z();
+    const double b = 2 * origin.x() * direction.x() - 2 * origin.y() * direction.y() +
+                     2 * origin.z() * direction.z();
 
-    const double c =
-        pow(ray.origin().x(), 2) - pow(ray.origin().y(), 2) + pow(ray.origin().z(), 2);
+    const double c = origin.x() * origin.x() - origin.y() * origin.y() + origin.z() * origin.z();
 
     // Ray parallel to one of the Cone's halves.
     // Ray may intersect the other half of the Cone (Ray only misses when a & b both == 0)
@@ -26,14 +31,14 @@ std::vector<geometry::Intersection> geometry::Cone::LocalIntersect(
         // we have a single point of intersection, where t is the following
         const double t = -c / (2 * b);
         std::vector<geometry::Intersection> xs{
-            geometry::Intersection{t, std::make_shared<Cone>(*this)}};
+            geometry::Intersection{t, commontypes::MakeArenaShared<Cone>(*this)}};
 
         this->IntersectCaps(ray, xs);
         return xs;
     }
 
     // otherwise, a != 0, so the approach is as it was for the Cylinder intersections.
-    const double discriminant = pow(b, 2) - 4 * a * c;
+    const double discriminant = b * b - 4 * a * c;
     if (discriminant < 0) {
         return {};
     }
@@ -44,7 +49,7 @@ std::vector<geometry::Intersection> geometry::Cone::LocalIntersect(
         std::swap(t0, t1);
     }
 
-    const auto this_ptr = std::make_shared<Cone>(*this);
+    const auto this_ptr = commontypes::MakeArenaShared<Cone>(*this);
     std::vector<geometry::Intersection> xs{};
 
     const auto y0 = ray.origin().y() + t0 * ray.direction().y();
@@ -64,7 +69,7 @@ std::vector<geometry::Intersection> geometry::Cone::LocalIntersect(
 commontypes::Vector geometry::Cone::LocalNormalAt(const commontypes::Point& local_point) const {
     // see pg. 190
     // y  = sqrt(point,x^2 + point.z^2)
-    double y = sqrt(pow(local_point.x(), 2) + pow(local_point.z(), 2));
+    double y = sqrt(local_point.x() * local_point.x() + local_point.z() * local_point.z());
     if (local_point.y() > 0) {
         y = -y;
     }
@@ -96,7 +101,7 @@ bool geometry::Cone::CheckCap(const commontypes::Ray& ray,
     const double x = ray.origin().x() + t * ray.direction().x();
     const double z = ray.origin().z() + t * ray.direction().z();
 
-    return (pow(x, 2) + pow(z, 2)) <= radius + utility::EPSILON_;
+    return (x * x + z * z) <= radius + utility::EPSILON_;
 }
 
 void geometry::Cone::IntersectCaps(const commontypes::Ray& ray,
@@ -109,11 +114,17 @@ void geometry::Cone::IntersectCaps(const commontypes::Ray& ray,
     // this differs from Cylinders, as Cylinders have the same radius everywhere
     const double t_min = (this->minimum_ - ray.origin().y()) / ray.direction().y();
     if (geometry::Cone::CheckCap(ray, t_min, kUseMinimum)) {
-        xs.emplace_back(t_min, std::make_shared<geometry::Cone>(*this));
+        xs.emplace_back(t_min, commontypes::MakeArenaShared<geometry::Cone>(*this));
     }
 
     const double t_max = (this->maximum_ - ray.origin().y()) / ray.direction().y();
     if (geometry::Cone::CheckCap(ray, t_max, kUseMaximum)) {
-        xs.emplace_back(t_max, std::make_shared<geometry::Cone>(*this));
+        xs.emplace_back(t_max, commontypes::MakeArenaShared<geometry::Cone>(*this));
     }
 }
+
+bool geometry::Cone::ToPrimitive(Primitive& primitive) const {
+    primitive.kind_ = PrimitiveKind::kCone;
+    primitive.cylinder_ = Primitive::CylinderData{minimum_, maximum_, capped_};
+    return true;
+}
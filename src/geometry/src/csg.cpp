@@ -0,0 +1,139 @@
+#include "csg.h"
+#include <stdexcept>
+#include <utility>
+#include "instrumentation.h"
+
+namespace {
+// walks a CSG's intersections in ascending order, tracking whether each lies inside either child
+class IntersectionFilter {
+   public:
+    IntersectionFilter(const geometry::CSG::Operation operation,
+                       std::vector<geometry::Intersection>& result)
+        : operation_(operation), result_(result) {}
+
+    void Add(const geometry::Intersection& intersection, const bool left_hit) {
+        if (geometry::CSG::IntersectionAllowed(operation_, left_hit, in_left_, in_right_)) {
+            result_.push_back(intersection);
+        }
+
+        // each intersection with a child enters or leaves it
+        if (left_hit) {
+            in_left_ = !in_left_;
+        } else {
+            in_right_ = !in_right_;
+        }
+    }
+
+   private:
+    geometry::CSG::Operation operation_;
+    std::vector<geometry::Intersection>& result_;
+    bool in_left_{false};
+    bool in_right_{false};
+};
+
+// most Shapes already return their intersections in ascending order; those that don't (such as
+// a capped Cylinder) are put in order here
+std::vector<geometry::Intersection> AscendingIntersections(const geometry::Shape& shape,
+                                                           const commontypes::Ray& ray) {
+    auto xs = shape.Intersect(ray);
+    geometry::MergeIntersections(xs, 0);
+    return xs;
+}
+}  // namespace
+
+geometry::CSG::CSG(const Operation operation,
+                   std::shared_ptr<Shape> left,
+                   std::shared_ptr<Shape> right)
+    : Shape(), operation_(operation), left_(std::move(left)), right_(std::move(right)) {
+    if (!left_ || !right_) {
+        throw std::invalid_argument("a CSG needs two shapes");
+    }
+    if (left_->HasParent() || right_->HasParent()) {
+        throw std::invalid_argument("a CSG's shapes must not already have a parent");
+    }
+    left_->SetParent(this);
+    right_->SetParent(this);
+}
+
+bool geometry::CSG::IntersectionAllowed(const Operation operation,
+                                        const bool left_hit,
+                                        const bool in_left,
+                                        const bool in_right) {
+    switch (operation) {
+        case Operation::kUnion:
+            // the hits on either Shape that aren't inside the other
+            return (left_hit && !in_right) || (!left_hit && !in_left);
+        case Operation::kIntersection:
+            // the hits on either Shape that are inside the other
+            return (left_hit && in_right) || (!left_hit && in_left);
+        case Operation::kDifference:
+            // the hits on the left Shape outside the right, and on the right inside the left
+            return (left_hit && !in_right) || (!left_hit && in_left);
+    }
+    return false;
+}
+
+std::vector<geometry::Intersection> geometry::CSG::FilterIntersections(
+    const std::vector<Intersection>& xs) const {
+    std::vector<Intersection> result{};
+    IntersectionFilter filter{operation_, result};
+    for (const auto& intersection : xs) {
+        filter.Add(intersection, left_->Includes(*intersection.object_));
+    }
+    return result;
+}
+
+std::vector<geometry::Intersection> geometry::CSG::LocalIntersect(
+    const commontypes::Ray& ray) const {
+    INSTRUMENT_COUNT_INTERSECTION_TEST(kCSG);
+
+    const auto left_xs = AscendingIntersections(*left_, ray);
+    if (left_xs.empty() && operation_ != Operation::kUnion) {
+        // nothing in the left Shape to intersect with, or to take the right Shape from
+        return {};
+    }
+    const auto right_xs = AscendingIntersections(*right_, ray);
+
+    // the side of each intersection is known from the list it came from, so (unlike
+    // `FilterIntersections`) no Includes test is needed
+    std::vector<Intersection> result{};
+    result.reserve(left_xs.size() + right_xs.size());
+    IntersectionFilter filter{operation_, result};
+    auto left_it = left_xs.begin();
+    auto right_it = right_xs.begin();
+    while (left_it != left_xs.end() || right_it != right_xs.end()) {
+        if (right_it == right_xs.end() ||
+            (left_it != left_xs.end() && left_it->t_ <= right_it->t_)) {
+            filter.Add(*left_it++, true);
+        } else {
+            filter.Add(*right_it++, false);
+        }
+    }
+    return result;
+}
+
+commontypes::Vector geometry::CSG::LocalNormalAt(const commontypes::Point&) const {
+    throw std::logic_error("`LocalNormalAt` should not be called on a CSG");
+}
+
+void geometry::CSG::CacheTransforms() const {
+    Shape::CacheTransforms();
+    left_->CacheTransforms();
+    right_->CacheTransforms();
+}
+
+void geometry::CSG::InvalidateTransforms() {
+    Shape::InvalidateTransforms();
+    left_->InvalidateTransforms();
+    right_->InvalidateTransforms();
+}
+
+void geometry::CSG::IndexMaterials(lighting::MaterialTable& table) const {
+    Shape::IndexMaterials(table);
+    left_->IndexMaterials(table);
+    right_->IndexMaterials(table);
+}
+
+bool geometry::CSG::Includes(const Shape& other) const {
+    return left_->Includes(other) || right_->Includes(other);
+}
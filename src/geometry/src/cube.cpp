@@ -1,10 +1,14 @@
 #include "cube.h"
 #include <algorithm>
 #include <memory>
+#include "instrumentation.h"
+#include "primitive.h"
 #include "utility.h"
 
 std::vector<geometry::Intersection> geometry::Cube::LocalIntersect(
     const commontypes::Ray& ray) const {
+    INSTRUMENT_COUNT_INTERSECTION_TEST(kCube);
+
     // min and max for each axis of the Cube
     const auto [xtmin, xtmax] = this->CheckAxis(ray.origin().x(), ray.direction().x());
     const auto [ytmin, ytmax] = this->CheckAxis(ray.origin().y(), ray.direction().y());
@@ -20,12 +24,10 @@ std::vector<geometry::Intersection> geometry::Cube::LocalIntersect(
     if (tmin > tmax)
         return {};
 
-    return std::vector<geometry::Intersection>{
-        geometry::Intersection{
-            tmin,
-            std::make_shared<geometry::Cube>(*this),
-        },
-        geometry::Intersection{tmax, std::make_shared<geometry::Cube>(*this)}};
+    // both Intersections share the one copy of this Cube
+    const auto this_ptr = commontypes::MakeArenaShared<geometry::Cube>(*this);
+    return std::vector<geometry::Intersection>{geometry::Intersection{tmin, this_ptr},
+                                               geometry::Intersection{tmax, this_ptr}};
 }
 
 // find the actual points of intersection (see pg. 171)
@@ -73,3 +75,8 @@ commontypes::Vector geometry::Cube::LocalNormalAt(const commontypes::Point& loca
 
     return commontypes::Vector{0, 0, local_point.z()};
 }
+
+bool geometry::Cube::ToPrimitive(Primitive& primitive) const {
+    primitive.kind_ = PrimitiveKind::kCube;
+    return true;
+}
@@ -1,20 +1,25 @@
 #include "cylinder.h"
+#include "instrumentation.h"
+#include "primitive.h"
 
 std::vector<geometry::Intersection> geometry::Cylinder::LocalIntersect(
     const commontypes::Ray& ray) const {
+    INSTRUMENT_COUNT_INTERSECTION_TEST(kCylinder);
+
     // compute the discriminant
-    const double a = pow(ray.direction().x(), 2) + pow(ray.direction().z(), 2);
+    const commontypes::Vector direction = ray.direction();
+    const commontypes::Point origin = ray.origin();
+    const double a = direction.x() * direction.x() + direction.z() * direction.z();
 
     std::vector<geometry::Intersection> xs{};
 
     // ray parallel to Y axis; skip the Cylinder intersection logic in this case
     if (!utility::NearEquals(a, 0.0)) {
-        const double b = 2 * ray.origin().x() * ray.direction().x() +
-                         2 * ray.origin().z() * ray.direction().z();
+        const double b = 2 * origin.x() * direction.x() + 2 * origin.z() * direction.z();
 
-        const double c = pow(ray.origin().x(), 2) + pow(ray.origin().z(), 2) - 1;
+        const double c = origin.x() * origin.x() + origin.z() * origin.z() - 1;
 
-        const double discriminant = pow(b, 2) - 4 * a * c;
+        const double discriminant = b * b - 4 * a * c;
 
         if (discriminant < 0) {
             return {};
@@ -28,7 +33,7 @@ std::vector<geometry::Intersection> geometry::Cylinder::LocalIntersect(
             std::swap(t0, t1);
         }
 
-        const auto this_ptr = std::make_shared<Cylinder>(*this);
+        const auto this_ptr = commontypes::MakeArenaShared<Cylinder>(*this);
 
         // compute the y-coordinate at each point of intersection; valid if between min-max
         // add to intersections if between these bounds
@@ -50,7 +55,7 @@ std::vector<geometry::Intersection> geometry::Cylinder::LocalIntersect(
 commontypes::Vector geometry::Cylinder::LocalNormalAt(
     const commontypes::Point& local_point) const {
     // the square of the distance from the y-axis
-    const double dist = pow(local_point.x(), 2) + pow(local_point.z(), 2);
+    const double dist = local_point.x() * local_point.x() + local_point.z() * local_point.z();
 
     // end caps are Planes, so the normal is the same at every point
     if (dist < 1) {
@@ -73,7 +78,7 @@ commontypes::Vector geometry::Cylinder::LocalNormalAt(
 bool geometry::Cylinder::CheckCap(const commontypes::Ray& ray, const double t) {
     const double x = ray.origin().x() + t * ray.direction().x();
     const double z = ray.origin().z() + t * ray.direction().z();
-    return (pow(x, 2) + pow(z, 2)) <= 1;
+    return (x * x + z * z) <= 1;
 }
 
 // pg. 186
@@ -87,12 +92,18 @@ void geometry::Cylinder::IntersectCaps(const commontypes::Ray& ray,
     // at y = cylinder.min
     const double t_min = (this->minimum_ - ray.origin().y()) / ray.direction().y();
     if (geometry::Cylinder::CheckCap(ray, t_min)) {
-        xs.emplace_back(t_min, std::make_shared<geometry::Cylinder>(*this));
+        xs.emplace_back(t_min, commontypes::MakeArenaShared<geometry::Cylinder>(*this));
     }
 
     // as above, but for upper end cap by intersecting the Ray w/ Plane at y = cylinder.maximum
     const double t_max = (this->maximum_ - ray.origin().y()) / ray.direction().y();
     if (geometry::Cylinder::CheckCap(ray, t_max)) {
-        xs.emplace_back(t_max, std::make_shared<geometry::Cylinder>(*this));
+        xs.emplace_back(t_max, commontypes::MakeArenaShared<geometry::Cylinder>(*this));
     }
 }
+
+bool geometry::Cylinder::ToPrimitive(Primitive& primitive) const {
+    primitive.kind_ = PrimitiveKind::kCylinder;
+    primitive.cylinder_ = Primitive::CylinderData{minimum_, maximum_, capped_};
+    return true;
+}
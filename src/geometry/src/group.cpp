@@ -1,10 +1,6 @@
 #include "group.h"
-
-// we want all Intersections ordered by ascending t values
-static bool AscendingGeometryIntersectionComparator(const geometry::Intersection& intersection1,
-                                                    const geometry::Intersection& intersection2) {
-    return intersection1.t_ < intersection2.t_;
-}
+#include <algorithm>
+#include "instrumentation.h"
 
 void geometry::Group::AddChildToGroup(std::shared_ptr<geometry::Shape>& shape_ptr) {
     shape_ptr->SetParent(this);
@@ -13,18 +9,19 @@ void geometry::Group::AddChildToGroup(std::shared_ptr<geometry::Shape>& shape_pt
 
 std::vector<geometry::Intersection> geometry::Group::LocalIntersect(
     const commontypes::Ray& ray) const {
+    INSTRUMENT_COUNT_INTERSECTION_TEST(kGroup);
+
     std::vector<geometry::Intersection> intersections{};
 
-    // add the intersections for each Shape
+    // add the intersections for each Shape, keeping all of them ordered by ascending t values
     for (const auto& child : children_) {
-        // TODO: perhaps insert these in sorted order?
         const auto child_intersections = child->Intersect(ray);
+        const size_t run_begin = intersections.size();
         intersections.insert(intersections.end(), child_intersections.begin(),
                              child_intersections.end());
+        geometry::MergeIntersections(intersections, run_begin);
     }
 
-    // sort the collection of all Shapes' Intersections
-    std::sort(intersections.begin(), intersections.end(), AscendingGeometryIntersectionComparator);
     return intersections;
 }
 
@@ -33,6 +30,50 @@ commontypes::Vector geometry::Group::LocalNormalAt(const commontypes::Point& loc
     throw IncorrectCallException();
 }
 
+void geometry::Group::AddChildConcurrently(std::shared_ptr<geometry::Shape> shape_ptr) {
+    pending_children_->Push(std::move(shape_ptr));
+}
+
+void geometry::Group::CommitPendingChildren() {
+    if (!pending_children_->empty()) {
+        for (auto& child : pending_children_->TakeAll()) {
+            AddChildToGroup(child);
+        }
+    }
+
+    for (const auto& child : children_) {
+        if (auto* group = dynamic_cast<geometry::Group*>(child.get())) {
+            group->CommitPendingChildren();
+        }
+    }
+}
+
+void geometry::Group::CacheTransforms() const {
+    Shape::CacheTransforms();
+    for (const auto& child : children_) {
+        child->CacheTransforms();
+    }
+}
+
+void geometry::Group::IndexMaterials(lighting::MaterialTable& table) const {
+    Shape::IndexMaterials(table);
+    for (const auto& child : children_) {
+        child->IndexMaterials(table);
+    }
+}
+
+bool geometry::Group::Includes(const Shape& other) const {
+    return std::any_of(children_.begin(), children_.end(),
+                       [&other](const auto& child) { return child->Includes(other); });
+}
+
+void geometry::Group::InvalidateTransforms() {
+    Shape::InvalidateTransforms();
+    for (const auto& child : children_) {
+        child->InvalidateTransforms();
+    }
+}
+
 void geometry::Group::AddChildrenToGroup(std::initializer_list<std::shared_ptr<Shape>>& children) {
     for (auto child_ptr : children) {
         this->AddChildToGroup(child_ptr);
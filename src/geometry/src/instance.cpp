@@ -0,0 +1,70 @@
+#include "instance.h"
+#include <stdexcept>
+#include "instrumentation.h"
+
+geometry::Instance::Instance(std::shared_ptr<const Shape> prototype)
+    : Shape(), prototype_(std::move(prototype)) {
+    if (!prototype_) {
+        throw std::invalid_argument("an Instance needs a prototype");
+    }
+    if (prototype_->HasParent()) {
+        throw std::invalid_argument("an Instance's prototype must not belong to a Group");
+    }
+}
+
+std::vector<geometry::Intersection> geometry::Instance::LocalIntersect(
+    const commontypes::Ray& ray) const {
+    INSTRUMENT_COUNT_INTERSECTION_TEST(kInstance);
+
+    // the prototype's "world" space is this Instance's object space
+    const auto prototype_hits = prototype_->Intersect(ray);
+
+    std::vector<geometry::Intersection> intersections{};
+    intersections.reserve(prototype_hits.size());
+    for (const auto& prototype_hit : prototype_hits) {
+        auto hit_instance = commontypes::MakeArenaShared<geometry::Instance>(*this);
+        hit_instance->prototype_hit_ = prototype_hit;
+        if (material_override_) {
+            hit_instance->material_ptr_ = material_override_;
+            hit_instance->material_index_ = override_index_;
+        } else {
+            hit_instance->material_ptr_ = prototype_hit.object_->Material();
+            hit_instance->material_index_ = prototype_hit.object_->material_index();
+        }
+        intersections.emplace_back(prototype_hit.t_, hit_instance, prototype_hit.u_,
+                                   prototype_hit.v_);
+    }
+
+    return intersections;
+}
+
+commontypes::Vector geometry::Instance::LocalNormalAt(const commontypes::Point&) const {
+    throw std::logic_error("`LocalNormalAt` needs the Intersection for an Instance");
+}
+
+commontypes::Vector geometry::Instance::LocalNormalAt(const commontypes::Point& local_point,
+                                                      const Intersection&) const {
+    return prototype_hit_.object_->NormalAt(local_point, prototype_hit_);
+}
+
+uint64_t geometry::Instance::SurfaceId() const {
+    if (!prototype_hit_.object_) {
+        return id();
+    }
+    // as boost::hash_combine, widened to 64 bits
+    const uint64_t prototype_id = prototype_hit_.object_->SurfaceId();
+    return id() ^ (prototype_id + 0x9e3779b97f4a7c15 + (id() << 6) + (id() >> 2));
+}
+
+void geometry::Instance::CacheTransforms() const {
+    Shape::CacheTransforms();
+    prototype_->CacheTransforms();
+}
+
+void geometry::Instance::IndexMaterials(lighting::MaterialTable& table) const {
+    Shape::IndexMaterials(table);
+    prototype_->IndexMaterials(table);
+    if (material_override_) {
+        override_index_ = table.Add(material_override_);
+    }
+}
@@ -1,30 +1,64 @@
 #include "intersection.h"
 #include <algorithm>
+#include "arena.h"
+#include "instrumentation.h"
 #include "sphere.h"
 
 // returns the hit from a vector of Intersections
 std::optional<geometry::Intersection> geometry::Intersection::Hit(
     const std::vector<geometry::Intersection>& xs) {
-    // recall that negative t values can be ignored and the intersections are returned in
-    // increasing order from the `Intersect` method (i.e sorting should not be necessary)
-    // however, the test suite has us using vectors of values constructed not in increasing order,
-    // so we'll create a sorted copy of the Intersections
-    std::vector<geometry::Intersection> xs_sorted{xs.size()};
-    std::partial_sort_copy(xs.begin(), xs.end(), xs_sorted.begin(), xs_sorted.end());
-
-    for (const auto& intersection : xs_sorted) {
-        // now return first non-negative from the sorted values
-        if (intersection.t_ >= 0)
-            return intersection;
+    // negative t values can be ignored. the intersections from `Intersect` are in increasing
+    // order, but the test suite constructs vectors that aren't, so rather than sorting (or
+    // relying on the order) take the lowest non-negative t in a single pass
+    const geometry::Intersection* hit = nullptr;
+    for (const auto& intersection : xs) {
+        if (intersection.t_ >= 0 && (hit == nullptr || intersection < *hit)) {
+            hit = &intersection;
+        }
+    }
+    if (hit == nullptr) {
+        return std::nullopt;
+    }
+    return *hit;
+}
+
+void geometry::MergeIntersections(std::vector<geometry::Intersection>& xs,
+                                  const size_t run_begin) {
+    // most Shapes have at most a few intersections with any one Ray
+    constexpr size_t MAX_INSERTED_RUN = 4;
+    const auto ascending = [](const Intersection& lhs, const Intersection& rhs) {
+        return lhs.t_ < rhs.t_;
+    };
+
+    const auto run = xs.begin() + static_cast<std::ptrdiff_t>(run_begin);
+    if (xs.size() - run_begin > MAX_INSERTED_RUN) {
+        if (!std::is_sorted(run, xs.end(), ascending)) {
+            std::sort(run, xs.end(), ascending);
+        }
+        std::inplace_merge(xs.begin(), run, xs.end(), ascending);
+        return;
+    }
+
+    for (size_t i = run_begin; i < xs.size(); ++i) {
+        if (i == 0 || !ascending(xs[i], xs[i - 1])) {
+            continue;
+        }
+        geometry::Intersection intersection = std::move(xs[i]);
+        size_t j = i;
+        for (; j > 0 && ascending(intersection, xs[j - 1]); --j) {
+            xs[j] = std::move(xs[j - 1]);
+        }
+        xs[j] = std::move(intersection);
     }
-    return std::nullopt;
 }
 
 geometry::Computations geometry::Intersection::PrepareComputations(
     commontypes::Ray& r,
     const std::vector<Intersection>& intersections) const {
+    INSTRUMENT_PHASE(kPrepareComputations);
+
     geometry::Computations computations{};
-    std::vector<std::shared_ptr<geometry::Shape>> containers{};
+    commontypes::ArenaVector<std::shared_ptr<geometry::Shape>> containers{};
 
     for (const auto& intersection : intersections) {
         const bool is_intersection_is_the_hit = intersection == *this;
@@ -40,11 +74,11 @@ geometry::Computations geometry::Intersection::PrepareComputations(
             }
         }
 
-        const uint64_t shape_id = intersection.object_->id();
+        const uint64_t surface_id = intersection.object_->SurfaceId();
         const auto it =
             std::find_if(containers.begin(), containers.end(),
-                         [shape_id](const std::shared_ptr<geometry::Shape>& shape_ptr) {
-                             return shape_ptr->id() == shape_id;
+                         [surface_id](const std::shared_ptr<geometry::Shape>& shape_ptr) {
+                             return shape_ptr->SurfaceId() == surface_id;
                          });
 
         if (it == containers.end()) {
@@ -72,7 +106,7 @@ geometry::Computations geometry::Intersection::PrepareComputations(
     computations.point_ = r.Position(computations.t_);
     computations.eye_vector_ = commontypes::Vector{-r.direction()};
 
-    computations.normal_vector_ = (*computations.object_).NormalAt(computations.point_);
+    computations.normal_vector_ = (*computations.object_).NormalAt(computations.point_, *this);
     if (computations.normal_vector_.Dot(computations.eye_vector_) < 0) {
         computations.inside_ = true;
         computations.normal_vector_ = commontypes::Vector{-computations.normal_vector_};
@@ -99,7 +133,7 @@ double geometry::Schlick(const geometry::Computations& comps) {
     // total internal reflection can only occur if n1 > n2
     if (comps.n1 > comps.n2) {
         const double n = comps.n1 / comps.n2;
-        const double sin2_t = pow(n, 2) * (1 - pow(cos, 2));
+        const double sin2_t = n * n * (1 - cos * cos);
 
         if (sin2_t > 1.0)
             return 1.0;
@@ -110,8 +144,11 @@ double geometry::Schlick(const geometry::Computations& comps) {
         cos = cos_t;
     }
 
-    const double r0 = pow(((comps.n1 - comps.n2) / (comps.n1 + comps.n2)), 2);
-    return r0 + (1 - r0) * pow((1 - cos), 5);
+    const double r = (comps.n1 - comps.n2) / (comps.n1 + comps.n2);
+    const double r0 = r * r;
+    const double x = 1 - cos;
+    const double x2 = x * x;
+    return r0 + (1 - r0) * x2 * x2 * x;
 }
 
 bool operator==(const geometry::Intersection& i1, const geometry::Intersection& i2) {
@@ -0,0 +1,299 @@
+#include "objparser.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <charconv>
+#include <cstring>
+#include "smoothtriangle.h"
+#include "triangle.h"
+
+namespace {
+// read-only view of a whole file, mapped into memory for the lifetime of this object
+class MappedFile {
+   public:
+    explicit MappedFile(const std::filesystem::path& path) {
+        fd_ = open(path.c_str(), O_RDONLY);
+        if (fd_ < 0) {
+            throw geometry::ObjParseError("unable to open " + path.string());
+        }
+
+        struct stat file_stat {};
+        if (fstat(fd_, &file_stat) != 0) {
+            close(fd_);
+            throw geometry::ObjParseError("unable to stat " + path.string());
+        }
+        size_ = static_cast<size_t>(file_stat.st_size);
+
+        // an empty mapping is an error, but an empty file isn't
+        if (size_ > 0) {
+            void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+            if (data == MAP_FAILED) {
+                close(fd_);
+                throw geometry::ObjParseError("unable to map " + path.string());
+            }
+            data_ = static_cast<const char*>(data);
+            madvise(data, size_, MADV_SEQUENTIAL);
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        if (data_ != nullptr) {
+            munmap(const_cast<char*>(data_), size_);
+        }
+        close(fd_);
+    }
+
+    std::string_view text() const { return {data_, size_}; }
+
+   private:
+    int fd_{-1};
+    const char* data_{nullptr};
+    size_t size_{0};
+};
+
+inline bool IsBlank(const char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// remove and return the first whitespace-delimited token of `rest`
+std::string_view NextToken(std::string_view& rest) {
+    size_t start = 0;
+    while (start < rest.size() && IsBlank(rest[start])) {
+        ++start;
+    }
+
+    size_t end = start;
+    while (end < rest.size() && !IsBlank(rest[end])) {
+        ++end;
+    }
+
+    const std::string_view token = rest.substr(start, end - start);
+    rest.remove_prefix(end);
+    return token;
+}
+
+bool ParseDouble(const std::string_view token, double& value) {
+    const auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+    return ec == std::errc{} && ptr == token.data() + token.size();
+}
+}  // namespace
+
+geometry::ObjParser::ObjParser(const Output output)
+    : material_(std::make_shared<lighting::Material>()),
+      default_group_(std::make_shared<geometry::Group>()),
+      current_group_(default_group_.get()),
+      has_vertex_normals_(false),
+      output_(output),
+      ignored_lines_(0),
+      n_triangles_(0),
+      line_(0) {}
+
+geometry::ObjParser geometry::ObjParser::ParseFile(const std::filesystem::path& path,
+                                                   const Output output) {
+    const MappedFile file{path};
+    ObjParser parser{output};
+
+    try {
+        parser.Parse(file.text());
+    } catch (const ObjParseError& e) {
+        throw ObjParseError(path.string() + ": " + e.what());
+    }
+
+    return parser;
+}
+
+geometry::ObjParser geometry::ObjParser::ParseString(const std::string_view text,
+                                                     const Output output) {
+    ObjParser parser{output};
+    parser.Parse(text);
+    return parser;
+}
+
+std::shared_ptr<geometry::Group> geometry::ObjParser::NamedGroup(
+    const std::string_view name) const {
+    for (const auto& [group_name, group] : named_groups_) {
+        if (group_name == name) {
+            return group;
+        }
+    }
+    return nullptr;
+}
+
+std::shared_ptr<geometry::Group> geometry::ObjParser::ToGroup() const {
+    auto group = std::make_shared<geometry::Group>();
+
+    std::shared_ptr<geometry::Shape> default_group = default_group_;
+    if (!default_group_->GetChildren().empty()) {
+        group->AddChildToGroup(default_group);
+    }
+
+    for (const auto& [name, named_group] : named_groups_) {
+        std::shared_ptr<geometry::Shape> child = named_group;
+        group->AddChildToGroup(child);
+    }
+
+    return group;
+}
+
+std::shared_ptr<geometry::TriangleMesh> geometry::ObjParser::ToMesh() const {
+    if (output_ != Output::kMesh) {
+        throw std::logic_error("`ToMesh` needs a file parsed with `Output::kMesh`");
+    }
+
+    std::vector<float> xs, ys, zs;
+    xs.reserve(vertices_.size());
+    ys.reserve(vertices_.size());
+    zs.reserve(vertices_.size());
+    for (const auto& vertex : vertices_) {
+        xs.push_back(static_cast<float>(vertex.x()));
+        ys.push_back(static_cast<float>(vertex.y()));
+        zs.push_back(static_cast<float>(vertex.z()));
+    }
+
+    std::vector<float> normal_xs, normal_ys, normal_zs;
+    std::vector<uint32_t> normal_indices;
+    if (has_vertex_normals_) {
+        for (const auto& normal : normals_) {
+            normal_xs.push_back(static_cast<float>(normal.x()));
+            normal_ys.push_back(static_cast<float>(normal.y()));
+            normal_zs.push_back(static_cast<float>(normal.z()));
+        }
+        normal_indices = triangle_normal_indices_;
+    }
+
+    auto mesh = std::make_shared<geometry::TriangleMesh>(std::make_shared<const MeshData>(
+        std::move(xs), std::move(ys), std::move(zs), triangle_indices_, std::move(normal_xs),
+        std::move(normal_ys), std::move(normal_zs), std::move(normal_indices)));
+    mesh->SetMaterial(material_);
+    return mesh;
+}
+
+void geometry::ObjParser::Parse(std::string_view text) {
+    while (!text.empty()) {
+        ++line_;
+        const auto* newline =
+            static_cast<const char*>(std::memchr(text.data(), '\n', text.size()));
+        const size_t line_length = newline == nullptr ? text.size() : newline - text.data();
+
+        ParseLine(text.substr(0, line_length));
+        text.remove_prefix(std::min(line_length + 1, text.size()));
+    }
+}
+
+void geometry::ObjParser::ParseLine(std::string_view line) {
+    const std::string_view keyword = NextToken(line);
+
+    if (keyword == "v" || keyword == "vn") {
+        double xyz[3];
+        for (double& value : xyz) {
+            if (!ParseDouble(NextToken(line), value)) {
+                Fail("expected three numbers after '" + std::string{keyword} + "'");
+            }
+        }
+
+        // a vertex may carry a fourth (w) value, which isn't used
+        if (keyword == "v") {
+            vertices_.emplace_back(xyz[0], xyz[1], xyz[2]);
+        } else {
+            normals_.emplace_back(xyz[0], xyz[1], xyz[2]);
+        }
+    } else if (keyword == "f") {
+        ParseFace(line);
+    } else if (keyword == "g") {
+        const std::string_view name = NextToken(line);
+        auto group = NamedGroup(name);
+        if (!group) {
+            group = std::make_shared<geometry::Group>();
+            named_groups_.emplace_back(name, group);
+        }
+        current_group_ = group.get();
+    } else if (!keyword.empty()) {
+        ++ignored_lines_;
+    }
+}
+
+void geometry::ObjParser::ParseFace(std::string_view rest) {
+    face_vertices_.clear();
+    face_normals_.clear();
+    bool every_vertex_has_normal = true;
+
+    // each vertex is given as "v", "v/vt", "v//vn" or "v/vt/vn"
+    for (std::string_view token = NextToken(rest); !token.empty(); token = NextToken(rest)) {
+        const size_t first_slash = token.find('/');
+        face_vertices_.push_back(ResolveIndex(token.substr(0, first_slash), vertices_.size()));
+
+        const size_t second_slash = first_slash == std::string_view::npos
+                                        ? std::string_view::npos
+                                        : token.find('/', first_slash + 1);
+        if (second_slash != std::string_view::npos && second_slash + 1 < token.size()) {
+            face_normals_.push_back(ResolveIndex(token.substr(second_slash + 1), normals_.size()));
+        } else {
+            every_vertex_has_normal = false;
+        }
+    }
+
+    if (face_vertices_.size() < 3) {
+        Fail("a face needs at least three vertices");
+    }
+
+    if (every_vertex_has_normal) {
+        has_vertex_normals_ = true;
+    } else {
+        face_normals_.clear();
+    }
+
+    // fan triangulation (see pg. 216)
+    for (size_t i = 1; i + 1 < face_vertices_.size(); ++i) {
+        ++n_triangles_;
+
+        // only the indices are kept for a mesh, and only a mesh keeps them
+        if (output_ == Output::kMesh) {
+            for (const size_t corner : {size_t{0}, i, i + 1}) {
+                triangle_indices_.push_back(static_cast<uint32_t>(face_vertices_[corner]));
+                triangle_normal_indices_.push_back(
+                    face_normals_.empty() ? MeshData::NO_NORMAL
+                                          : static_cast<uint32_t>(face_normals_[corner]));
+            }
+            continue;
+        }
+
+        const commontypes::Point& p1 = vertices_[face_vertices_[0]];
+        const commontypes::Point& p2 = vertices_[face_vertices_[i]];
+        const commontypes::Point& p3 = vertices_[face_vertices_[i + 1]];
+        std::shared_ptr<geometry::Shape> triangle;
+        if (face_normals_.empty()) {
+            triangle = std::make_shared<geometry::Triangle>(p1, p2, p3);
+        } else {
+            triangle = std::make_shared<geometry::SmoothTriangle>(
+                p1, p2, p3, normals_[face_normals_[0]], normals_[face_normals_[i]],
+                normals_[face_normals_[i + 1]]);
+        }
+        triangle->SetMaterial(material_);
+        current_group_->AddChildToGroup(triangle);
+    }
+}
+
+size_t geometry::ObjParser::ResolveIndex(const std::string_view token,
+                                         const size_t n_elements) const {
+    long idx = 0;
+    const auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), idx);
+    if (ec != std::errc{} || ptr != token.data() + token.size()) {
+        Fail("invalid index '" + std::string{token} + "'");
+    }
+
+    // negative indices count back from the most recently defined element
+    const long resolved = idx < 0 ? static_cast<long>(n_elements) + idx : idx - 1;
+    if (idx == 0 || resolved < 0 || resolved >= static_cast<long>(n_elements)) {
+        Fail("index " + std::string{token} + " is out of range");
+    }
+
+    return static_cast<size_t>(resolved);
+}
+
+void geometry::ObjParser::Fail(const std::string& message) const {
+    throw ObjParseError("line " + std::to_string(line_) + ": " + message);
+}
@@ -1,8 +1,12 @@
 #include "plane.h"
+#include "instrumentation.h"
+#include "primitive.h"
 #include "utility.h"
 
 std::vector<geometry::Intersection> geometry::Plane::LocalIntersect(
     const commontypes::Ray& ray) const {
+    INSTRUMENT_COUNT_INTERSECTION_TEST(kPlane);
+
     // plane is in xz, it has no slope in y at all.
     // if the ray's direction vector has no slope in y, it is parallel to the plane
     if (std::abs(ray.direction().y()) < utility::EPSILON_) {
@@ -11,7 +15,8 @@ std::vector<geometry::Intersection> geometry::Plane::LocalIntersect(
 
     // NOTE - this calculation is only appropriate for xz planes, as this example is
     const auto t = -ray.origin().y() / ray.direction().y();
-    const auto intersection = geometry::Intersection(t, std::make_shared<geometry::Plane>(*this));
+    const auto intersection =
+        geometry::Intersection(t, commontypes::MakeArenaShared<geometry::Plane>(*this));
     return {intersection};
 }
 
@@ -19,3 +24,8 @@ commontypes::Vector geometry::Plane::LocalNormalAt(const commontypes::Point& loc
     // with no curvature, the normal is constant everywhere
     return commontypes::Vector{0, 1, 0};
 }
+
+bool geometry::Plane::ToPrimitive(Primitive& primitive) const {
+    primitive.kind_ = PrimitiveKind::kPlane;
+    return true;
+}
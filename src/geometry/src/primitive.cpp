@@ -0,0 +1,379 @@
+#include "primitive.h"
+#include <algorithm>
+#include <cmath>
+#include "group.h"
+#include "instrumentation.h"
+#include "shape.h"
+#include "utility.h"
+
+// each kernel is the corresponding Shape's LocalIntersect, written against a ray already in
+// object space, given by `o` (origin) and `d` (direction). every hit is passed to `emit` as
+// (t, u, v); u and v are only meaningful for triangles
+namespace {
+template <typename Emit>
+inline void IntersectSphere(const double o[3], const double d[3], Emit&& emit) {
+    INSTRUMENT_COUNT_INTERSECTION_TEST(kSphere);
+
+    const double a = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+    const double b = 2 * (d[0] * o[0] + d[1] * o[1] + d[2] * o[2]);
+    const double c = o[0] * o[0] + o[1] * o[1] + o[2] * o[2] - 1;
+    const double discriminant = b * b - 4 * a * c;
+    if (discriminant < 0) {
+        return;
+    }
+
+    double t1 = (-b - std::sqrt(discriminant)) / (2 * a);
+    double t2 = (-b + std::sqrt(discriminant)) / (2 * a);
+    if (t1 > t2) {
+        std::swap(t1, t2);
+    }
+    emit(t1, 0, 0);
+    emit(t2, 0, 0);
+}
+
+template <typename Emit>
+inline void IntersectPlane(const double o[3], const double d[3], Emit&& emit) {
+    INSTRUMENT_COUNT_INTERSECTION_TEST(kPlane);
+
+    if (std::abs(d[1]) < utility::EPSILON_) {
+        return;
+    }
+    emit(-o[1] / d[1], 0, 0);
+}
+
+template <typename Emit>
+inline void IntersectCube(const double o[3], const double d[3], Emit&& emit) {
+    INSTRUMENT_COUNT_INTERSECTION_TEST(kCube);
+
+    double tmin = -INFINITY;
+    double tmax = INFINITY;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        const double tmin_numerator = -1 - o[axis];
+        const double tmax_numerator = 1 - o[axis];
+
+        double axis_tmin, axis_tmax;
+        if (std::fabs(d[axis]) >= utility::EPSILON_) {
+            axis_tmin = tmin_numerator / d[axis];
+            axis_tmax = tmax_numerator / d[axis];
+        } else {
+            axis_tmin = tmin_numerator * INFINITY;
+            axis_tmax = tmax_numerator * INFINITY;
+        }
+        if (axis_tmin > axis_tmax) {
+            std::swap(axis_tmin, axis_tmax);
+        }
+
+        tmin = std::fmax(tmin, axis_tmin);
+        tmax = std::fmin(tmax, axis_tmax);
+    }
+
+    if (tmin > tmax) {
+        return;
+    }
+    emit(tmin, 0, 0);
+    emit(tmax, 0, 0);
+}
+
+// the end caps of cylinders and cones; a cone's radius at a cap is |y| (pg. 190)
+template <typename Emit>
+inline void IntersectCaps(const geometry::Primitive& primitive,
+                          const double o[3],
+                          const double d[3],
+                          Emit&& emit) {
+    const auto& cylinder = primitive.cylinder_;
+    if (!cylinder.capped_ || utility::NearEquals(d[1], 0.0)) {
+        return;
+    }
+
+    const bool is_cone = primitive.kind_ == geometry::PrimitiveKind::kCone;
+    for (const double cap_y : {cylinder.minimum_, cylinder.maximum_}) {
+        const double t = (cap_y - o[1]) / d[1];
+        const double x = o[0] + t * d[0];
+        const double z = o[2] + t * d[2];
+        if (is_cone ? x * x + z * z <= std::fabs(cap_y) + utility::EPSILON_
+                    : x * x + z * z <= 1) {
+            emit(t, 0, 0);
+        }
+    }
+}
+
+template <typename Emit>
+inline void IntersectCylinderOrCone(const geometry::Primitive& primitive,
+                                    const double o[3],
+                                    const double d[3],
+                                    Emit&& emit) {
+    const auto& cylinder = primitive.cylinder_;
+
+    // a cone's walls are x^2 - y^2 + z^2 = 0, a cylinder's x^2 + z^2 = 1 (pg. 178, 189)
+    double a, b, c;
+    if (primitive.kind_ == geometry::PrimitiveKind::kCone) {
+        INSTRUMENT_COUNT_INTERSECTION_TEST(kCone);
+        a = d[0] * d[0] - d[1] * d[1] + d[2] * d[2];
+        b = 2 * o[0] * d[0] - 2 * o[1] * d[1] + 2 * o[2] * d[2];
+        c = o[0] * o[0] - o[1] * o[1] + o[2] * o[2];
+
+        if (utility::NearEquals(a, 0.0)) {
+            if (utility::NearEquals(b, 0.0)) {
+                return;
+            }
+            emit(-c / (2 * b), 0, 0);
+            IntersectCaps(primitive, o, d, emit);
+            return;
+        }
+    } else {
+        INSTRUMENT_COUNT_INTERSECTION_TEST(kCylinder);
+        a = d[0] * d[0] + d[2] * d[2];
+        b = 2 * o[0] * d[0] + 2 * o[2] * d[2];
+        c = o[0] * o[0] + o[2] * o[2] - 1;
+
+        // parallel to the y axis; only the caps can be hit
+        if (utility::NearEquals(a, 0.0)) {
+            IntersectCaps(primitive, o, d, emit);
+            return;
+        }
+    }
+
+    const double discriminant = b * b - 4 * a * c;
+    if (discriminant < 0) {
+        return;
+    }
+
+    double t0 = (-b - std::sqrt(discriminant)) / (2 * a);
+    double t1 = (-b + std::sqrt(discriminant)) / (2 * a);
+    if (t0 > t1) {
+        std::swap(t0, t1);
+    }
+
+    for (const double t : {t0, t1}) {
+        const double y = o[1] + t * d[1];
+        if (cylinder.minimum_ < y && y < cylinder.maximum_) {
+            emit(t, 0, 0);
+        }
+    }
+
+    IntersectCaps(primitive, o, d, emit);
+}
+
+template <typename Emit>
+inline void IntersectTriangle(const geometry::Primitive& primitive,
+                              const double o[3],
+                              const double d[3],
+                              Emit&& emit) {
+    INSTRUMENT_COUNT_INTERSECTION_TEST(kTriangle);
+
+    const auto& triangle = primitive.triangle_;
+    const double* e1 = triangle.e1_;
+    const double* e2 = triangle.e2_;
+
+    const double dir_cross_e2[3] = {d[1] * e2[2] - d[2] * e2[1], d[2] * e2[0] - d[0] * e2[2],
+                                    d[0] * e2[1] - d[1] * e2[0]};
+    const double determinant =
+        e1[0] * dir_cross_e2[0] + e1[1] * dir_cross_e2[1] + e1[2] * dir_cross_e2[2];
+    if (std::abs(determinant) < utility::EPSILON_) {
+        return;
+    }
+
+    const double f = 1.0 / determinant;
+    const double p1_to_origin[3] = {o[0] - triangle.p1_[0], o[1] - triangle.p1_[1],
+                                    o[2] - triangle.p1_[2]};
+    const double u = f * (p1_to_origin[0] * dir_cross_e2[0] + p1_to_origin[1] * dir_cross_e2[1] +
+                          p1_to_origin[2] * dir_cross_e2[2]);
+    if (u < 0 || u > 1) {
+        return;
+    }
+
+    const double origin_cross_e1[3] = {p1_to_origin[1] * e1[2] - p1_to_origin[2] * e1[1],
+                                       p1_to_origin[2] * e1[0] - p1_to_origin[0] * e1[2],
+                                       p1_to_origin[0] * e1[1] - p1_to_origin[1] * e1[0]};
+    const double v =
+        f * (d[0] * origin_cross_e1[0] + d[1] * origin_cross_e1[1] + d[2] * origin_cross_e1[2]);
+    if (v < 0 || (u + v) > 1) {
+        return;
+    }
+
+    const double t =
+        f * (e2[0] * origin_cross_e1[0] + e2[1] * origin_cross_e1[1] + e2[2] * origin_cross_e1[2]);
+    emit(t, u, v);
+}
+
+// transforms the ray into the Primitive's object space and runs its kernel
+template <typename Emit>
+inline void IntersectPrimitive(const geometry::Primitive& primitive,
+                               const double origin[4],
+                               const double direction[4],
+                               Emit&& emit) {
+    // as for Matrix * Tuple
+    double o[3], d[3];
+    for (size_t row = 0; row < 3; ++row) {
+        const double* m = primitive.world_to_object_[row];
+        o[row] = m[0] * origin[0] + m[1] * origin[1] + m[2] * origin[2] + m[3] * origin[3];
+        d[row] = m[0] * direction[0] + m[1] * direction[1] + m[2] * direction[2] +
+                 m[3] * direction[3];
+    }
+
+    switch (primitive.kind_) {
+        case geometry::PrimitiveKind::kSphere:
+            IntersectSphere(o, d, emit);
+            break;
+        case geometry::PrimitiveKind::kPlane:
+            IntersectPlane(o, d, emit);
+            break;
+        case geometry::PrimitiveKind::kCube:
+            IntersectCube(o, d, emit);
+            break;
+        case geometry::PrimitiveKind::kCylinder:
+        case geometry::PrimitiveKind::kCone:
+            IntersectCylinderOrCone(primitive, o, d, emit);
+            break;
+        case geometry::PrimitiveKind::kTriangle:
+            IntersectTriangle(primitive, o, d, emit);
+            break;
+    }
+}
+
+// the top three rows of the Shape's composed world-to-object transform
+void CopyWorldToObject(const geometry::Shape& shape, geometry::Primitive& primitive) {
+    const commontypes::Matrix world_to_object = shape.WorldToObjectMatrix();
+    for (size_t row = 0; row < 3; ++row) {
+        for (size_t column = 0; column < 4; ++column) {
+            primitive.world_to_object_[row][column] = world_to_object.GetElement(row, column);
+        }
+    }
+}
+}  // namespace
+
+void geometry::PrimitiveList::Add(const std::shared_ptr<Shape>& shape) {
+    if (const auto* group = dynamic_cast<const geometry::Group*>(shape.get())) {
+        for (const auto& child : group->GetChildren()) {
+            Add(child);
+        }
+        return;
+    }
+
+    geometry::Primitive primitive{};
+    if (!shape->ToPrimitive(primitive)) {
+        others_.push_back(shape);
+        return;
+    }
+
+    CopyWorldToObject(*shape, primitive);
+
+    primitives_.push_back(primitive);
+    shapes_.push_back(shape);
+}
+
+size_t geometry::PrimitiveList::Refit() {
+    size_t n_refit = 0;
+    for (size_t i = 0; i < primitives_.size(); ++i) {
+        const auto& shape = shapes_[i];
+        if (shape->HasCachedTransforms()) {
+            continue;
+        }
+
+        shape->CacheTransforms();
+        CopyWorldToObject(*shape, primitives_[i]);
+        ++n_refit;
+    }
+
+    // the others are intersected through their own (now re-cached) transforms
+    for (const auto& other : others_) {
+        other->CacheTransforms();
+    }
+    return n_refit;
+}
+
+void geometry::PrimitiveList::Clear() {
+    primitives_.clear();
+    shapes_.clear();
+    others_.clear();
+}
+
+void geometry::PrimitiveList::Intersect(const commontypes::Ray& ray,
+                                        std::vector<Intersection>& xs) const {
+    const double origin[4] = {ray.origin().x(), ray.origin().y(), ray.origin().z(), 1};
+    const double direction[4] = {ray.direction().x(), ray.direction().y(), ray.direction().z(),
+                                 0};
+
+    for (size_t i = 0; i < primitives_.size(); ++i) {
+        const auto& shape = shapes_[i];
+        const size_t run_begin = xs.size();
+        IntersectPrimitive(primitives_[i], origin, direction,
+                           [&xs, &shape](const double t, const double u, const double v) {
+                               xs.emplace_back(t, shape, u, v);
+                           });
+        MergeIntersections(xs, run_begin);
+    }
+
+    for (const auto& other : others_) {
+        const auto other_xs = other->Intersect(ray);
+        const size_t run_begin = xs.size();
+        xs.insert(xs.end(), other_xs.begin(), other_xs.end());
+        MergeIntersections(xs, run_begin);
+    }
+}
+
+void geometry::PrimitiveList::FindOccluded(const commontypes::Point& origin,
+                                           commontypes::ArenaVector<ShadowRay>& rays) const {
+    const double origin_4[4] = {origin.x(), origin.y(), origin.z(), 1};
+    size_t n_unoccluded = 0;
+    for (const auto& ray : rays) {
+        n_unoccluded += ray.occluded_ ? 0 : 1;
+    }
+
+    // every ray is tested against one Primitive before moving to the next, so each Primitive is
+    // loaded once for the whole batch
+    for (size_t i = 0; i < primitives_.size() && n_unoccluded > 0; ++i) {
+        for (auto& ray : rays) {
+            if (ray.occluded_) {
+                continue;
+            }
+
+            const double direction[4] = {ray.direction_.x(), ray.direction_.y(),
+                                         ray.direction_.z(), 0};
+            IntersectPrimitive(primitives_[i], origin_4, direction,
+                               [&ray](const double t, double, double) {
+                                   ray.occluded_ |= t >= 0 && t < ray.distance_;
+                               });
+            if (ray.occluded_) {
+                ray.occluder_ = static_cast<uint32_t>(i);
+                --n_unoccluded;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < others_.size() && n_unoccluded > 0; ++i) {
+        for (auto& ray : rays) {
+            if (ray.occluded_) {
+                continue;
+            }
+
+            if (Occludes(static_cast<uint32_t>(primitives_.size() + i), origin, ray)) {
+                ray.occluded_ = true;
+                ray.occluder_ = static_cast<uint32_t>(primitives_.size() + i);
+                --n_unoccluded;
+            }
+        }
+    }
+}
+
+bool geometry::PrimitiveList::Occludes(const uint32_t idx,
+                                       const commontypes::Point& origin,
+                                       const ShadowRay& ray) const {
+    bool occluded = false;
+    if (idx < primitives_.size()) {
+        const double origin_4[4] = {origin.x(), origin.y(), origin.z(), 1};
+        const double direction[4] = {ray.direction_.x(), ray.direction_.y(), ray.direction_.z(),
+                                     0};
+        IntersectPrimitive(primitives_[idx], origin_4, direction,
+                           [&ray, &occluded](const double t, double, double) {
+                               occluded |= t >= 0 && t < ray.distance_;
+                           });
+        return occluded;
+    }
+
+    for (const auto& x : others_[idx - primitives_.size()]->Intersect(
+             commontypes::Ray{origin, ray.direction_})) {
+        occluded |= x.t_ >= 0 && x.t_ < ray.distance_;
+    }
+    return occluded;
+}
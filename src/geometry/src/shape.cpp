@@ -1,13 +1,57 @@
 #include "shape.h"
 
-uint64_t geometry::Shape::SHAPE_ID = 0;
+std::atomic<uint64_t> geometry::Shape::NEXT_ID_BLOCK{0};
+
+uint64_t geometry::Shape::NextId() {
+    // the calling thread's current block; both are zero until the first Shape is constructed
+    thread_local uint64_t next_id = 0;
+    thread_local uint64_t block_end = 0;
+
+    if (next_id == block_end) {
+        next_id = NEXT_ID_BLOCK.fetch_add(ID_BLOCK_SIZE, std::memory_order_relaxed);
+        block_end = next_id + ID_BLOCK_SIZE;
+    }
+    return next_id++;
+}
+
+const std::shared_ptr<const commontypes::Matrix>& geometry::Shape::IdentityTransform() {
+    static const auto identity =
+        std::make_shared<const commontypes::Matrix>(commontypes::IdentityMatrix{});
+    return identity;
+}
 
 std::vector<geometry::Intersection> geometry::Shape::Intersect(const commontypes::Ray& ray) const {
     // transforms the Ray and calls the Shape's `LocalIntersect` w/ the transformed Ray
-    const commontypes::Ray transformed_ray = ray.Transform(transform_.Inverse());
+    const commontypes::Ray transformed_ray =
+        ray.Transform(transform_cache_ ? transform_cache_->inverse_ : transform_->Inverse());
     return LocalIntersect(transformed_ray);
 }
 
+void geometry::Shape::CacheTransforms() const {
+    if (!transform_cache_) {
+        CacheOwnTransforms();
+    }
+}
+
+void geometry::Shape::IndexMaterials(lighting::MaterialTable& table) const {
+    material_index_ = table.Add(material_ptr_);
+}
+
+void geometry::Shape::CacheOwnTransforms() const {
+    if (this->HasParent() && !this->parent_->transform_cache_) {
+        this->parent_->CacheOwnTransforms();
+    }
+
+    commontypes::Matrix inverse = transform_->Inverse();
+    commontypes::Matrix world_to_object = inverse;
+    if (this->HasParent()) {
+        world_to_object = inverse * this->parent_->transform_cache_->world_to_object_;
+    }
+    commontypes::Matrix normal_to_world = world_to_object.Transpose();
+    transform_cache_ = std::make_shared<const TransformCache>(TransformCache{
+        std::move(inverse), std::move(world_to_object), std::move(normal_to_world)});
+}
+
 commontypes::Vector geometry::Shape::NormalAt(const commontypes::Point& world_point) const {
     // first, convert the ray to object space
     const commontypes::Point local_point = this->WorldToObject(world_point);
@@ -19,7 +63,17 @@ commontypes::Vector geometry::Shape::NormalAt(const commontypes::Point& world_po
     return this->NormalToWorld(local_normal);
 }
 
+commontypes::Vector geometry::Shape::NormalAt(const commontypes::Point& world_point,
+                                              const geometry::Intersection& hit) const {
+    const commontypes::Point local_point = this->WorldToObject(world_point);
+    return this->NormalToWorld(LocalNormalAt(local_point, hit));
+}
+
 commontypes::Point geometry::Shape::WorldToObject(const commontypes::Point& point) const {
+    if (transform_cache_) {
+        return commontypes::Point{transform_cache_->world_to_object_ * point};
+    }
+
     commontypes::Point _point = point;
 
     // if a parent is present, first convert the Point to its parent's Space
@@ -27,10 +81,29 @@ commontypes::Point geometry::Shape::WorldToObject(const commontypes::Point& poin
         // account for parents
         _point = this->parent_->WorldToObject(point);
     }
-    return commontypes::Point{this->transform_.Inverse() * _point};
+    return commontypes::Point{this->transform_->Inverse() * _point};
+}
+
+commontypes::Matrix geometry::Shape::WorldToObjectMatrix() const {
+    if (transform_cache_) {
+        return transform_cache_->world_to_object_;
+    }
+
+    if (!this->HasParent()) {
+        return transform_->Inverse();
+    }
+    return transform_->Inverse() * this->parent_->WorldToObjectMatrix();
 }
 
 commontypes::Vector geometry::Shape::NormalToWorld(const commontypes::Vector& normal) const {
+    if (transform_cache_) {
+        // the parents' transforms are already composed in, and normalizing once at the end is
+        // equivalent to normalizing at each level
+        commontypes::Vector world_normal{transform_cache_->normal_to_world_ * normal};
+        world_normal.e_[3] = 0.0;
+        return commontypes::Vector{world_normal.Normalize()};
+    }
+
     // approach initially implemented on pg. 79
     commontypes::Vector _normal =
         commontypes::Vector{this->Transform().Inverse().Transpose() * normal};
@@ -0,0 +1,22 @@
+#include "smoothtriangle.h"
+
+std::vector<geometry::Intersection> geometry::SmoothTriangle::LocalIntersect(
+    const commontypes::Ray& ray) const {
+    double t, u, v;
+    if (!IntersectBarycentric(ray, t, u, v)) {
+        return {};
+    }
+    return {geometry::Intersection{
+        t, commontypes::MakeArenaShared<geometry::SmoothTriangle>(*this), u, v}};
+}
+
+commontypes::Vector geometry::SmoothTriangle::LocalNormalAt(
+    const commontypes::Point& local_point) const {
+    return Triangle::LocalNormalAt(local_point);
+}
+
+// see pg. 223
+commontypes::Vector geometry::SmoothTriangle::LocalNormalAt(const commontypes::Point&,
+                                                            const Intersection& hit) const {
+    return commontypes::Vector{n2_ * hit.u_ + n3_ * hit.v_ + n1_ * (1 - hit.u_ - hit.v_)};
+}
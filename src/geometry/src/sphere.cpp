@@ -1,14 +1,18 @@
 #include "sphere.h"
+#include "instrumentation.h"
+#include "primitive.h"
 
 std::vector<geometry::Intersection> geometry::Sphere::LocalIntersect(
     const commontypes::Ray& ray) const {
+    INSTRUMENT_COUNT_INTERSECTION_TEST(kSphere);
+
     // vector from Sphere's center to Ray's origin (pg. 62)
     const commontypes::Vector sphere_to_ray = commontypes::Vector{ray.origin() - origin_};
 
     const double a = ray.direction().Dot(ray.direction());
     const double b = 2 * ray.direction().Dot(sphere_to_ray);
     const double c = sphere_to_ray.Dot(sphere_to_ray) - 1;
-    const double discriminant = pow(b, 2) - 4 * a * c;
+    const double discriminant = b * b - 4 * a * c;
 
     // Ray misses the Sphere; no intersections occur
     if (discriminant < 0) {
@@ -20,7 +24,7 @@ std::vector<geometry::Intersection> geometry::Sphere::LocalIntersect(
     double t1 = (-b - sqrt(discriminant)) / (2 * a);
     double t2 = (-b + sqrt(discriminant)) / (2 * a);
 
-    std::shared_ptr<Sphere> object = std::make_shared<Sphere>(*this);
+    std::shared_ptr<Sphere> object = commontypes::MakeArenaShared<Sphere>(*this);
 
     // return t values in increasing order
     if (t1 > t2) {
@@ -37,3 +41,8 @@ commontypes::Vector geometry::Sphere::LocalNormalAt(const commontypes::Point& lo
 bool operator==(const geometry::Sphere& s1, const geometry::Sphere& s2) {
     return utility::NearEquals(s1.radii(), s2.radii()) && s1.origin() == s2.origin();
 }
+
+bool geometry::Sphere::ToPrimitive(Primitive& primitive) const {
+    primitive.kind_ = PrimitiveKind::kSphere;
+    return true;
+}
@@ -0,0 +1,285 @@
+#include "trianglemesh.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include "instrumentation.h"
+#include "utility.h"
+
+geometry::MeshData::MeshData(std::vector<float> xs,
+                             std::vector<float> ys,
+                             std::vector<float> zs,
+                             std::vector<uint32_t> indices)
+    : MeshData(std::move(xs), std::move(ys), std::move(zs), std::move(indices), {}, {}, {}, {}) {}
+
+geometry::MeshData::MeshData(std::vector<float> xs,
+                             std::vector<float> ys,
+                             std::vector<float> zs,
+                             std::vector<uint32_t> indices,
+                             std::vector<float> normal_xs,
+                             std::vector<float> normal_ys,
+                             std::vector<float> normal_zs,
+                             std::vector<uint32_t> normal_indices)
+    : xs_(std::move(xs)),
+      ys_(std::move(ys)),
+      zs_(std::move(zs)),
+      indices_(std::move(indices)),
+      normal_xs_(std::move(normal_xs)),
+      normal_ys_(std::move(normal_ys)),
+      normal_zs_(std::move(normal_zs)),
+      normal_indices_(std::move(normal_indices)) {
+    if (!normal_indices_.empty() && normal_indices_.size() != indices_.size()) {
+        throw std::invalid_argument("normal indices must be given for every triangle corner");
+    }
+
+    const auto n_triangles = static_cast<uint32_t>(this->n_triangles());
+    if (n_triangles == 0) {
+        return;
+    }
+
+    // centroid of each triangle, interleaved
+    std::vector<float> centroids(n_triangles * 3);
+    for (uint32_t tri = 0; tri < n_triangles; ++tri) {
+        for (size_t corner = 0; corner < 3; ++corner) {
+            const uint32_t vertex_idx = indices_[tri * 3 + corner];
+            centroids[tri * 3] += xs_[vertex_idx] / 3;
+            centroids[tri * 3 + 1] += ys_[vertex_idx] / 3;
+            centroids[tri * 3 + 2] += zs_[vertex_idx] / 3;
+        }
+    }
+
+    std::vector<uint32_t> order(n_triangles);
+    for (uint32_t tri = 0; tri < n_triangles; ++tri) {
+        order[tri] = tri;
+    }
+
+    BuildNode(order, centroids, 0, n_triangles);
+
+    // put each leaf's triangles next to each other
+    const auto reorder = [&order, n_triangles](std::vector<uint32_t>& triangle_indices) {
+        std::vector<uint32_t> ordered(triangle_indices.size());
+        for (uint32_t i = 0; i < n_triangles; ++i) {
+            std::copy_n(triangle_indices.begin() + order[i] * 3, 3, ordered.begin() + i * 3);
+        }
+        triangle_indices = std::move(ordered);
+    };
+    reorder(indices_);
+    if (!normal_indices_.empty()) {
+        reorder(normal_indices_);
+    }
+    nodes_.shrink_to_fit();
+}
+
+uint32_t geometry::MeshData::BuildNode(std::vector<uint32_t>& order,
+                                       const std::vector<float>& centroids,
+                                       const uint32_t first,
+                                       const uint32_t count) {
+    const auto node_idx = static_cast<uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+
+    // bounds of the triangles, and of their centroids
+    float min[3], max[3], centroid_min[3], centroid_max[3];
+    std::fill_n(min, 3, std::numeric_limits<float>::infinity());
+    std::fill_n(centroid_min, 3, std::numeric_limits<float>::infinity());
+    std::fill_n(max, 3, -std::numeric_limits<float>::infinity());
+    std::fill_n(centroid_max, 3, -std::numeric_limits<float>::infinity());
+
+    for (uint32_t i = first; i < first + count; ++i) {
+        const uint32_t tri = order[i];
+        for (size_t corner = 0; corner < 3; ++corner) {
+            const uint32_t vertex_idx = indices_[tri * 3 + corner];
+            const float vertex[3] = {xs_[vertex_idx], ys_[vertex_idx], zs_[vertex_idx]};
+            for (size_t axis = 0; axis < 3; ++axis) {
+                min[axis] = std::min(min[axis], vertex[axis]);
+                max[axis] = std::max(max[axis], vertex[axis]);
+            }
+        }
+        for (size_t axis = 0; axis < 3; ++axis) {
+            centroid_min[axis] = std::min(centroid_min[axis], centroids[tri * 3 + axis]);
+            centroid_max[axis] = std::max(centroid_max[axis], centroids[tri * 3 + axis]);
+        }
+    }
+
+    std::copy_n(min, 3, nodes_[node_idx].min_);
+    std::copy_n(max, 3, nodes_[node_idx].max_);
+
+    // split at the median centroid along the axis in which the centroids are most spread out
+    size_t split_axis = 0;
+    for (size_t axis = 1; axis < 3; ++axis) {
+        if (centroid_max[axis] - centroid_min[axis] >
+            centroid_max[split_axis] - centroid_min[split_axis]) {
+            split_axis = axis;
+        }
+    }
+
+    // coincident centroids can't be separated
+    if (count <= MAX_LEAF_TRIANGLES || centroid_max[split_axis] == centroid_min[split_axis]) {
+        nodes_[node_idx].offset_ = first;
+        nodes_[node_idx].count_ = count;
+        return node_idx;
+    }
+
+    const uint32_t mid = first + count / 2;
+    std::nth_element(order.begin() + first, order.begin() + mid, order.begin() + first + count,
+                     [&centroids, split_axis](const uint32_t lhs, const uint32_t rhs) {
+                         return centroids[lhs * 3 + split_axis] < centroids[rhs * 3 + split_axis];
+                     });
+
+    BuildNode(order, centroids, first, mid - first);
+    const uint32_t right_idx = BuildNode(order, centroids, mid, first + count - mid);
+    nodes_[node_idx].offset_ = right_idx;
+    nodes_[node_idx].count_ = 0;
+    return node_idx;
+}
+
+commontypes::Vector geometry::MeshData::TriangleNormal(const size_t triangle_idx) const {
+    const commontypes::Point p1 = TriangleVertex(triangle_idx, 0);
+    const commontypes::Vector e1{TriangleVertex(triangle_idx, 1) - p1};
+    const commontypes::Vector e2{TriangleVertex(triangle_idx, 2) - p1};
+    return commontypes::Vector{e2.Cross(e1).Normalize()};
+}
+
+commontypes::Vector geometry::MeshData::InterpolatedNormal(const size_t triangle_idx,
+                                                         const double u,
+                                                         const double v) const {
+    if (!HasVertexNormals(triangle_idx)) {
+        return TriangleNormal(triangle_idx);
+    }
+
+    // as for SmoothTriangle::LocalNormalAt
+    const double weights[3] = {1 - u - v, u, v};
+    double normal[3] = {0, 0, 0};
+    for (size_t corner = 0; corner < 3; ++corner) {
+        const uint32_t normal_idx = normal_indices_[triangle_idx * 3 + corner];
+        normal[0] += normal_xs_[normal_idx] * weights[corner];
+        normal[1] += normal_ys_[normal_idx] * weights[corner];
+        normal[2] += normal_zs_[normal_idx] * weights[corner];
+    }
+    return commontypes::Vector{normal[0], normal[1], normal[2]};
+}
+
+// as for Triangle::IntersectBarycentric (Moller-Trumbore)
+bool geometry::MeshData::IntersectTriangle(const commontypes::Ray& ray,
+                                           const uint32_t triangle_idx,
+                                           TriangleHit& hit) const {
+    INSTRUMENT_COUNT_INTERSECTION_TEST(kMeshTriangle);
+
+    const commontypes::Point p1 = TriangleVertex(triangle_idx, 0);
+    const commontypes::Vector e1{TriangleVertex(triangle_idx, 1) - p1};
+    const commontypes::Vector e2{TriangleVertex(triangle_idx, 2) - p1};
+
+    const commontypes::Vector dir_cross_e2 = ray.direction().Cross(e2);
+    const double determinant = e1.Dot(dir_cross_e2);
+    if (std::abs(determinant) < utility::EPSILON_) {
+        return false;
+    }
+
+    const double f = 1.0 / determinant;
+    const commontypes::Vector p1_to_origin = commontypes::Vector{ray.origin() - p1};
+    const double u = f * p1_to_origin.Dot(dir_cross_e2);
+    if (u < 0 || u > 1) {
+        return false;
+    }
+
+    const commontypes::Vector origin_cross_e1 = p1_to_origin.Cross(e1);
+    const double v = f * ray.direction().Dot(origin_cross_e1);
+    if (v < 0 || (u + v) > 1) {
+        return false;
+    }
+
+    hit = TriangleHit{f * e2.Dot(origin_cross_e1), u, v, triangle_idx};
+    return true;
+}
+
+void geometry::MeshData::Intersect(const commontypes::Ray& ray,
+                                   commontypes::ArenaVector<TriangleHit>& hits) const {
+    if (nodes_.empty()) {
+        return;
+    }
+
+    const double origin[3] = {ray.origin().x(), ray.origin().y(), ray.origin().z()};
+    const double inv_direction[3] = {1.0 / ray.direction().x(), 1.0 / ray.direction().y(),
+                                     1.0 / ray.direction().z()};
+
+    // slab test against the whole line, since hits behind the origin are reported too
+    const auto line_hits_node = [&](const BvhNode& node) {
+        double t_enter = -std::numeric_limits<double>::infinity();
+        double t_exit = std::numeric_limits<double>::infinity();
+        for (size_t axis = 0; axis < 3; ++axis) {
+            double t0 = (node.min_[axis] - origin[axis]) * inv_direction[axis];
+            double t1 = (node.max_[axis] - origin[axis]) * inv_direction[axis];
+            if (t0 > t1) {
+                std::swap(t0, t1);
+            }
+            // NaN (a line lying in a slab's plane) leaves the interval unchanged
+            t_enter = t0 > t_enter ? t0 : t_enter;
+            t_exit = t1 < t_exit ? t1 : t_exit;
+        }
+        return t_enter <= t_exit;
+    };
+
+    // depth is ~log2(n_triangles / MAX_LEAF_TRIANGLES), so this is ample
+    uint32_t stack[64];
+    size_t stack_size = 0;
+    stack[stack_size++] = 0;
+
+    while (stack_size > 0) {
+        const uint32_t node_idx = stack[--stack_size];
+        const BvhNode& node = nodes_[node_idx];
+        if (!line_hits_node(node)) {
+            continue;
+        }
+
+        if (node.count_ > 0) {
+            for (uint32_t tri = node.offset_; tri < node.offset_ + node.count_; ++tri) {
+                TriangleHit hit;
+                if (IntersectTriangle(ray, tri, hit)) {
+                    hits.push_back(hit);
+                }
+            }
+        } else {
+            stack[stack_size++] = node.offset_;
+            stack[stack_size++] = node_idx + 1;
+        }
+    }
+}
+
+size_t geometry::MeshData::MemoryBytes() const {
+    const size_t n_floats = xs_.capacity() + ys_.capacity() + zs_.capacity() +
+                            normal_xs_.capacity() + normal_ys_.capacity() + normal_zs_.capacity();
+    return n_floats * sizeof(float) +
+           (indices_.capacity() + normal_indices_.capacity()) * sizeof(uint32_t) +
+           nodes_.capacity() * sizeof(BvhNode);
+}
+
+std::vector<geometry::Intersection> geometry::TriangleMesh::LocalIntersect(
+    const commontypes::Ray& ray) const {
+    commontypes::ArenaVector<MeshData::TriangleHit> triangle_hits{};
+    mesh_->Intersect(ray, triangle_hits);
+
+    std::sort(triangle_hits.begin(), triangle_hits.end(),
+              [](const MeshData::TriangleHit& lhs, const MeshData::TriangleHit& rhs) {
+                  return lhs.t_ < rhs.t_;
+              });
+
+    // the triangle is recorded by the Intersection, so every hit can share the mesh itself.
+    // the aliasing constructor makes a shared_ptr that refers to the mesh without owning it
+    const std::shared_ptr<Shape> this_mesh{std::shared_ptr<Shape>{},
+                                           const_cast<geometry::TriangleMesh*>(this)};
+    std::vector<geometry::Intersection> intersections{};
+    intersections.reserve(triangle_hits.size());
+    for (const auto& hit : triangle_hits) {
+        intersections.emplace_back(hit.t_, this_mesh, hit.u_, hit.v_, hit.triangle_idx_);
+    }
+
+    return intersections;
+}
+
+commontypes::Vector geometry::TriangleMesh::LocalNormalAt(const commontypes::Point&) const {
+    throw std::logic_error("`LocalNormalAt` needs the Intersection for a TriangleMesh");
+}
+
+commontypes::Vector geometry::TriangleMesh::LocalNormalAt(const commontypes::Point&,
+                                                          const Intersection& hit) const {
+    return mesh_->InterpolatedNormal(hit.triangle_idx_, hit.u_, hit.v_);
+}
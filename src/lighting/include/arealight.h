@@ -0,0 +1,59 @@
+#ifndef AREA_LIGHT_H
+#define AREA_LIGHT_H
+
+#include <cstddef>
+#include <cstdint>
+#include "color.h"
+#include "point.h"
+#include "vector.h"
+
+namespace lighting {
+// a rectangular light, spanning `full_uvec` and `full_vvec` from `corner`. it's divided into
+// usteps x vsteps cells, and is sampled (for both shading and shadows) at a point in each cell,
+// which gives soft shadows
+class AreaLight {
+   public:
+    // throws std::invalid_argument if either step count is zero
+    AreaLight(const commontypes::Point& corner,
+              const commontypes::Vector& full_uvec,
+              size_t usteps,
+              const commontypes::Vector& full_vvec,
+              size_t vsteps,
+              const commontypes::Color& intensity);
+
+    inline commontypes::Point corner() const { return corner_; }
+    inline commontypes::Vector uvec() const { return uvec_; }  // the extent of a single cell
+    inline commontypes::Vector vvec() const { return vvec_; }
+    inline size_t usteps() const { return usteps_; }
+    inline size_t vsteps() const { return vsteps_; }
+    inline size_t samples() const { return usteps_ * vsteps_; }
+    inline commontypes::Color intensity() const { return intensity_; }
+
+    // the center of the light
+    inline commontypes::Point position() const { return position_; }
+
+    // the point within cell (u, v) at the given offsets, each in [0, 1); the cell's center by
+    // default
+    commontypes::Point PointOnLight(size_t u,
+                                    size_t v,
+                                    double jitter_u = 0.5,
+                                    double jitter_v = 0.5) const;
+
+    // a point within cell (u, v) at offsets derived from `seed`, so that the same seed always
+    // gives the same point (and different seeds give uncorrelated points)
+    commontypes::Point JitteredPointOnLight(size_t u, size_t v, uint64_t seed) const;
+
+   private:
+    commontypes::Point corner_;
+    commontypes::Vector uvec_;
+    size_t usteps_;
+    commontypes::Vector vvec_;
+    size_t vsteps_;
+    commontypes::Color intensity_;
+    commontypes::Point position_;
+};
+}  // namespace lighting
+
+bool operator==(const lighting::AreaLight& al1, const lighting::AreaLight& al2);
+
+#endif  // AREA_LIGHT_H
@@ -0,0 +1,25 @@
+#ifndef DIRECTIONAL_LIGHT_H
+#define DIRECTIONAL_LIGHT_H
+
+#include "color.h"
+#include "light.h"
+#include "vector.h"
+
+namespace lighting {
+// a light infinitely far away (e.g. the sun), whose rays all travel in `direction`
+class DirectionalLight final : public Light {
+   public:
+    DirectionalLight(const commontypes::Vector& direction, const commontypes::Color& intensity);
+
+    inline commontypes::Vector direction() const { return direction_; }
+
+    LightSample SampleFrom(const commontypes::Point& point) const override;
+
+   private:
+    commontypes::Vector direction_;  // normalized
+};
+}  // namespace lighting
+
+bool operator==(const lighting::DirectionalLight& dl1, const lighting::DirectionalLight& dl2);
+
+#endif  // DIRECTIONAL_LIGHT_H
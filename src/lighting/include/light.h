@@ -0,0 +1,43 @@
+#ifndef LIGHT_H
+#define LIGHT_H
+
+#include "color.h"
+#include "point.h"
+#include "vector.h"
+
+namespace lighting {
+// a Light as seen from a point
+struct LightSample {
+    commontypes::Vector direction_;  // from the point toward the light; normalized
+    double distance_;                // to the light; infinite for a DirectionalLight
+    commontypes::Color intensity_;   // reaching the point, ignoring anything in the way
+
+    // whether the light can contribute more than its ambient term to a surface with `normal` at
+    // the point; if not, a shadow ray toward it would be wasted
+    inline bool Illuminates(const commontypes::Vector& normal) const {
+        return direction_.Dot(normal) >= 0 && !(intensity_ == commontypes::Color{});
+    }
+};
+
+// a light that reaches a point from a single direction; see PointLight, SpotLight and
+// DirectionalLight
+class Light {
+   public:
+    virtual ~Light() = default;
+
+    inline commontypes::Color intensity() const { return intensity_; }
+
+    // SpotLights give no intensity to points outside their cone
+    virtual LightSample SampleFrom(const commontypes::Point& point) const = 0;
+
+   protected:
+    explicit Light(const commontypes::Color& intensity) : intensity_(intensity) {}
+    Light(const Light&) = default;
+    Light& operator=(const Light&) = default;
+
+   private:
+    commontypes::Color intensity_;
+};
+}  // namespace lighting
+
+#endif  // LIGHT_H
@@ -2,13 +2,20 @@
 #define LIGHTING_H
 
 #include <memory>
+#include "arealight.h"
 #include "color.h"
+#include "light.h"
 #include "material.h"
 #include "matrix.h"
 #include "pointlight.h"
+#include "shadingrecord.h"
 #include "vector.h"
 
 namespace lighting {
+// how a material's specular highlight, pow(cos, shininess), is evaluated: with std::pow, or with
+// utility::FastPow, which is exact for integral shininess and otherwise within a relative 2e-5
+enum class ShadingMode { kExact, kFast };
+
 commontypes::Color Lighting(
     const std::shared_ptr<Material>& material_ptr,
     const commontypes::Matrix& object_transform,  // a Shape's transformation matrix
@@ -17,6 +24,61 @@ commontypes::Color Lighting(
     const commontypes::Vector& eye_vector,
     const commontypes::Vector& normal_vector,
     bool in_shadow = false);
+
+commontypes::Color Lighting(const std::shared_ptr<Material>& material_ptr,
+                            const commontypes::Matrix& object_transform,
+                            const Light& light,
+                            const commontypes::Point& point,
+                            const commontypes::Vector& eye_vector,
+                            const commontypes::Vector& normal_vector,
+                            bool in_shadow = false);
+
+// as above, with the diffuse and specular contributions scaled by `light_intensity`: the fraction
+// of the light that reaches `point` (0 being fully in shadow)
+commontypes::Color Lighting(const std::shared_ptr<Material>& material_ptr,
+                            const commontypes::Matrix& object_transform,
+                            const Light& light,
+                            const commontypes::Point& point,
+                            const commontypes::Vector& eye_vector,
+                            const commontypes::Vector& normal_vector,
+                            double light_intensity);
+
+// the diffuse and specular contributions are averaged over the center of each of the light's cells
+commontypes::Color Lighting(const std::shared_ptr<Material>& material_ptr,
+                            const commontypes::Matrix& object_transform,
+                            const AreaLight& area_light,
+                            const commontypes::Point& point,
+                            const commontypes::Vector& eye_vector,
+                            const commontypes::Vector& normal_vector,
+                            double light_intensity);
+
+// the color of the Material of `record` at the world-space `point`: that of its pattern if it has
+// one, given the Shape's world-to-object matrix (the inverse of its transformation matrix), or
+// otherwise its color
+commontypes::Color SurfaceColor(const ShadingRecord& record,
+                                const commontypes::Matrix& world_to_object,
+                                const commontypes::Point& point);
+
+// as the last two Material overloads, reading the Material's properties from its ShadingRecord
+// and taking the `surface_color` at `point` (from SurfaceColor), so that a point lit by several
+// lights finds it once
+commontypes::Color Lighting(const ShadingRecord& record,
+                            const commontypes::Color& surface_color,
+                            const Light& light,
+                            const commontypes::Point& point,
+                            const commontypes::Vector& eye_vector,
+                            const commontypes::Vector& normal_vector,
+                            double light_intensity,
+                            ShadingMode mode = ShadingMode::kExact);
+
+commontypes::Color Lighting(const ShadingRecord& record,
+                            const commontypes::Color& surface_color,
+                            const AreaLight& area_light,
+                            const commontypes::Point& point,
+                            const commontypes::Vector& eye_vector,
+                            const commontypes::Vector& normal_vector,
+                            double light_intensity,
+                            ShadingMode mode = ShadingMode::kExact);
 }
 
 #endif  // LIGHTING_H
@@ -0,0 +1,50 @@
+#ifndef MATERIAL_TABLE_H
+#define MATERIAL_TABLE_H
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "material.h"
+#include "shadingrecord.h"
+
+namespace pattern {
+class PatternProgram;
+}
+
+namespace lighting {
+// the ShadingRecords of a scene's Materials, stored contiguously, along with each of their
+// Patterns compiled into a PatternProgram. Shapes record the index of their Material's record
+// (see Shape::IndexMaterials). records aren't updated when a Material (or Pattern) changes; the
+// table must be rebuilt instead
+class MaterialTable {
+   public:
+    static constexpr uint32_t NO_INDEX = UINT32_MAX;
+
+    // the index of `material`'s record, which is added if the Material hasn't been already
+    uint32_t Add(const std::shared_ptr<Material>& material);
+
+    void Clear();
+
+    inline size_t size() const { return records_.size(); }
+    inline const ShadingRecord& operator[](const uint32_t idx) const { return records_[idx]; }
+
+    // the record at `idx`, provided it was made from `material`; nullptr otherwise
+    inline const ShadingRecord* Find(const uint32_t idx, const Material* material) const {
+        if (idx >= records_.size() || records_[idx].material_ != material) {
+            return nullptr;
+        }
+        return &records_[idx];
+    }
+
+   private:
+    std::vector<ShadingRecord> records_;
+    std::vector<std::shared_ptr<Material>> materials_;  // keeps each record's Material alive
+    std::unordered_map<const Material*, uint32_t> indices_;
+    // by Pattern, as Materials often share one
+    std::unordered_map<const pattern::Pattern*, std::shared_ptr<const pattern::PatternProgram>>
+        programs_;
+};
+}  // namespace lighting
+
+#endif  // MATERIAL_TABLE_H
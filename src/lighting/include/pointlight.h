@@ -2,22 +2,23 @@
 #define POINT_LIGHT_H
 
 #include "color.h"
+#include "light.h"
 #include "point.h"
 
 namespace lighting {
-class PointLight {
+class PointLight final : public Light {
    public:
-    PointLight() : position_(commontypes::Point{}), intensity_(commontypes::Color{}) {}
+    PointLight() : Light(commontypes::Color{}), position_(commontypes::Point{}) {}
 
     explicit PointLight(const commontypes::Point& position, const commontypes::Color& intensity)
-        : position_(position), intensity_(intensity) {}
+        : Light(intensity), position_(position) {}
 
     inline commontypes::Point position() const { return position_; }
-    inline commontypes::Color intensity() const { return intensity_; }
+
+    LightSample SampleFrom(const commontypes::Point& point) const override;
 
    private:
     commontypes::Point position_;  // light exists at a single point in space
-    commontypes::Color intensity_;
 };
 }  // namespace lighting
 
@@ -0,0 +1,45 @@
+#ifndef SHADING_RECORD_H
+#define SHADING_RECORD_H
+
+#include <cstdint>
+#include "color.h"
+#include "material.h"
+
+namespace pattern {
+class Pattern;
+class PatternProgram;
+}
+
+namespace lighting {
+// what shading needs from a Material, flattened into a single cache line (see MaterialTable)
+struct alignas(64) ShadingRecord {
+    enum Flags : uint8_t { kReflective = 1, kTransparent = 2, kPattern = 4 };
+
+    float color_[3];
+    float ambient_;
+    float diffuse_;
+    float specular_;
+    float shininess_;
+    float reflective_;
+    float transparency_;
+    uint8_t flags_;
+    const pattern::Pattern* pattern_;  // owned by `material_`
+    // `pattern_` compiled, if the record was made by a MaterialTable (which owns it)
+    const pattern::PatternProgram* program_;
+    const Material* material_;  // the Material this was made from
+
+    static ShadingRecord FromMaterial(const Material& material);
+
+    inline bool IsReflective() const { return flags_ & kReflective; }
+    inline bool IsTransparent() const { return flags_ & kTransparent; }
+    inline bool HasPattern() const { return flags_ & kPattern; }
+
+    inline commontypes::Color Color() const {
+        return commontypes::Color{color_[0], color_[1], color_[2]};
+    }
+};
+
+static_assert(sizeof(ShadingRecord) == 64, "a ShadingRecord should fill one cache line");
+}  // namespace lighting
+
+#endif  // SHADING_RECORD_H
@@ -0,0 +1,40 @@
+#ifndef SPOT_LIGHT_H
+#define SPOT_LIGHT_H
+
+#include "color.h"
+#include "light.h"
+#include "point.h"
+#include "vector.h"
+
+namespace lighting {
+// a PointLight that only shines within a cone about `direction`. its intensity is full within
+// `inner_angle` of the cone's axis and falls off smoothly to nothing at `outer_angle` (radians)
+class SpotLight final : public Light {
+   public:
+    // throws std::invalid_argument unless 0 <= inner_angle <= outer_angle < pi
+    SpotLight(const commontypes::Point& position,
+              const commontypes::Vector& direction,
+              double inner_angle,
+              double outer_angle,
+              const commontypes::Color& intensity);
+
+    inline commontypes::Point position() const { return position_; }
+    inline commontypes::Vector direction() const { return direction_; }
+    inline double inner_angle() const { return inner_angle_; }
+    inline double outer_angle() const { return outer_angle_; }
+
+    LightSample SampleFrom(const commontypes::Point& point) const override;
+
+   private:
+    commontypes::Point position_;
+    commontypes::Vector direction_;  // normalized
+    double inner_angle_;
+    double outer_angle_;
+    double cos_inner_;
+    double cos_outer_;
+};
+}  // namespace lighting
+
+bool operator==(const lighting::SpotLight& sl1, const lighting::SpotLight& sl2);
+
+#endif  // SPOT_LIGHT_H
@@ -0,0 +1,53 @@
+#include "arealight.h"
+#include <stdexcept>
+
+namespace {
+// splitmix64's finalizer
+uint64_t Mix(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// the top 53 bits, as a double in [0, 1)
+double ToUnitInterval(const uint64_t x) {
+    return static_cast<double>(x >> 11) * 0x1.0p-53;
+}
+}  // namespace
+
+lighting::AreaLight::AreaLight(const commontypes::Point& corner,
+                               const commontypes::Vector& full_uvec,
+                               const size_t usteps,
+                               const commontypes::Vector& full_vvec,
+                               const size_t vsteps,
+                               const commontypes::Color& intensity)
+    : corner_(corner), usteps_(usteps), vsteps_(vsteps), intensity_(intensity) {
+    if (usteps == 0 || vsteps == 0) {
+        throw std::invalid_argument("an area light needs at least one step in each direction");
+    }
+
+    uvec_ = commontypes::Vector{full_uvec * (1.0 / static_cast<double>(usteps))};
+    vvec_ = commontypes::Vector{full_vvec * (1.0 / static_cast<double>(vsteps))};
+    position_ = commontypes::Point{corner + full_uvec * 0.5 + full_vvec * 0.5};
+}
+
+commontypes::Point lighting::AreaLight::PointOnLight(const size_t u,
+                                                     const size_t v,
+                                                     const double jitter_u,
+                                                     const double jitter_v) const {
+    return commontypes::Point{corner_ + uvec_ * (static_cast<double>(u) + jitter_u) +
+                              vvec_ * (static_cast<double>(v) + jitter_v)};
+}
+
+commontypes::Point lighting::AreaLight::JitteredPointOnLight(const size_t u,
+                                                             const size_t v,
+                                                             const uint64_t seed) const {
+    const uint64_t cell_hash = Mix(seed ^ Mix(v * usteps_ + u + 1));
+    return PointOnLight(u, v, ToUnitInterval(cell_hash), ToUnitInterval(Mix(cell_hash)));
+}
+
+bool operator==(const lighting::AreaLight& al1, const lighting::AreaLight& al2) {
+    return al1.corner() == al2.corner() && al1.uvec() == al2.uvec() &&
+           al1.usteps() == al2.usteps() && al1.vvec() == al2.vvec() &&
+           al1.vsteps() == al2.vsteps() && al1.intensity() == al2.intensity();
+}
@@ -0,0 +1,15 @@
+#include "directionallight.h"
+#include <limits>
+
+lighting::DirectionalLight::DirectionalLight(const commontypes::Vector& direction,
+                                             const commontypes::Color& intensity)
+    : Light(intensity), direction_(commontypes::Vector{direction.Normalize()}) {}
+
+lighting::LightSample lighting::DirectionalLight::SampleFrom(const commontypes::Point&) const {
+    return LightSample{commontypes::Vector{direction_ * -1.0},
+                       std::numeric_limits<double>::infinity(), intensity()};
+}
+
+bool operator==(const lighting::DirectionalLight& dl1, const lighting::DirectionalLight& dl2) {
+    return dl1.direction() == dl2.direction() && dl1.intensity() == dl2.intensity();
+}
@@ -1,6 +1,9 @@
 #include "lighting.h"
 #include "color.h"
+#include "instrumentation.h"
 #include "pattern.h"
+#include "patternprogram.h"
+#include "utility.h"
 
 commontypes::Color lighting::Lighting(const std::shared_ptr<Material>& material_ptr,
                                       const commontypes::Matrix& object_transform,
@@ -9,60 +12,172 @@ commontypes::Color lighting::Lighting(const std::shared_ptr<Material>& material_
                                       const commontypes::Vector& eye_vector,
                                       const commontypes::Vector& normal_vector,
                                       const bool in_shadow) {
-    // surface color with the light's color/intensity
-    auto material = *material_ptr;
-    const auto point_light = *point_light_ptr;
+    return Lighting(material_ptr, object_transform, *point_light_ptr, point, eye_vector,
+                    normal_vector, in_shadow);
+}
+
+commontypes::Color lighting::Lighting(const std::shared_ptr<Material>& material_ptr,
+                                      const commontypes::Matrix& object_transform,
+                                      const Light& light,
+                                      const commontypes::Point& point,
+                                      const commontypes::Vector& eye_vector,
+                                      const commontypes::Vector& normal_vector,
+                                      const bool in_shadow) {
+    return Lighting(material_ptr, object_transform, light, point, eye_vector, normal_vector,
+                    in_shadow ? 0.0 : 1.0);
+}
+
+commontypes::Color lighting::SurfaceColor(const ShadingRecord& record,
+                                          const commontypes::Matrix& world_to_object,
+                                          const commontypes::Point& point) {
+    // use the material's pattern at the given Shape, compiled if the record has been through a
+    // MaterialTable
+    if (record.program_ != nullptr) {
+        return record.program_->ColorAtShape(world_to_object, point);
+    }
+    if (record.HasPattern()) {
+        INSTRUMENT_PHASE(kPatternAtShape);
+        return record.pattern_->PatternAtObject(commontypes::Point{world_to_object * point});
+    }
 
     // with no pattern present, use the Material's color.
-    commontypes::Color color = material.Color();
+    return record.Color();
+}
 
-    // otherwise, use the material's pattern at the given Shape
-    if (material.HasPattern()) {
-        color = material.Pattern()->PatternAtShape(object_transform, point);
+namespace {
+// the inverse of a Shape's `object_transform`, which only a patterned Material needs (and so only
+// then is it taken)
+commontypes::Matrix WorldToObject(const lighting::Material& material,
+                                  const commontypes::Matrix& object_transform) {
+    return material.HasPattern() ? object_transform.Inverse() : object_transform;
+}
+
+// the diffuse and specular contributions of light of `light_intensity` arriving from
+// `light_vector` (the normalized direction toward the light)
+commontypes::Color DiffuseAndSpecular(const lighting::ShadingRecord& record,
+                                      const commontypes::Color& surface_color,
+                                      const commontypes::Color& light_intensity,
+                                      const commontypes::Vector& light_vector,
+                                      const commontypes::Vector& eye_vector,
+                                      const commontypes::Vector& normal_vector,
+                                      const lighting::ShadingMode mode) {
+    // represents the cosine of the angle between the light vector and the normal vector
+    // negative number means the light is on the other side of the surface
+    const double light_dot_normal = light_vector.Dot(normal_vector);
+
+    if (light_dot_normal < 0.0) {
+        // other side of the surface
+        return commontypes::Color::MakeBlack();
     }
 
-    const auto effective_color = color * point_light.intensity();
+    // diffuse contribution
+    const commontypes::Color effective_color = surface_color * light_intensity;
+    const commontypes::Color diffuse =
+        commontypes::Color{effective_color * record.diffuse_ * light_dot_normal};
 
-    // direction to the light source
-    const commontypes::Vector light_vector =
-        commontypes::Vector{(point_light.position() - point).Normalize()};
+    // reflect_dot_eye is the cosine of the angle between the reflection
+    // vector and the eye vector. A negative number means the light reflects
+    // away from the eye
+    commontypes::Vector reflect_v = commontypes::Vector{-light_vector.Reflect(normal_vector)};
+    const double reflect_dot_eye = reflect_v.Dot(eye_vector);
 
-    // ambient color contribution
-    const auto ambient = commontypes::Color{effective_color * material.Ambient()};
+    if (reflect_dot_eye <= 0.0) {
+        return diffuse;
+    }
+
+    // contribute specular contribution
+    const double factor = mode == lighting::ShadingMode::kFast
+                              ? utility::FastPow(reflect_dot_eye, record.shininess_)
+                              : pow(reflect_dot_eye, record.shininess_);
+    const commontypes::Color specular =
+        commontypes::Color{light_intensity * record.specular_ * factor};
+    return commontypes::Color{diffuse + specular};
+}
+}  // namespace
 
-    // when shadow, ignore the contributions of diffuse and specular (only ambient contributes)
-    if (in_shadow) {
+commontypes::Color lighting::Lighting(const std::shared_ptr<Material>& material_ptr,
+                                      const commontypes::Matrix& object_transform,
+                                      const Light& light,
+                                      const commontypes::Point& point,
+                                      const commontypes::Vector& eye_vector,
+                                      const commontypes::Vector& normal_vector,
+                                      const double light_intensity) {
+    const ShadingRecord record = ShadingRecord::FromMaterial(*material_ptr);
+    return Lighting(record,
+                    SurfaceColor(record, WorldToObject(*material_ptr, object_transform), point),
+                    light, point, eye_vector, normal_vector, light_intensity);
+}
+
+commontypes::Color lighting::Lighting(const std::shared_ptr<Material>& material_ptr,
+                                      const commontypes::Matrix& object_transform,
+                                      const AreaLight& area_light,
+                                      const commontypes::Point& point,
+                                      const commontypes::Vector& eye_vector,
+                                      const commontypes::Vector& normal_vector,
+                                      const double light_intensity) {
+    const ShadingRecord record = ShadingRecord::FromMaterial(*material_ptr);
+    return Lighting(record,
+                    SurfaceColor(record, WorldToObject(*material_ptr, object_transform), point),
+                    area_light, point, eye_vector, normal_vector, light_intensity);
+}
+
+commontypes::Color lighting::Lighting(const ShadingRecord& record,
+                                      const commontypes::Color& surface_color,
+                                      const Light& light,
+                                      const commontypes::Point& point,
+                                      const commontypes::Vector& eye_vector,
+                                      const commontypes::Vector& normal_vector,
+                                      const double light_intensity,
+                                      const ShadingMode mode) {
+    INSTRUMENT_PHASE(kLighting);
+
+    // ambient color contribution, which (as the light's own intensity is used) is the same for
+    // every point a SpotLight's cone does or doesn't reach
+    const auto ambient =
+        commontypes::Color{surface_color * light.intensity() * record.ambient_};
+
+    // when fully in shadow, ignore the contributions of diffuse and specular (only ambient
+    // contributes)
+    if (light_intensity == 0.0) {
         return commontypes::Color{ambient};
     }
 
-    // represents the cosine of the angle between the light vector and the normal vector
-    // negative number means the light is on the other side of the surface
-    const double light_dot_normal = light_vector.Dot(normal_vector);
+    const LightSample sample = light.SampleFrom(point);
+    const commontypes::Color diffuse_and_specular = DiffuseAndSpecular(
+        record, surface_color, sample.intensity_, sample.direction_, eye_vector, normal_vector,
+        mode);
+    return commontypes::Color{ambient + diffuse_and_specular * light_intensity};
+}
+
+commontypes::Color lighting::Lighting(const ShadingRecord& record,
+                                      const commontypes::Color& surface_color,
+                                      const AreaLight& area_light,
+                                      const commontypes::Point& point,
+                                      const commontypes::Vector& eye_vector,
+                                      const commontypes::Vector& normal_vector,
+                                      const double light_intensity,
+                                      const ShadingMode mode) {
+    INSTRUMENT_PHASE(kLighting);
 
-    commontypes::Color diffuse, specular;
+    const auto ambient =
+        commontypes::Color{surface_color * area_light.intensity() * record.ambient_};
+    if (light_intensity == 0.0) {
+        return commontypes::Color{ambient};
+    }
 
-    if (light_dot_normal < 0.0) {
-        // other side of the surface
-        diffuse = commontypes::Color::MakeBlack();
-        specular = commontypes::Color::MakeBlack();
-    } else {
-        // diffuse contribution
-        diffuse = commontypes::Color{effective_color * material.Diffuse() * light_dot_normal};
-
-        // reflect_dot_eye is the cosine of the angle between the reflection
-        // vector and the eye vector. A negative number means the light reflects
-        // away from the eye
-        commontypes::Vector reflect_v = commontypes::Vector{-light_vector.Reflect(normal_vector)};
-        const double reflect_dot_eye = reflect_v.Dot(eye_vector);
-
-        if (reflect_dot_eye <= 0.0) {
-            specular = commontypes::Color::MakeBlack();
-        } else {
-            // contribute specular contribution
-            const double factor = pow(reflect_dot_eye, material.Shininess());
-            specular = commontypes::Color{point_light.intensity() * material.Specular() * factor};
+    // the average over the center of each of the light's cells; jittering only matters for the
+    // shadow rays
+    commontypes::Color sum = commontypes::Color::MakeBlack();
+    for (size_t v = 0; v < area_light.vsteps(); ++v) {
+        for (size_t u = 0; u < area_light.usteps(); ++u) {
+            sum = commontypes::Color{
+                sum + DiffuseAndSpecular(
+                          record, surface_color, area_light.intensity(),
+                          commontypes::Vector{(area_light.PointOnLight(u, v) - point).Normalize()},
+                          eye_vector, normal_vector, mode)};
         }
     }
 
-    return commontypes::Color{ambient + diffuse + specular};
-}
\ No newline at end of file
+    const double weight = light_intensity / static_cast<double>(area_light.samples());
+    return commontypes::Color{ambient + sum * weight};
+}
@@ -0,0 +1,28 @@
+#include "materialtable.h"
+#include "patternprogram.h"
+
+uint32_t lighting::MaterialTable::Add(const std::shared_ptr<Material>& material) {
+    const auto [it, inserted] =
+        indices_.emplace(material.get(), static_cast<uint32_t>(records_.size()));
+    if (inserted) {
+        ShadingRecord& record = records_.emplace_back(ShadingRecord::FromMaterial(*material));
+        materials_.push_back(material);
+
+        if (record.HasPattern()) {
+            auto& program = programs_[record.pattern_];
+            if (!program) {
+                program = std::make_shared<const pattern::PatternProgram>(
+                    pattern::PatternProgram::Compile(*record.pattern_));
+            }
+            record.program_ = program.get();
+        }
+    }
+    return it->second;
+}
+
+void lighting::MaterialTable::Clear() {
+    records_.clear();
+    materials_.clear();
+    indices_.clear();
+    programs_.clear();
+}
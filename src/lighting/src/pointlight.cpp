@@ -1,5 +1,11 @@
 #include "pointlight.h"
 
+lighting::LightSample lighting::PointLight::SampleFrom(const commontypes::Point& point) const {
+    const commontypes::Vector to_light{position_ - point};
+    return LightSample{commontypes::Vector{to_light.Normalize()}, to_light.Magnitude(),
+                       intensity()};
+}
+
 bool operator==(const lighting::PointLight& pl1, const lighting::PointLight& pl2) {
     return pl1.position() == pl2.position() && pl1.intensity() == pl2.intensity();
 }
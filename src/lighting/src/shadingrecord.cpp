@@ -0,0 +1,22 @@
+#include "shadingrecord.h"
+
+lighting::ShadingRecord lighting::ShadingRecord::FromMaterial(const Material& material) {
+    ShadingRecord record{};
+    const commontypes::Color color = material.Color();
+    record.color_[0] = static_cast<float>(color.Red());
+    record.color_[1] = static_cast<float>(color.Green());
+    record.color_[2] = static_cast<float>(color.Blue());
+    record.ambient_ = static_cast<float>(material.Ambient());
+    record.diffuse_ = static_cast<float>(material.Diffuse());
+    record.specular_ = static_cast<float>(material.Specular());
+    record.shininess_ = static_cast<float>(material.Shininess());
+    record.reflective_ = static_cast<float>(material.Reflective());
+    record.transparency_ = static_cast<float>(material.Transparency());
+    record.pattern_ = material.Pattern().get();
+    record.material_ = &material;
+
+    record.flags_ = (material.Reflective() > 0 ? kReflective : 0) |
+                    (material.Transparency() > 0 ? kTransparent : 0) |
+                    (material.HasPattern() ? kPattern : 0);
+    return record;
+}
@@ -0,0 +1,45 @@
+#include "spotlight.h"
+#include <cmath>
+#include <stdexcept>
+
+lighting::SpotLight::SpotLight(const commontypes::Point& position,
+                               const commontypes::Vector& direction,
+                               const double inner_angle,
+                               const double outer_angle,
+                               const commontypes::Color& intensity)
+    : Light(intensity),
+      position_(position),
+      direction_(commontypes::Vector{direction.Normalize()}),
+      inner_angle_(inner_angle),
+      outer_angle_(outer_angle),
+      cos_inner_(std::cos(inner_angle)),
+      cos_outer_(std::cos(outer_angle)) {
+    if (inner_angle < 0 || inner_angle > outer_angle || outer_angle >= M_PI) {
+        throw std::invalid_argument("a spot light's angles must satisfy 0 <= inner <= outer < pi");
+    }
+}
+
+lighting::LightSample lighting::SpotLight::SampleFrom(const commontypes::Point& point) const {
+    const commontypes::Vector to_light{position_ - point};
+    const commontypes::Vector direction{to_light.Normalize()};
+
+    // the cosine of the angle between the cone's axis and the ray from the light to the point
+    const double cos_angle = -direction.Dot(direction_);
+    double falloff = 0;
+    if (cos_angle >= cos_inner_) {
+        falloff = 1;
+    } else if (cos_angle > cos_outer_) {
+        // smoothstep
+        const double x = (cos_angle - cos_outer_) / (cos_inner_ - cos_outer_);
+        falloff = x * x * (3 - 2 * x);
+    }
+
+    return LightSample{direction, to_light.Magnitude(),
+                       commontypes::Color{intensity() * falloff}};
+}
+
+bool operator==(const lighting::SpotLight& sl1, const lighting::SpotLight& sl2) {
+    return sl1.position() == sl2.position() && sl1.direction() == sl2.direction() &&
+           sl1.inner_angle() == sl2.inner_angle() && sl1.outer_angle() == sl2.outer_angle() &&
+           sl1.intensity() == sl2.intensity();
+}
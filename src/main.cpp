@@ -1,8 +1,20 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
 #include <filesystem>
 #include <fstream>
 #include <functional>
+#include <iomanip>
 #include <iostream>
 #include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "animation.h"
 #include "camera.h"
 #include "canvas.h"
 #include "checkerpattern.h"
@@ -13,32 +25,18 @@
 #include "material.h"
 #include "plane.h"
 #include "pointlight.h"
-#include "ray.h"
+#include "renderstats.h"
 #include "rotationmatrix.h"
 #include "scalingmatrix.h"
+#include "sceneloader.h"
 #include "sphere.h"
 #include "translationmatrix.h"
 #include "viewtransform.h"
 #include "world.h"
 
-// TODO individual renders should be moved to (ideally) separate executables
-
 namespace {
-const int CAMERA_HEIGHT = 900;
-const int CAMERA_WIDTH = 750;
-
-void WriteCanvasToPPM(const scene::Camera& camera, scene::World& world) {
-    const auto canvas = camera.Render(world);
-    std::string image_outdir_name = "images";
-
-    utility::CreateImageOutdir(image_outdir_name);
-    const std::string outfile_name =
-        std::move(image_outdir_name) + "/" + utility::CurrentDateStr() + "_image.ppm";
-    std::ofstream out{outfile_name};
-
-    out << canvas.WritePPM();
-    out.close();
-}
+const size_t DEFAULT_HSIZE = 900;
+const size_t DEFAULT_VSIZE = 750;
 
 std::vector<std::shared_ptr<geometry::Shape>> GetSpheresForCh7Render() {
     auto left_sphere = geometry::Sphere{};
@@ -83,9 +81,9 @@ std::vector<std::shared_ptr<geometry::Shape>> GetSpheresForCh7Render() {
         std::make_shared<geometry::Sphere>(right_sphere)};
 }
 
-void RenderChapter7Scene() {
+scene::SceneDescription RenderChapter7Scene() {
     scene::World world{};
-    scene::Camera camera{CAMERA_HEIGHT, CAMERA_WIDTH, M_PI / 3};
+    scene::Camera camera{DEFAULT_HSIZE, DEFAULT_VSIZE, M_PI / 3};
     camera.SetTransform(commontypes::ViewTransform{commontypes::Point{0, 1.5, -5},
                                                    commontypes::Point{0, 1, 0},
                                                    commontypes::Vector{0, 1, 0}});
@@ -126,71 +124,33 @@ void RenderChapter7Scene() {
     auto sphere_vec = GetSpheresForCh7Render();
     world.AddObjects(std::move(sphere_vec));
 
-    WriteCanvasToPPM(camera, world);
+    return {std::move(world), camera};
 }
 
-void Chapter6RenderRenderExample(
-    const std::optional<commontypes::Matrix>& transform_matrix = std::nullopt) {
-    commontypes::Point ray_origin{0, 0, -5};
-    double wall_z = 10;
-    double wall_size = 7.0;
-    double half = wall_size / 2;
-    uint16_t canvas_pixels = 1000;
-    double pixel_size = wall_size / canvas_pixels;
-    canvas::Canvas canvas{canvas_pixels, canvas_pixels};
-
-    geometry::Sphere shape;
-    if (transform_matrix.has_value()) {
-        shape.SetTransform(transform_matrix.value());
-    }
-
-    std::shared_ptr<lighting::Material> m_ptr = std::make_shared<lighting::Material>();
-    shape.SetMaterial(m_ptr);
-    m_ptr->SetColor(commontypes::Color{1, 0.2, 1});
-
-    commontypes::Point light_position{-10, 10, -10};
-    commontypes::Color light_color{1, 1, 1};
-    lighting::PointLight light{light_position, light_color};
-
-    for (int y = 0; y < canvas.height() - 1; ++y) {
-        std::clog << '\r' << "Scanlines remaining: " << (canvas.height() - y) << " " << std::flush;
-
-        const double world_y = half - pixel_size * y;
-
-        for (int x = 0; x < canvas.width() - 1; ++x) {
-            double world_x = -half + pixel_size * x;
-            commontypes::Point position{world_x, world_y, wall_z};
-            commontypes::Ray r{ray_origin,
-                               commontypes::Vector{(position - ray_origin).Normalize()}};
-            auto xs = shape.Intersect(r);
-
-            if (!xs.empty()) {
-                geometry::Intersection hit = xs.at(0);
-                commontypes::Point point = r.Position(hit.t_);
-                commontypes::Vector normal = hit.object_->NormalAt(point);
-                commontypes::Vector eye = commontypes::Vector{-r.direction()};
+// the single sphere from chapter 6, seen from where the book casts its rays
+scene::SceneDescription Chapter6Sphere() {
+    scene::World world{};
+    world.SetLight(std::make_shared<lighting::PointLight>(commontypes::Point{-10, 10, -10},
+                                                          commontypes::Color{1, 1, 1}));
 
-                commontypes::Color color = lighting::Lighting(
-                    hit.object_->Material(), commontypes::IdentityMatrix{},
-                    std::make_shared<lighting::PointLight>(light), point, eye, normal);
-                canvas.WritePixel(x, y, color);
-            }
-        }
-    }
+    auto sphere = std::make_shared<geometry::Sphere>();
+    sphere->Material()->SetColor(commontypes::Color{1, 0.2, 1});
+    world.AddObject(sphere);
 
-    const std::string image_outdir_name = "images";
-    utility::CreateImageOutdir(image_outdir_name);
-    std::ofstream out{image_outdir_name + "/" + utility::CurrentDateStr() + "image.ppm"};
+    // the book's 7x7 wall at z = 10, 15 units from the ray origin
+    scene::Camera camera{1000, 1000, 2 * atan(3.5 / 15)};
+    camera.SetTransform(commontypes::ViewTransform{commontypes::Point{0, 0, -5},
+                                                   commontypes::Point{0, 0, 0},
+                                                   commontypes::Vector{0, 1, 0}});
 
-    out << canvas.WritePPM();
-    out.close();
+    return {std::move(world), camera};
 }
 
 // example fromm chapter 9 using the previous chapters' Spheres with the addition of a
 // Plane for the "floor" in the image
-void Chapter10PatternPlaneRender() {
+scene::SceneDescription Chapter10PatternPlaneRender() {
     scene::World world{};
-    scene::Camera camera{CAMERA_HEIGHT, CAMERA_WIDTH, M_PI / 3};
+    scene::Camera camera{DEFAULT_HSIZE, DEFAULT_VSIZE, M_PI / 3};
 
     const commontypes::Point from{0, 1.5, -5};
     const commontypes::Point to{0, 1, 0};
@@ -220,12 +180,12 @@ void Chapter10PatternPlaneRender() {
     auto sphere_vec = GetSpheresForCh7Render();
     world.AddObjects(std::move(sphere_vec));
 
-    WriteCanvasToPPM(camera, world);
+    return {std::move(world), camera};
 }
 
 // a "room" with a checkered pattern, a transparent Sphere, and a red Sphere offset and positioned
 // behind the transparent Sphere
-void PatternRoomRefractiveSphere() {
+scene::SceneDescription PatternRoomRefractiveSphere() {
     scene::World world{};
     auto light = lighting::PointLight{commontypes::Point{-1, 20, 0}, commontypes::Color{1, 1, 1}};
     world.SetLight(std::make_shared<lighting::PointLight>(light));
@@ -268,7 +228,7 @@ void PatternRoomRefractiveSphere() {
 
     world.AddObject(std::make_shared<geometry::Sphere>(std::move(red_sphere)));
 
-    scene::Camera camera{CAMERA_HEIGHT, CAMERA_WIDTH, M_PI / 4.0};
+    scene::Camera camera{DEFAULT_HSIZE, DEFAULT_VSIZE, M_PI / 4.0};
 
     commontypes::Point from = commontypes::Point(10, 1, 0);
     commontypes::Point to = commontypes::Point(0.0, 0.0, 0.0);
@@ -276,10 +236,10 @@ void PatternRoomRefractiveSphere() {
 
     camera.SetTransform(commontypes::ViewTransform{from, to, up});
 
-    WriteCanvasToPPM(camera, world);
+    return {std::move(world), camera};
 }
 
-void PatternRoomRefractiveCylinder() {
+scene::SceneDescription PatternRoomRefractiveCylinder() {
     scene::World world{};
     auto light = lighting::PointLight{commontypes::Point{-1, 20, 0}, commontypes::Color{1, 0, 0}};
     world.SetLight(std::make_shared<lighting::PointLight>(light));
@@ -324,7 +284,7 @@ void PatternRoomRefractiveCylinder() {
 
     world.AddObject(std::make_shared<geometry::Sphere>(std::move(red_sphere)));
 
-    scene::Camera camera{CAMERA_HEIGHT, CAMERA_WIDTH, M_PI / 4.0};
+    scene::Camera camera{DEFAULT_HSIZE, DEFAULT_VSIZE, M_PI / 4.0};
 
     const commontypes::Point from = commontypes::Point(10, 1, 0);
     const commontypes::Point to = commontypes::Point(0.0, 0.0, 0.0);
@@ -332,11 +292,357 @@ void PatternRoomRefractiveCylinder() {
 
     camera.SetTransform(commontypes::ViewTransform{from, to, up});
 
-    WriteCanvasToPPM(camera, world);
+    return {std::move(world), camera};
+}
+
+using SceneFn = scene::SceneDescription (*)();
+
+struct BuiltinScene {
+    std::string_view name_;
+    SceneFn scene_fn_;
+};
+
+const BuiltinScene BUILTIN_SCENES[] = {
+    {"chapter6-sphere", &Chapter6Sphere},
+    {"chapter7", &RenderChapter7Scene},
+    {"chapter10-patterns", &Chapter10PatternPlaneRender},
+    {"refractive-sphere-room", &PatternRoomRefractiveSphere},
+    {"refractive-cylinder-room", &PatternRoomRefractiveCylinder},
+};
+
+enum class ImageFormat { kPPM, kBinaryPPM };
+
+struct Options {
+    std::string scene_{"refractive-cylinder-room"};
+    std::optional<size_t> width_;
+    std::optional<size_t> height_;
+    std::optional<size_t> n_threads_;
+    size_t samples_{1};
+    std::optional<size_t> max_depth_;
+    lighting::ShadingMode shading_mode_{lighting::ShadingMode::kExact};
+    std::string output_;  // images/<date>_image.ppm when empty
+    ImageFormat format_{ImageFormat::kPPM};
+    std::string heatmap_output_;  // <output>_heatmap.ppm when empty
+    bool write_heatmap_{true};
+    scene::TileOrder tile_order_{scene::TileOrder::kScanline};
+    size_t bench_runs_{0};  // 0 renders once, without timing statistics
+    size_t n_frames_{0};    // 0 renders a still image rather than a turntable
+    bool show_help_{false};
+};
+
+void OutputUsage(std::ostream& out) {
+    out << "usage: RayTracerChallengeBook [options]\n"
+           "  --scene NAME|FILE     built-in scene name or JSON scene file"
+           " (default: refractive-cylinder-room)\n"
+           "  --width N             image width in pixels (default: the scene's)\n"
+           "  --height N            image height in pixels (default: the scene's)\n"
+           "  --threads N           render threads (default: one per hardware thread)\n"
+           "  --samples N           samples per pixel; a square number (default: 1)\n"
+           "  --max-depth N         reflection/refraction recursion limit (default: 5)\n"
+           "  --shading exact|fast  specular highlights via std::pow, or an approximation\n"
+           "                        within a relative 2e-5 (default: exact)\n"
+           "  --output PATH         image path (default: images/<date>_image.ppm)\n"
+           "  --format ppm|ppm-binary\n"
+           "                        P3 (text) or P6 (binary) PPM (default: ppm)\n"
+           "  --heatmap PATH        heatmap of the time spent on each pixel, written with every\n"
+           "                        image (default: <output>_heatmap.ppm)\n"
+           "  --no-heatmap          don't write the heatmap\n"
+           "  --tile-order scanline|prepass|previous-frame\n"
+           "                        order in which tiles are rendered (default: scanline)\n"
+           "  --bench N             render N times and report min/median/max render times;\n"
+           "                        the image is only written if --output is given\n"
+           "  --frames N            render N frames of the scene making a full turn about the\n"
+           "                        y-axis, to <output>_0000.ppm etc.\n"
+           "  --help                show this message\n"
+           "built-in scenes:";
+    for (const auto& builtin : BUILTIN_SCENES) {
+        out << " " << builtin.name_;
+    }
+    out << "\n";
+}
+
+size_t ParseCount(const std::string_view option, const std::string& value, const size_t min) {
+    size_t n_parsed = 0;
+    unsigned long count = 0;
+    try {
+        count = std::stoul(value, &n_parsed);
+    } catch (const std::logic_error&) {
+        n_parsed = 0;
+    }
+
+    if (n_parsed != value.size() || value.front() == '-' || count < min) {
+        throw std::invalid_argument(std::string{option} + " expects an integer >= " +
+                                    std::to_string(min) + ", got '" + value + "'");
+    }
+    return count;
+}
+
+Options ParseOptions(const int argc, char* argv[]) {
+    Options options{};
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view option{argv[i]};
+        if (option == "--help" || option == "-h") {
+            options.show_help_ = true;
+            continue;
+        }
+        if (option == "--no-heatmap") {
+            options.write_heatmap_ = false;
+            continue;
+        }
+
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("missing value for " + std::string{option});
+        }
+        const std::string value{argv[++i]};
+
+        if (option == "--scene") {
+            options.scene_ = value;
+        } else if (option == "--width") {
+            options.width_ = ParseCount(option, value, 1);
+        } else if (option == "--height") {
+            options.height_ = ParseCount(option, value, 1);
+        } else if (option == "--threads") {
+            options.n_threads_ = ParseCount(option, value, 1);
+        } else if (option == "--samples") {
+            options.samples_ = ParseCount(option, value, 1);
+        } else if (option == "--max-depth") {
+            options.max_depth_ = ParseCount(option, value, 0);
+        } else if (option == "--shading") {
+            if (value == "exact") {
+                options.shading_mode_ = lighting::ShadingMode::kExact;
+            } else if (value == "fast") {
+                options.shading_mode_ = lighting::ShadingMode::kFast;
+            } else {
+                throw std::invalid_argument("unknown shading mode '" + value + "'");
+            }
+        } else if (option == "--output") {
+            options.output_ = value;
+        } else if (option == "--format") {
+            if (value == "ppm") {
+                options.format_ = ImageFormat::kPPM;
+            } else if (value == "ppm-binary") {
+                options.format_ = ImageFormat::kBinaryPPM;
+            } else {
+                throw std::invalid_argument("unknown format '" + value + "'");
+            }
+        } else if (option == "--heatmap") {
+            options.heatmap_output_ = value;
+        } else if (option == "--tile-order") {
+            if (value == "scanline") {
+                options.tile_order_ = scene::TileOrder::kScanline;
+            } else if (value == "prepass") {
+                options.tile_order_ = scene::TileOrder::kPrepass;
+            } else if (value == "previous-frame") {
+                options.tile_order_ = scene::TileOrder::kPreviousFrame;
+            } else {
+                throw std::invalid_argument("unknown tile order '" + value + "'");
+            }
+        } else if (option == "--bench") {
+            options.bench_runs_ = ParseCount(option, value, 1);
+        } else if (option == "--frames") {
+            options.n_frames_ = ParseCount(option, value, 1);
+        } else {
+            throw std::invalid_argument("unknown option " + std::string{option});
+        }
+    }
+
+    if (options.bench_runs_ > 0 && options.n_frames_ > 0) {
+        throw std::invalid_argument("--bench and --frames can't be combined");
+    }
+    return options;
+}
+
+// a built-in scene by name, otherwise a scene file
+scene::SceneDescription LoadScene(const std::string& scene_name) {
+    for (const auto& builtin : BUILTIN_SCENES) {
+        if (builtin.name_ == scene_name) {
+            return builtin.scene_fn_();
+        }
+    }
+
+    if (!std::filesystem::exists(scene_name)) {
+        throw std::invalid_argument("'" + scene_name +
+                                    "' is neither a built-in scene nor a scene file");
+    }
+
+    auto description = scene::SceneLoader::LoadFile(scene_name);
+    if (!description.camera_) {
+        throw std::invalid_argument("scene file '" + scene_name + "' has no camera");
+    }
+    return description;
+}
+
+// the scene's camera, with the resolution and render settings given on the command line
+scene::Camera ConfigureCamera(const scene::Camera& scene_camera, const Options& options) {
+    scene::Camera camera{options.width_.value_or(scene_camera.hsize()),
+                         options.height_.value_or(scene_camera.vsize()),
+                         scene_camera.field_of_view()};
+    camera.SetTransform(scene_camera.transform());
+    camera.SetSamplesPerPixel(options.samples_);
+    camera.SetTileOrder(options.tile_order_);
+    if (options.n_threads_) {
+        camera.SetThreadCount(*options.n_threads_);
+    }
+    return camera;
+}
+
+void WriteImage(const canvas::Canvas& image, const std::string& path, const ImageFormat format) {
+    const std::filesystem::path parent_dir = std::filesystem::path{path}.parent_path();
+    if (!parent_dir.empty()) {
+        std::filesystem::create_directories(parent_dir);
+    }
+
+    std::ofstream out{path, std::ios::binary};
+    if (format == ImageFormat::kBinaryPPM) {
+        out << image.WriteBinaryPPM();
+    } else {
+        out << image.WritePPM();
+    }
+
+    if (!out) {
+        throw std::runtime_error("unable to write " + path);
+    }
+    std::clog << "\n\rWrote " << path << std::flush;
+}
+
+// `path` with the (zero-padded) frame number appended to its stem, e.g. out_0012.ppm
+std::string FramePath(const std::string& path, const size_t frame) {
+    std::array<char, 32> number{};
+    std::snprintf(number.data(), number.size(), "_%04zu", frame);
+    const std::filesystem::path original{path};
+    return (original.parent_path() /
+            (original.stem().string() + number.data() + original.extension().string()))
+        .string();
+}
+
+// the image (and heatmap) of a still, or of `frame` of an animation
+void WriteOutputs(const canvas::Canvas& image,
+                  const scene::RenderStats& stats,
+                  const Options& options,
+                  const std::optional<size_t> frame = std::nullopt) {
+    std::string output = options.output_;
+    std::string heatmap_output = options.heatmap_output_;
+    if (output.empty()) {
+        const std::string image_outdir_name = "images";
+        utility::CreateImageOutdir(image_outdir_name);
+        const std::string outfile_prefix = image_outdir_name + "/" + utility::CurrentDateStr();
+        output = outfile_prefix + "_image.ppm";
+        if (heatmap_output.empty()) {
+            heatmap_output = outfile_prefix + "_heatmap.ppm";
+        }
+    } else if (heatmap_output.empty()) {
+        const std::filesystem::path original{output};
+        heatmap_output = (original.parent_path() / (original.stem().string() + "_heatmap" +
+                                                     original.extension().string()))
+                             .string();
+    }
+
+    WriteImage(image, frame ? FramePath(output, *frame) : output, options.format_);
+    if (options.write_heatmap_) {
+        WriteImage(stats.Heatmap(), frame ? FramePath(heatmap_output, *frame) : heatmap_output,
+                   options.format_);
+    }
+}
+
+// render `n_frames` frames of every object in the World making one full turn about the y-axis
+// (under a still camera and lights), from a single World refit between frames
+void RenderTurntable(scene::Camera& camera,
+                     scene::World& world,
+                     const size_t n_frames,
+                     const Options& options) {
+    scene::Animation animation{};
+    for (const auto& object : world.objects()) {
+        animation.AddTransformKey(object, scene::TransformKey{0});
+        scene::TransformKey turned{1};
+        turned.rotation_ = {0, 2 * M_PI, 0};
+        animation.AddTransformKey(object, turned);
+    }
+
+    animation.Render(world, camera, n_frames,
+                     [&options, n_frames](const size_t frame, const canvas::Canvas& image,
+                                          const scene::RenderStats& stats) {
+                         std::clog << "\rframe " << frame + 1 << " of " << n_frames << " "
+                                   << std::flush;
+                         WriteOutputs(image, stats, options, frame);
+                     });
+}
+
+// render `n_runs` times, reporting the spread of the render times
+void Bench(const scene::Camera& camera,
+           scene::World& world,
+           const size_t n_runs,
+           const Options& options) {
+    scene::RenderStats stats{camera.hsize(), camera.vsize()};
+    std::vector<double> seconds{};
+    std::optional<canvas::Canvas> image;
+
+    for (size_t run = 0; run < n_runs; ++run) {
+        const auto start_time = std::chrono::steady_clock::now();
+        image.emplace(camera.Render(world, stats));
+        seconds.push_back(
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count());
+    }
+
+    std::sort(seconds.begin(), seconds.end());
+    const size_t mid = seconds.size() / 2;
+    const double median =
+        seconds.size() % 2 == 1 ? seconds[mid] : (seconds[mid - 1] + seconds[mid]) / 2;
+
+    std::cout << "\nbench: " << n_runs << " runs of " << camera.hsize() << "x" << camera.vsize()
+              << " at " << camera.SamplesPerPixel() << " spp, " << camera.n_threads()
+              << " threads: min " << std::fixed << std::setprecision(3) << seconds.front()
+              << " s, median " << median << " s, max " << seconds.back() << " s" << std::endl;
+
+    if (!options.output_.empty()) {
+        WriteOutputs(*image, stats, options);
+    }
 }
 }  // namespace
 
-int main() {
-    std::function<void()> render_fn = &PatternRoomRefractiveCylinder;
-    utility::OutputMeasuredDuration(render_fn);
+int main(int argc, char* argv[]) {
+    Options options{};
+    try {
+        options = ParseOptions(argc, argv);
+    } catch (const std::invalid_argument& e) {
+        std::cerr << e.what() << "\n";
+        OutputUsage(std::cerr);
+        return 1;
+    }
+
+    if (options.show_help_) {
+        OutputUsage(std::cout);
+        return 0;
+    }
+
+    try {
+        auto description = LoadScene(options.scene_);
+        scene::World& world = description.world_;
+        if (options.max_depth_) {
+            world.SetRecursionLimit(
+                static_cast<uint8_t>(std::min<size_t>(*options.max_depth_, UINT8_MAX)));
+        }
+        world.SetShadingMode(options.shading_mode_);
+        scene::Camera camera = ConfigureCamera(*description.camera_, options);
+
+        if (options.bench_runs_ > 0) {
+            Bench(camera, world, options.bench_runs_, options);
+            return 0;
+        }
+        if (options.n_frames_ > 0) {
+            utility::OutputMeasuredDuration(
+                [&]() { RenderTurntable(camera, world, options.n_frames_, options); });
+            return 0;
+        }
+
+        const std::function<void()> render_fn = [&]() {
+            scene::RenderStats stats{camera.hsize(), camera.vsize()};
+            const canvas::Canvas image = camera.Render(world, stats);
+            WriteOutputs(image, stats, options);
+        };
+        utility::OutputMeasuredDuration(render_fn);
+    } catch (const std::exception& e) {
+        std::cerr << "\n" << e.what() << "\n";
+        return 1;
+    }
 }
@@ -0,0 +1,32 @@
+#ifndef BLEND_PATTERN_H
+#define BLEND_PATTERN_H
+
+#include <memory>
+#include "color.h"
+#include "pattern.h"
+
+namespace pattern {
+// the weighted average of two Patterns, each evaluated (with its own transform) at the same point
+// (see pg. 138)
+class BlendPattern : public Pattern {
+   public:
+    // `weight` is that of the second Pattern; throws std::invalid_argument if either Pattern is
+    // missing or the weight isn't within [0, 1]
+    BlendPattern(std::shared_ptr<const Pattern> pattern_a,
+                 std::shared_ptr<const Pattern> pattern_b,
+                 double weight = 0.5);
+
+    commontypes::Color PatternAt(const commontypes::Point& point) const override;
+
+    inline const std::shared_ptr<const Pattern>& PatternA() const { return pattern_a_; }
+    inline const std::shared_ptr<const Pattern>& PatternB() const { return pattern_b_; }
+    inline double weight() const { return weight_; }
+
+   private:
+    std::shared_ptr<const Pattern> pattern_a_;
+    std::shared_ptr<const Pattern> pattern_b_;
+    double weight_;
+};
+}  // namespace pattern
+
+#endif  // BLEND_PATTERN_H
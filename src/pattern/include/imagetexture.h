@@ -0,0 +1,60 @@
+#ifndef IMAGE_TEXTURE_H
+#define IMAGE_TEXTURE_H
+
+#include <string_view>
+#include <vector>
+#include "color.h"
+
+namespace pattern {
+// how ImageTexture::ColorAt treats a coordinate beyond [0, 1): the image either repeats, filtering
+// across its opposite edges, or its edge texels extend outward
+enum class TextureWrap { kRepeat, kClamp };
+
+// a decoded image, sampled by (u, v) coordinates. texels are stored as floats in square tiles,
+// so that neighboring lookups (in both directions) tend to share cache lines, along with a
+// chain of mip levels; each level is half the size of the one before, down to 1x1
+class ImageTexture {
+   public:
+    // `pixels` is row-major, starting with the top row; throws std::invalid_argument if there
+    // isn't one per texel
+    ImageTexture(size_t width, size_t height, const std::vector<commontypes::Color>& pixels);
+
+    // decodes a P3 (text) or P6 (binary) PPM image; throws std::invalid_argument if malformed
+    static ImageTexture FromPPM(std::string_view ppm);
+
+    inline size_t width() const { return levels_.front().width_; }
+    inline size_t height() const { return levels_.front().height_; }
+    inline size_t levels() const { return levels_.size(); }
+
+    // memory used by the texels of every level
+    size_t bytes() const;
+
+    // of mip `level` (clamped to the smallest), where (0, 0) is the top left
+    commontypes::Color Texel(size_t x, size_t y, size_t level = 0) const;
+
+    // bilinearly filtered color at (u, v), where (0, 0) is the bottom left of the image, with
+    // each coordinate wrapped as given
+    commontypes::Color ColorAt(double u,
+                               double v,
+                               size_t level = 0,
+                               TextureWrap wrap_u = TextureWrap::kRepeat,
+                               TextureWrap wrap_v = TextureWrap::kRepeat) const;
+
+    static constexpr size_t TILE_SIZE = 8;  // texels along each side of a tile
+
+   private:
+    struct Level {
+        size_t width_;
+        size_t height_;
+        size_t tiles_across_;
+        std::vector<float> texels_;  // RGB, tile by tile
+
+        Level(size_t width, size_t height);
+        size_t Offset(size_t x, size_t y) const;
+    };
+
+    std::vector<Level> levels_;
+};
+}  // namespace pattern
+
+#endif  // IMAGE_TEXTURE_H
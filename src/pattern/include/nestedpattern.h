@@ -0,0 +1,34 @@
+#ifndef NESTED_PATTERN_H
+#define NESTED_PATTERN_H
+
+#include <memory>
+#include "color.h"
+#include "pattern.h"
+
+namespace pattern {
+// one of the two-color patterns with a Pattern in place of each color, e.g. a checker board whose
+// squares are striped (see pg. 138). each sub-pattern is evaluated (with its own transform) at
+// this Pattern's point
+class NestedPattern : public Pattern {
+   public:
+    enum class Kind { kStripe, kGradient, kRing, kChecker, kRadialGradient };
+
+    // throws std::invalid_argument if either Pattern is missing
+    NestedPattern(Kind kind,
+                  std::shared_ptr<const Pattern> pattern_a,
+                  std::shared_ptr<const Pattern> pattern_b);
+
+    commontypes::Color PatternAt(const commontypes::Point& point) const override;
+
+    inline Kind kind() const { return kind_; }
+    inline const std::shared_ptr<const Pattern>& PatternA() const { return pattern_a_; }
+    inline const std::shared_ptr<const Pattern>& PatternB() const { return pattern_b_; }
+
+   private:
+    Kind kind_;
+    std::shared_ptr<const Pattern> pattern_a_;
+    std::shared_ptr<const Pattern> pattern_b_;
+};
+}  // namespace pattern
+
+#endif  // NESTED_PATTERN_H
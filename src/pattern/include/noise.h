@@ -0,0 +1,45 @@
+#ifndef NOISE_H
+#define NOISE_H
+
+#include <cstddef>
+#include "point.h"
+
+namespace pattern {
+// points are evaluated this many at a time by the batched functions below; each stage of the
+// evaluation is a loop over a batch, with the points' coordinates in separate arrays, so that the
+// compiler can vectorize it
+constexpr size_t NOISE_BATCH = 8;
+
+// Ken Perlin's improved gradient noise: smooth, repeating every 256 units, zero at integer
+// coordinates and (very nearly) within [-1, 1]
+double PerlinNoise(const commontypes::Point& point);
+
+// fractal Brownian motion: the sum of `octaves` of noise, each at twice the frequency and `gain`
+// times the amplitude of the one before, scaled back to within [-1, 1]
+double FractalNoise(const commontypes::Point& point, size_t octaves, double gain = 0.5);
+
+// as above, summing the absolute value of each octave (so within [0, 1]), which gives the creases
+// of e.g. marble
+double Turbulence(const commontypes::Point& point, size_t octaves, double gain = 0.5);
+
+// the noise at each of the `n` points (x[i], y[i], z[i]), written to `out`
+void PerlinNoise(const double* x, const double* y, const double* z, double* out, size_t n);
+
+void FractalNoise(const double* x,
+                  const double* y,
+                  const double* z,
+                  double* out,
+                  size_t n,
+                  size_t octaves,
+                  double gain = 0.5);
+
+void Turbulence(const double* x,
+                const double* y,
+                const double* z,
+                double* out,
+                size_t n,
+                size_t octaves,
+                double gain = 0.5);
+}  // namespace pattern
+
+#endif  // NOISE_H
@@ -25,7 +25,13 @@ class Pattern {
     commontypes::Color PatternAtShape(const commontypes::Matrix& shape_transform,
                                       const commontypes::Point& world_point) const;
 
+    // as above, for a point already in object space; this is how one Pattern (e.g. a
+    // PerturbedPattern) delegates to another
+    commontypes::Color PatternAtObject(const commontypes::Point& object_point) const;
+
    protected:
+    friend class PatternProgram;
+
     // see discussion on this approach on pg. 133; each derived class implements `PatternAt`
     virtual commontypes::Color PatternAt(const commontypes::Point& point) const = 0;
 
@@ -0,0 +1,72 @@
+#ifndef PATTERN_PROGRAM_H
+#define PATTERN_PROGRAM_H
+
+#include <cstdint>
+#include <vector>
+#include "color.h"
+#include "matrix.h"
+#include "pattern.h"
+#include "point.h"
+
+namespace pattern {
+enum class PatternOpcode : uint8_t {
+    kStripe,
+    kGradient,
+    kRing,
+    kChecker,
+    kRadialGradient,
+    kBlend,
+    kVirtual,  // any other Pattern, evaluated through `Pattern::PatternAt`
+};
+
+struct PatternInstruction {
+    static constexpr uint32_t CONSTANT = UINT32_MAX;
+
+    PatternOpcode opcode_;
+    // for each of the two operands, the index of the instruction that gives its color, or
+    // CONSTANT for the color in `colors_`
+    uint32_t operands_[2]{CONSTANT, CONSTANT};
+    commontypes::Color colors_[2];
+    double weight_{0};  // of the second operand, for kBlend
+    // from the object space of the Shape to this instruction's pattern space: the product of the
+    // inverse transforms of the Pattern and each Pattern enclosing it. the bottom row is always
+    // (0, 0, 0, 1)
+    double to_pattern_[3][4];
+    const Pattern* pattern_{nullptr};  // for kVirtual
+};
+
+// a tree of Patterns (e.g. a NestedPattern of BlendPatterns) flattened into an array of
+// instructions, in which each Pattern's transform is multiplied through those enclosing it ahead
+// of time. evaluating it takes no inverse and (other than for kVirtual) no virtual call per
+// Pattern. a program isn't updated when its Patterns change, and refers to (rather than owning)
+// Patterns evaluated through kVirtual
+class PatternProgram {
+   public:
+    static PatternProgram Compile(const Pattern& root);
+
+    // as Pattern::PatternAtShape and Pattern::PatternAtObject, for the root Pattern. unlike
+    // PatternAtShape, this takes the Shape's world-to-object matrix (the inverse of its transform,
+    // e.g. from Shape::WorldToObjectMatrix) rather than inverting the transform per evaluation
+    commontypes::Color ColorAtShape(const commontypes::Matrix& world_to_object,
+                                    const commontypes::Point& world_point) const;
+    commontypes::Color ColorAtObject(const commontypes::Point& object_point) const;
+
+    inline size_t size() const { return instructions_.size(); }
+    inline const PatternInstruction& operator[](const size_t idx) const {
+        return instructions_[idx];
+    }
+
+   private:
+    PatternProgram() = default;
+
+    // appends the instructions for `pattern` (whose enclosing Patterns take object space to
+    // `to_parent`) in pre-order, returning the index of the first
+    uint32_t Append(const Pattern& pattern, const commontypes::Matrix& to_parent);
+
+    commontypes::Color Evaluate(uint32_t idx, const commontypes::Point& object_point) const;
+
+    std::vector<PatternInstruction> instructions_;
+};
+}  // namespace pattern
+
+#endif  // PATTERN_PROGRAM_H
@@ -0,0 +1,37 @@
+#ifndef PATTERN_SELECTION_H
+#define PATTERN_SELECTION_H
+
+#include <cmath>
+#include "point.h"
+
+// the rules by which each kind of pattern chooses between, or blends, its two colors (or
+// sub-patterns) at a point in pattern space; shared by the Patterns and PatternProgram
+namespace pattern {
+// alternates with each unit of x (see pg. 129)
+inline bool StripeSelectsFirst(const commontypes::Point& point) {
+    return fmod(floor(point.x()), 2) == 0;
+}
+
+// alternates with each unit of distance from the y-axis (see pg. 135)
+inline bool RingSelectsFirst(const commontypes::Point& point) {
+    return fmod(floor(sqrt(point.x() * point.x() + point.z() * point.z())), 2) == 0;
+}
+
+// alternates with each unit cube (see pg. 137)
+inline bool CheckerSelectsFirst(const commontypes::Point& point) {
+    return fmod(floor(point.x()) + floor(point.y()) + floor(point.z()), 2) == 0;
+}
+
+// how far from the first color toward the second: repeating along x (see pg. 135)
+inline double GradientFraction(const commontypes::Point& point) {
+    return point.x() - floor(point.x());
+}
+
+// as above, repeating with each unit of distance from the y-axis
+inline double RadialGradientFraction(const commontypes::Point& point) {
+    const double distance = sqrt(point.x() * point.x() + point.z() * point.z());
+    return distance - floor(distance);
+}
+}  // namespace pattern
+
+#endif  // PATTERN_SELECTION_H
@@ -0,0 +1,44 @@
+#ifndef PERTURBED_PATTERN_H
+#define PERTURBED_PATTERN_H
+
+#include <memory>
+#include "color.h"
+#include "pattern.h"
+#include "point.h"
+
+namespace pattern {
+// decorates any Pattern by jittering each point with fractal noise before delegating to it (see
+// the suggestion on pg. 139); a stripe becomes wavy, a checker board looks hand-drawn. the
+// wrapped Pattern's own transform still applies, after this one's
+class PerturbedPattern : public Pattern {
+   public:
+    // each point moves by up to `scale` along each axis; `frequency` is the noise's, so higher
+    // values jitter over shorter distances
+    explicit PerturbedPattern(std::shared_ptr<const Pattern> pattern,
+                              double scale = 0.2,
+                              size_t octaves = 3,
+                              double frequency = 1.0);
+
+    commontypes::Color PatternAt(const commontypes::Point& point) const override;
+
+    // the colors at each of the `n` points (e.g. the hits of a tile's rays, in pattern space),
+    // with the noise evaluated NOISE_BATCH points at a time
+    void PatternsAt(const commontypes::Point* points, commontypes::Color* out, size_t n) const;
+
+    // where each of the `n` points is moved to before the wrapped Pattern is evaluated
+    void Perturb(const commontypes::Point* points, commontypes::Point* out, size_t n) const;
+
+    inline const std::shared_ptr<const Pattern>& pattern() const { return pattern_; }
+    inline double scale() const { return scale_; }
+    inline size_t octaves() const { return octaves_; }
+    inline double frequency() const { return frequency_; }
+
+   private:
+    std::shared_ptr<const Pattern> pattern_;
+    double scale_;
+    size_t octaves_;
+    double frequency_;
+};
+}  // namespace pattern
+
+#endif  // PERTURBED_PATTERN_H
@@ -0,0 +1,32 @@
+#ifndef RADIAL_GRADIENT_PATTERN_H
+#define RADIAL_GRADIENT_PATTERN_H
+
+#include "color.h"
+#include "pattern.h"
+
+namespace pattern {
+// a gradient outward from the y-axis, from the first color to the second, repeating with each
+// unit of distance (i.e. a RingPattern whose rings are blended)
+class RadialGradientPattern : public Pattern {
+   public:
+    RadialGradientPattern()
+        : Pattern(),
+          color_a_(commontypes::Color::MakeWhite()),
+          color_b_(commontypes::Color::MakeBlack()) {}
+
+    RadialGradientPattern(const commontypes::Color& color_a, const commontypes::Color& color_b)
+        : Pattern(), color_a_(color_a), color_b_(color_b) {}
+
+    commontypes::Color PatternAt(const commontypes::Point& point) const override;
+
+    commontypes::Color ColorA() const { return color_a_; }
+
+    commontypes::Color ColorB() const { return color_b_; }
+
+   private:
+    commontypes::Color color_a_;
+    commontypes::Color color_b_;
+};
+}  // namespace pattern
+
+#endif  // RADIAL_GRADIENT_PATTERN_H
@@ -0,0 +1,59 @@
+#ifndef TEXTURE_CACHE_H
+#define TEXTURE_CACHE_H
+
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "imagetexture.h"
+
+namespace pattern {
+// decoded ImageTextures, keyed by the canonical path of their file, so that every Pattern using
+// a file shares a single copy. once the textures held exceed the memory budget, the least
+// recently loaded ones are dropped; a dropped texture lives on for as long as Patterns use it,
+// but is decoded again the next time it's loaded. the texture loaded last is never dropped by
+// `Load`, even if it alone exceeds the budget. all members are thread-safe
+class TextureCache {
+   public:
+    static constexpr size_t DEFAULT_BUDGET = size_t{512} << 20;  // bytes
+
+    explicit TextureCache(size_t budget = DEFAULT_BUDGET) : budget_(budget) {}
+
+    // the cache shared by the whole process (e.g. by SceneLoader)
+    static TextureCache& Global();
+
+    // the texture decoded from the PPM file at `path`, which is only read if it isn't cached.
+    // throws std::runtime_error if the file can't be read, std::invalid_argument if it's
+    // malformed
+    std::shared_ptr<const ImageTexture> Load(const std::filesystem::path& path);
+
+    // drops textures, least recently loaded first, until those held fit within `budget` bytes
+    void SetBudget(size_t budget);
+
+    size_t budget() const;
+    size_t bytes() const;  // held by the cached textures
+    size_t size() const;
+
+    void Clear();
+
+   private:
+    struct Entry {
+        std::shared_ptr<const ImageTexture> texture_;
+        std::list<std::string>::iterator recency_;
+    };
+
+    // drops textures, least recently loaded first, until those held fit within the budget or
+    // only the `n_kept` most recently loaded remain. callers hold `mutex_`
+    void EvictToBudget(size_t n_kept);
+
+    mutable std::mutex mutex_;
+    size_t budget_;
+    size_t bytes_{0};
+    std::list<std::string> recency_;  // keys, most recently loaded first
+    std::unordered_map<std::string, Entry> entries_;
+};
+}  // namespace pattern
+
+#endif  // TEXTURE_CACHE_H
@@ -0,0 +1,35 @@
+#ifndef TEXTURE_MAP_PATTERN_H
+#define TEXTURE_MAP_PATTERN_H
+
+#include <memory>
+#include <utility>
+#include "color.h"
+#include "imagetexture.h"
+#include "pattern.h"
+#include "uvmapping.h"
+
+namespace pattern {
+// an ImageTexture wrapped onto a Shape by a UVMapping. there's no per-hit measure of how many
+// texels a pixel covers, so the mip level is chosen per Pattern (e.g. a coarser one for a
+// texture that's tiled many times across a distant floor)
+class TextureMapPattern : public Pattern {
+   public:
+    TextureMapPattern(std::shared_ptr<const ImageTexture> texture,
+                      const UVMapping mapping,
+                      const size_t mip_level = 0)
+        : Pattern(), texture_(std::move(texture)), mapping_(mapping), mip_level_(mip_level) {}
+
+    commontypes::Color PatternAt(const commontypes::Point& point) const override;
+
+    inline const std::shared_ptr<const ImageTexture>& texture() const { return texture_; }
+    inline UVMapping mapping() const { return mapping_; }
+    inline size_t mip_level() const { return mip_level_; }
+
+   private:
+    std::shared_ptr<const ImageTexture> texture_;
+    UVMapping mapping_;
+    size_t mip_level_;
+};
+}  // namespace pattern
+
+#endif  // TEXTURE_MAP_PATTERN_H
@@ -0,0 +1,32 @@
+#ifndef UV_MAPPING_H
+#define UV_MAPPING_H
+
+#include "point.h"
+
+namespace pattern {
+// a position on a 2D texture, with v increasing upward. both coordinates are in [0, 1]; those that
+// wrap around a Shape (or tile it) are in [0, 1)
+struct UV {
+    double u_;
+    double v_;
+};
+
+// how a point on a Shape (in pattern space) is mapped onto a texture
+enum class UVMapping { kSpherical, kPlanar, kCylindrical, kCubic };
+
+// for the unit sphere; u wraps once around the y-axis, and v runs from the south pole to the north
+UV SphericalMap(const commontypes::Point& point);
+
+// the xz-plane, tiled with a copy of the texture in each unit square
+UV PlanarMap(const commontypes::Point& point);
+
+// for the unit cylinder; u wraps once around the y-axis, and v repeats every unit of y
+UV CylindricalMap(const commontypes::Point& point);
+
+// for the unit cube; each face is mapped to the whole texture, reaching 1 at its edges
+UV CubicMap(const commontypes::Point& point);
+
+UV MapToUV(UVMapping mapping, const commontypes::Point& point);
+}  // namespace pattern
+
+#endif  // UV_MAPPING_H
@@ -0,0 +1,23 @@
+#include "blendpattern.h"
+#include <stdexcept>
+#include <utility>
+
+pattern::BlendPattern::BlendPattern(std::shared_ptr<const Pattern> pattern_a,
+                                    std::shared_ptr<const Pattern> pattern_b,
+                                    const double weight)
+    : Pattern(),
+      pattern_a_(std::move(pattern_a)),
+      pattern_b_(std::move(pattern_b)),
+      weight_(weight) {
+    if (!pattern_a_ || !pattern_b_) {
+        throw std::invalid_argument("a BlendPattern needs two patterns");
+    }
+    if (weight_ < 0 || weight_ > 1) {
+        throw std::invalid_argument("a BlendPattern's weight must be within [0, 1]");
+    }
+}
+
+commontypes::Color pattern::BlendPattern::PatternAt(const commontypes::Point& point) const {
+    return commontypes::Color{pattern_a_->PatternAtObject(point) * (1 - weight_) +
+                              pattern_b_->PatternAtObject(point) * weight_};
+}
@@ -1,11 +1,10 @@
 #include "checkerpattern.h"
-#include <cmath>
+#include "patternselection.h"
 
 commontypes::Color pattern::CheckerPattern::PatternAt(const commontypes::Point& point) const {
     // see pg. 137
-    const double sum_floors = floor(point.x()) + floor(point.y()) + floor(point.z());
-    if (fmod(sum_floors, 2) == 0) {
+    if (CheckerSelectsFirst(point)) {
         return color_a_;
     }
     return color_b_;
-}
\ No newline at end of file
+}
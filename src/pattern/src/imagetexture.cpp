@@ -0,0 +1,205 @@
+#include "imagetexture.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+pattern::ImageTexture::Level::Level(const size_t width, const size_t height)
+    : width_(width), height_(height), tiles_across_((width + TILE_SIZE - 1) / TILE_SIZE) {
+    const size_t tiles_down = (height + TILE_SIZE - 1) / TILE_SIZE;
+    texels_.resize(tiles_across_ * tiles_down * TILE_SIZE * TILE_SIZE * 3);
+}
+
+size_t pattern::ImageTexture::Level::Offset(const size_t x, const size_t y) const {
+    const size_t tile = (y / TILE_SIZE) * tiles_across_ + x / TILE_SIZE;
+    const size_t within_tile = (y % TILE_SIZE) * TILE_SIZE + x % TILE_SIZE;
+    return (tile * TILE_SIZE * TILE_SIZE + within_tile) * 3;
+}
+
+pattern::ImageTexture::ImageTexture(const size_t width,
+                                    const size_t height,
+                                    const std::vector<commontypes::Color>& pixels) {
+    if (width == 0 || height == 0 || pixels.size() != width * height) {
+        throw std::invalid_argument("an image texture needs one pixel per texel");
+    }
+
+    Level& base = levels_.emplace_back(width, height);
+    for (size_t y = 0; y < height; ++y) {
+        for (size_t x = 0; x < width; ++x) {
+            const commontypes::Color& pixel = pixels[y * width + x];
+            float* texel = &base.texels_[base.Offset(x, y)];
+            texel[0] = static_cast<float>(pixel.Red());
+            texel[1] = static_cast<float>(pixel.Green());
+            texel[2] = static_cast<float>(pixel.Blue());
+        }
+    }
+
+    // each mip texel is the average of the (up to) 2x2 texels it covers in the level above
+    while (levels_.back().width_ > 1 || levels_.back().height_ > 1) {
+        const Level& above = levels_.back();
+        Level level{std::max<size_t>(above.width_ / 2, 1), std::max<size_t>(above.height_ / 2, 1)};
+        for (size_t y = 0; y < level.height_; ++y) {
+            for (size_t x = 0; x < level.width_; ++x) {
+                const size_t x0 = std::min(2 * x, above.width_ - 1);
+                const size_t x1 = std::min(2 * x + 1, above.width_ - 1);
+                const size_t y0 = std::min(2 * y, above.height_ - 1);
+                const size_t y1 = std::min(2 * y + 1, above.height_ - 1);
+                float* texel = &level.texels_[level.Offset(x, y)];
+                for (size_t channel = 0; channel < 3; ++channel) {
+                    texel[channel] = (above.texels_[above.Offset(x0, y0) + channel] +
+                                      above.texels_[above.Offset(x1, y0) + channel] +
+                                      above.texels_[above.Offset(x0, y1) + channel] +
+                                      above.texels_[above.Offset(x1, y1) + channel]) /
+                                     4;
+                }
+            }
+        }
+        levels_.push_back(std::move(level));
+    }
+}
+
+namespace {
+// reads the PPM header's fields and the pixels of a P3 image, skipping whitespace and comments
+class PPMReader {
+   public:
+    explicit PPMReader(const std::string_view text) : text_(text) {}
+
+    std::string_view NextToken() {
+        while (pos_ < text_.size()) {
+            if (text_[pos_] == '#') {
+                while (pos_ < text_.size() && text_[pos_] != '\n') {
+                    ++pos_;
+                }
+            } else if (std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+                ++pos_;
+            } else {
+                break;
+            }
+        }
+        const size_t start = pos_;
+        while (pos_ < text_.size() && !std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+            ++pos_;
+        }
+        return text_.substr(start, pos_ - start);
+    }
+
+    size_t NextNumber() {
+        const std::string_view token = NextToken();
+        const auto is_digit = [](const char c) { return std::isdigit(c) != 0; };
+        if (token.empty() || !std::all_of(token.begin(), token.end(), is_digit)) {
+            throw std::invalid_argument("malformed PPM: expected a number, got '" +
+                                        std::string{token} + "'");
+        }
+        return std::stoul(std::string{token});
+    }
+
+    // the binary pixels start after the single whitespace character ending the header
+    std::string_view BinaryData() const {
+        return pos_ < text_.size() ? text_.substr(pos_ + 1) : std::string_view{};
+    }
+
+   private:
+    std::string_view text_;
+    size_t pos_{0};
+};
+}  // namespace
+
+pattern::ImageTexture pattern::ImageTexture::FromPPM(const std::string_view ppm) {
+    PPMReader reader{ppm};
+    const std::string_view magic = reader.NextToken();
+    if (magic != "P3" && magic != "P6") {
+        throw std::invalid_argument("not a PPM image");
+    }
+
+    const size_t width = reader.NextNumber();
+    const size_t height = reader.NextNumber();
+    const size_t max_value = reader.NextNumber();
+    if (width == 0 || height == 0 || max_value == 0 || max_value > 255) {
+        throw std::invalid_argument("unsupported PPM dimensions or maximum value");
+    }
+
+    const auto scale = static_cast<double>(max_value);
+    std::vector<commontypes::Color> pixels{};
+    pixels.reserve(width * height);
+    if (magic == "P3") {
+        for (size_t i = 0; i < width * height; ++i) {
+            const double r = static_cast<double>(reader.NextNumber()) / scale;
+            const double g = static_cast<double>(reader.NextNumber()) / scale;
+            const double b = static_cast<double>(reader.NextNumber()) / scale;
+            pixels.emplace_back(r, g, b);
+        }
+    } else {
+        const std::string_view data = reader.BinaryData();
+        if (data.size() < width * height * 3) {
+            throw std::invalid_argument("malformed PPM: too few pixels");
+        }
+        const auto channel = [&data, scale](const size_t i) {
+            return static_cast<double>(static_cast<unsigned char>(data[i])) / scale;
+        };
+        for (size_t i = 0; i < width * height; ++i) {
+            pixels.emplace_back(channel(3 * i), channel(3 * i + 1), channel(3 * i + 2));
+        }
+    }
+
+    return ImageTexture{width, height, pixels};
+}
+
+size_t pattern::ImageTexture::bytes() const {
+    size_t bytes = 0;
+    for (const auto& level : levels_) {
+        bytes += level.texels_.size() * sizeof(float);
+    }
+    return bytes;
+}
+
+commontypes::Color pattern::ImageTexture::Texel(const size_t x,
+                                                const size_t y,
+                                                const size_t level) const {
+    const Level& mip = levels_[std::min(level, levels_.size() - 1)];
+    const float* texel = &mip.texels_[mip.Offset(x, y)];
+    return commontypes::Color{texel[0], texel[1], texel[2]};
+}
+
+commontypes::Color pattern::ImageTexture::ColorAt(const double u,
+                                                  const double v,
+                                                  const size_t level,
+                                                  const TextureWrap wrap_u,
+                                                  const TextureWrap wrap_v) const {
+    const size_t clamped_level = std::min(level, levels_.size() - 1);
+    const Level& mip = levels_[clamped_level];
+    const auto width = static_cast<double>(mip.width_);
+    const auto height = static_cast<double>(mip.height_);
+
+    // a coordinate within [0, 1), or [0, 1] if clamped, and the index of a texel within `n`
+    const auto coordinate = [](const double c, const TextureWrap wrap) {
+        return wrap == TextureWrap::kClamp ? std::clamp(c, 0.0, 1.0) : c - floor(c);
+    };
+    const auto index = [](const double i, const size_t n, const TextureWrap wrap) {
+        if (wrap == TextureWrap::kClamp) {
+            return static_cast<size_t>(std::clamp(i, 0.0, static_cast<double>(n - 1)));
+        }
+        const auto wrapped = static_cast<long>(i) % static_cast<long>(n);
+        return static_cast<size_t>(wrapped < 0 ? wrapped + static_cast<long>(n) : wrapped);
+    };
+
+    // texel centers are at half-integer coordinates; the row is flipped so that v = 0 is at the
+    // bottom
+    const double x = coordinate(u, wrap_u) * width - 0.5;
+    const double y = (1 - coordinate(v, wrap_v)) * height - 0.5;
+    const double x_floor = floor(x);
+    const double y_floor = floor(y);
+    const double fx = x - x_floor;
+    const double fy = y - y_floor;
+
+    const size_t x0 = index(x_floor, mip.width_, wrap_u);
+    const size_t x1 = index(x_floor + 1, mip.width_, wrap_u);
+    const size_t y0 = index(y_floor, mip.height_, wrap_v);
+    const size_t y1 = index(y_floor + 1, mip.height_, wrap_v);
+
+    const commontypes::Color top{Texel(x0, y0, clamped_level) * (1 - fx) +
+                                 Texel(x1, y0, clamped_level) * fx};
+    const commontypes::Color bottom{Texel(x0, y1, clamped_level) * (1 - fx) +
+                                    Texel(x1, y1, clamped_level) * fx};
+    return commontypes::Color{top * (1 - fy) + bottom * fy};
+}
@@ -0,0 +1,35 @@
+#include "nestedpattern.h"
+#include <stdexcept>
+#include <utility>
+#include "patternselection.h"
+
+pattern::NestedPattern::NestedPattern(const Kind kind,
+                                      std::shared_ptr<const Pattern> pattern_a,
+                                      std::shared_ptr<const Pattern> pattern_b)
+    : Pattern(), kind_(kind), pattern_a_(std::move(pattern_a)), pattern_b_(std::move(pattern_b)) {
+    if (!pattern_a_ || !pattern_b_) {
+        throw std::invalid_argument("a NestedPattern needs two patterns");
+    }
+}
+
+commontypes::Color pattern::NestedPattern::PatternAt(const commontypes::Point& point) const {
+    const auto blend = [this, &point](const double fraction) {
+        const commontypes::Color a = pattern_a_->PatternAtObject(point);
+        const commontypes::Color b = pattern_b_->PatternAtObject(point);
+        return commontypes::Color{a + (b - a) * fraction};
+    };
+
+    switch (kind_) {
+        case Kind::kStripe:
+            return (StripeSelectsFirst(point) ? pattern_a_ : pattern_b_)->PatternAtObject(point);
+        case Kind::kRing:
+            return (RingSelectsFirst(point) ? pattern_a_ : pattern_b_)->PatternAtObject(point);
+        case Kind::kChecker:
+            return (CheckerSelectsFirst(point) ? pattern_a_ : pattern_b_)->PatternAtObject(point);
+        case Kind::kGradient:
+            return blend(GradientFraction(point));
+        case Kind::kRadialGradient:
+            return blend(RadialGradientFraction(point));
+    }
+    return commontypes::Color::MakeBlack();
+}
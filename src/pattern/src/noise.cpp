@@ -0,0 +1,225 @@
+#include "noise.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+namespace {
+// Ken Perlin's reference permutation, repeated so that hashes of neighboring cells needn't wrap
+constexpr std::array<uint8_t, 256> PERMUTATION{
+    151, 160, 137, 91,  90,  15,  131, 13,  201, 95,  96,  53,  194, 233, 7,   225, 140, 36,
+    103, 30,  69,  142, 8,   99,  37,  240, 21,  10,  23,  190, 6,   148, 247, 120, 234, 75,
+    0,   26,  197, 62,  94,  252, 219, 203, 117, 35,  11,  32,  57,  177, 33,  88,  237, 149,
+    56,  87,  174, 20,  125, 136, 171, 168, 68,  175, 74,  165, 71,  134, 139, 48,  27,  166,
+    77,  146, 158, 231, 83,  111, 229, 122, 60,  211, 133, 230, 220, 105, 92,  41,  55,  46,
+    245, 40,  244, 102, 143, 54,  65,  25,  63,  161, 1,   216, 80,  73,  209, 76,  132, 187,
+    208, 89,  18,  169, 200, 196, 135, 130, 116, 188, 159, 86,  164, 100, 109, 198, 173, 186,
+    3,   64,  52,  217, 226, 250, 124, 123, 5,   202, 38,  147, 118, 126, 255, 82,  85,  212,
+    207, 206, 59,  227, 47,  16,  58,  17,  182, 189, 28,  42,  223, 183, 170, 213, 119, 248,
+    152, 2,   44,  154, 163, 70,  221, 153, 101, 155, 167, 43,  172, 9,   129, 22,  39,  253,
+    19,  98,  108, 110, 79,  113, 224, 232, 178, 185, 112, 104, 218, 246, 97,  228, 251, 34,
+    242, 193, 238, 210, 144, 12,  191, 179, 162, 241, 81,  51,  145, 235, 249, 14,  239, 107,
+    49,  192, 214, 31,  181, 199, 106, 157, 184, 84,  204, 176, 115, 121, 50,  45,  127, 4,
+    150, 254, 138, 236, 205, 93,  222, 114, 67,  29,  24,  72,  243, 141, 128, 195, 78,  66,
+    215, 61,  156, 180};
+
+constexpr std::array<int32_t, 512> MakeDoubledPermutation() {
+    std::array<int32_t, 512> p{};
+    for (size_t i = 0; i < 512; ++i) {
+        p[i] = PERMUTATION[i % 256];
+    }
+    return p;
+}
+constexpr std::array<int32_t, 512> P = MakeDoubledPermutation();
+
+// 6t^5 - 15t^4 + 10t^3, whose first and second derivatives are 0 at t = 0 and t = 1
+inline double Fade(const double t) {
+    return t * t * t * (t * (t * 6 - 15) + 10);
+}
+
+inline double Lerp(const double t, const double a, const double b) {
+    return a + t * (b - a);
+}
+
+// the dot product of (x, y, z) with one of 12 gradients (the edges of a cube) chosen by `hash`;
+// written with selects rather than branches so that it vectorizes
+inline double Grad(const int32_t hash, const double x, const double y, const double z) {
+    const int32_t h = hash & 15;
+    const double u = h < 8 ? x : y;
+    const double v = h < 4 ? y : (h == 12 || h == 14 ? x : z);
+    return ((h & 1) == 0 ? u : -u) + ((h & 2) == 0 ? v : -v);
+}
+
+// the index, among the 256 that repeat, of the cell whose lowest corner is at `floor`. it's
+// reduced before the cast, which is undefined for values beyond int32_t's range, and a non-finite
+// coordinate takes cell 0 (its noise is then NaN, as its position within the cell is)
+int32_t CellIndex(const double floor) {
+    const double wrapped = std::fmod(floor, 256.0);
+    return std::isfinite(wrapped) ? static_cast<int32_t>(wrapped) & 255 : 0;
+}
+
+// noise for up to NOISE_BATCH points
+void PerlinNoiseBatch(const double* x, const double* y, const double* z, double* out, size_t n) {
+    int32_t xi[pattern::NOISE_BATCH];
+    int32_t yi[pattern::NOISE_BATCH];
+    int32_t zi[pattern::NOISE_BATCH];
+    double xf[pattern::NOISE_BATCH];
+    double yf[pattern::NOISE_BATCH];
+    double zf[pattern::NOISE_BATCH];
+
+    // each point's unit cell, and the point's position within it
+    for (size_t i = 0; i < n; ++i) {
+        const double x_floor = std::floor(x[i]);
+        const double y_floor = std::floor(y[i]);
+        const double z_floor = std::floor(z[i]);
+        xi[i] = CellIndex(x_floor);
+        yi[i] = CellIndex(y_floor);
+        zi[i] = CellIndex(z_floor);
+        xf[i] = x[i] - x_floor;
+        yf[i] = y[i] - y_floor;
+        zf[i] = z[i] - z_floor;
+    }
+
+    // the hashes of the cell's 8 corners
+    int32_t aa[pattern::NOISE_BATCH];
+    int32_t ab[pattern::NOISE_BATCH];
+    int32_t ba[pattern::NOISE_BATCH];
+    int32_t bb[pattern::NOISE_BATCH];
+    for (size_t i = 0; i < n; ++i) {
+        const int32_t a = P[xi[i]] + yi[i];
+        const int32_t b = P[xi[i] + 1] + yi[i];
+        aa[i] = P[a] + zi[i];
+        ab[i] = P[a + 1] + zi[i];
+        ba[i] = P[b] + zi[i];
+        bb[i] = P[b + 1] + zi[i];
+    }
+
+    // the corners' gradients, blended trilinearly by the faded position
+    for (size_t i = 0; i < n; ++i) {
+        const double u = Fade(xf[i]);
+        const double v = Fade(yf[i]);
+        const double w = Fade(zf[i]);
+        const double x1 = xf[i] - 1;
+        const double y1 = yf[i] - 1;
+        const double z1 = zf[i] - 1;
+        const double g000 = Grad(P[aa[i]], xf[i], yf[i], zf[i]);
+        const double g100 = Grad(P[ba[i]], x1, yf[i], zf[i]);
+        const double g010 = Grad(P[ab[i]], xf[i], y1, zf[i]);
+        const double g110 = Grad(P[bb[i]], x1, y1, zf[i]);
+        const double g001 = Grad(P[aa[i] + 1], xf[i], yf[i], z1);
+        const double g101 = Grad(P[ba[i] + 1], x1, yf[i], z1);
+        const double g011 = Grad(P[ab[i] + 1], xf[i], y1, z1);
+        const double g111 = Grad(P[bb[i] + 1], x1, y1, z1);
+        const double near_z = Lerp(v, Lerp(u, g000, g100), Lerp(u, g010, g110));
+        const double far_z = Lerp(v, Lerp(u, g001, g101), Lerp(u, g011, g111));
+        out[i] = Lerp(w, near_z, far_z);
+    }
+}
+
+// sums octaves of noise (or of its absolute value) for up to NOISE_BATCH points
+template <bool ABSOLUTE>
+void OctavesBatch(const double* x,
+                  const double* y,
+                  const double* z,
+                  double* out,
+                  const size_t n,
+                  const size_t octaves,
+                  const double gain) {
+    double xs[pattern::NOISE_BATCH];
+    double ys[pattern::NOISE_BATCH];
+    double zs[pattern::NOISE_BATCH];
+    double noise[pattern::NOISE_BATCH];
+    std::fill(out, out + n, 0.0);
+
+    double frequency = 1.0;
+    double amplitude = 1.0;
+    double total_amplitude = 0.0;
+    for (size_t octave = 0; octave < octaves; ++octave) {
+        for (size_t i = 0; i < n; ++i) {
+            xs[i] = x[i] * frequency;
+            ys[i] = y[i] * frequency;
+            zs[i] = z[i] * frequency;
+        }
+        PerlinNoiseBatch(xs, ys, zs, noise, n);
+        for (size_t i = 0; i < n; ++i) {
+            out[i] += amplitude * (ABSOLUTE ? std::fabs(noise[i]) : noise[i]);
+        }
+        total_amplitude += amplitude;
+        frequency *= 2;
+        amplitude *= gain;
+    }
+
+    if (total_amplitude > 0) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] /= total_amplitude;
+        }
+    }
+}
+}  // namespace
+
+void pattern::PerlinNoise(const double* x,
+                          const double* y,
+                          const double* z,
+                          double* out,
+                          const size_t n) {
+    for (size_t i = 0; i < n; i += NOISE_BATCH) {
+        PerlinNoiseBatch(x + i, y + i, z + i, out + i, std::min(NOISE_BATCH, n - i));
+    }
+}
+
+void pattern::FractalNoise(const double* x,
+                           const double* y,
+                           const double* z,
+                           double* out,
+                           const size_t n,
+                           const size_t octaves,
+                           const double gain) {
+    for (size_t i = 0; i < n; i += NOISE_BATCH) {
+        OctavesBatch<false>(x + i, y + i, z + i, out + i, std::min(NOISE_BATCH, n - i), octaves,
+                            gain);
+    }
+}
+
+void pattern::Turbulence(const double* x,
+                         const double* y,
+                         const double* z,
+                         double* out,
+                         const size_t n,
+                         const size_t octaves,
+                         const double gain) {
+    for (size_t i = 0; i < n; i += NOISE_BATCH) {
+        OctavesBatch<true>(x + i, y + i, z + i, out + i, std::min(NOISE_BATCH, n - i), octaves,
+                           gain);
+    }
+}
+
+double pattern::PerlinNoise(const commontypes::Point& point) {
+    const double x = point.x();
+    const double y = point.y();
+    const double z = point.z();
+    double out;
+    PerlinNoise(&x, &y, &z, &out, 1);
+    return out;
+}
+
+double pattern::FractalNoise(const commontypes::Point& point,
+                             const size_t octaves,
+                             const double gain) {
+    const double x = point.x();
+    const double y = point.y();
+    const double z = point.z();
+    double out;
+    FractalNoise(&x, &y, &z, &out, 1, octaves, gain);
+    return out;
+}
+
+double pattern::Turbulence(const commontypes::Point& point,
+                           const size_t octaves,
+                           const double gain) {
+    const double x = point.x();
+    const double y = point.y();
+    const double z = point.z();
+    double out;
+    Turbulence(&x, &y, &z, &out, 1, octaves, gain);
+    return out;
+}
@@ -1,7 +1,10 @@
 #include "pattern.h"
+#include "instrumentation.h"
 
 commontypes::Color pattern::Pattern::PatternAtShape(const commontypes::Matrix& shape_transform,
                                                     const commontypes::Point& world_point) const {
+    INSTRUMENT_PHASE(kPatternAtShape);
+
     // this is the implementation of the initial approach outlined on pg. 132, and
     // revised by the approach on pg. 133
 
@@ -9,6 +12,11 @@ commontypes::Color pattern::Pattern::PatternAtShape(const commontypes::Matrix& s
     const commontypes::Point object_point =
         commontypes::Point{shape_transform.Inverse() * world_point};
 
+    return PatternAtObject(object_point);
+}
+
+commontypes::Color pattern::Pattern::PatternAtObject(
+    const commontypes::Point& object_point) const {
     // object-space-point * inverse of pattern's transformation matrix to convert point to pattern
     // space
     const commontypes::Point pattern_point =
@@ -0,0 +1,143 @@
+#include "patternprogram.h"
+#include "blendpattern.h"
+#include "checkerpattern.h"
+#include "gradientpattern.h"
+#include "identitymatrix.h"
+#include "instrumentation.h"
+#include "nestedpattern.h"
+#include "patternselection.h"
+#include "radialgradientpattern.h"
+#include "ringpattern.h"
+#include "stripepattern.h"
+
+pattern::PatternProgram pattern::PatternProgram::Compile(const Pattern& root) {
+    PatternProgram program{};
+    program.Append(root, commontypes::IdentityMatrix{});
+    return program;
+}
+
+uint32_t pattern::PatternProgram::Append(const Pattern& pattern,
+                                         const commontypes::Matrix& to_parent) {
+    const commontypes::Matrix to_pattern = pattern.GetPatternTransform().Inverse() * to_parent;
+
+    const auto idx = static_cast<uint32_t>(instructions_.size());
+    PatternInstruction instruction{};
+    for (size_t row = 0; row < 3; ++row) {
+        for (size_t column = 0; column < 4; ++column) {
+            instruction.to_pattern_[row][column] = to_pattern.GetElement(row, column);
+        }
+    }
+
+    // the two colors of the simple Patterns
+    const auto with_colors = [&instruction](const PatternOpcode opcode, const auto& simple) {
+        instruction.opcode_ = opcode;
+        instruction.colors_[0] = simple.ColorA();
+        instruction.colors_[1] = simple.ColorB();
+    };
+
+    const Pattern* sub_patterns[2] = {nullptr, nullptr};
+    if (const auto* stripe = dynamic_cast<const StripePattern*>(&pattern)) {
+        with_colors(PatternOpcode::kStripe, *stripe);
+    } else if (const auto* gradient = dynamic_cast<const GradientPattern*>(&pattern)) {
+        with_colors(PatternOpcode::kGradient, *gradient);
+    } else if (const auto* ring = dynamic_cast<const RingPattern*>(&pattern)) {
+        with_colors(PatternOpcode::kRing, *ring);
+    } else if (const auto* checker = dynamic_cast<const CheckerPattern*>(&pattern)) {
+        with_colors(PatternOpcode::kChecker, *checker);
+    } else if (const auto* radial = dynamic_cast<const RadialGradientPattern*>(&pattern)) {
+        with_colors(PatternOpcode::kRadialGradient, *radial);
+    } else if (const auto* blend = dynamic_cast<const BlendPattern*>(&pattern)) {
+        instruction.opcode_ = PatternOpcode::kBlend;
+        instruction.weight_ = blend->weight();
+        sub_patterns[0] = blend->PatternA().get();
+        sub_patterns[1] = blend->PatternB().get();
+    } else if (const auto* nested = dynamic_cast<const NestedPattern*>(&pattern)) {
+        switch (nested->kind()) {
+            case NestedPattern::Kind::kStripe:
+                instruction.opcode_ = PatternOpcode::kStripe;
+                break;
+            case NestedPattern::Kind::kGradient:
+                instruction.opcode_ = PatternOpcode::kGradient;
+                break;
+            case NestedPattern::Kind::kRing:
+                instruction.opcode_ = PatternOpcode::kRing;
+                break;
+            case NestedPattern::Kind::kChecker:
+                instruction.opcode_ = PatternOpcode::kChecker;
+                break;
+            case NestedPattern::Kind::kRadialGradient:
+                instruction.opcode_ = PatternOpcode::kRadialGradient;
+                break;
+        }
+        sub_patterns[0] = nested->PatternA().get();
+        sub_patterns[1] = nested->PatternB().get();
+    } else {
+        instruction.opcode_ = PatternOpcode::kVirtual;
+        instruction.pattern_ = &pattern;
+    }
+    instructions_.push_back(instruction);
+
+    // the sub-patterns follow their parent (instructions_ may be reallocated meanwhile)
+    for (size_t operand = 0; operand < 2; ++operand) {
+        if (sub_patterns[operand] != nullptr) {
+            const uint32_t sub_idx = Append(*sub_patterns[operand], to_pattern);
+            instructions_[idx].operands_[operand] = sub_idx;
+        }
+    }
+
+    return idx;
+}
+
+commontypes::Color pattern::PatternProgram::ColorAtShape(
+    const commontypes::Matrix& world_to_object,
+    const commontypes::Point& world_point) const {
+    INSTRUMENT_PHASE(kPatternAtShape);
+    return Evaluate(0, commontypes::Point{world_to_object * world_point});
+}
+
+commontypes::Color pattern::PatternProgram::ColorAtObject(
+    const commontypes::Point& object_point) const {
+    return Evaluate(0, object_point);
+}
+
+commontypes::Color pattern::PatternProgram::Evaluate(
+    const uint32_t idx,
+    const commontypes::Point& object_point) const {
+    const PatternInstruction& instruction = instructions_[idx];
+    const double(&m)[3][4] = instruction.to_pattern_;
+    const double x = object_point.x();
+    const double y = object_point.y();
+    const double z = object_point.z();
+    const commontypes::Point point{m[0][0] * x + m[0][1] * y + m[0][2] * z + m[0][3],
+                                   m[1][0] * x + m[1][1] * y + m[1][2] * z + m[1][3],
+                                   m[2][0] * x + m[2][1] * y + m[2][2] * z + m[2][3]};
+
+    const auto operand = [this, &instruction, &object_point](const size_t i) {
+        const uint32_t operand_idx = instruction.operands_[i];
+        return operand_idx == PatternInstruction::CONSTANT ? instruction.colors_[i]
+                                                           : Evaluate(operand_idx, object_point);
+    };
+    const auto blend = [&operand](const double fraction) {
+        const commontypes::Color a = operand(0);
+        const commontypes::Color b = operand(1);
+        return commontypes::Color{a + (b - a) * fraction};
+    };
+
+    switch (instruction.opcode_) {
+        case PatternOpcode::kStripe:
+            return operand(StripeSelectsFirst(point) ? 0 : 1);
+        case PatternOpcode::kRing:
+            return operand(RingSelectsFirst(point) ? 0 : 1);
+        case PatternOpcode::kChecker:
+            return operand(CheckerSelectsFirst(point) ? 0 : 1);
+        case PatternOpcode::kGradient:
+            return blend(GradientFraction(point));
+        case PatternOpcode::kRadialGradient:
+            return blend(RadialGradientFraction(point));
+        case PatternOpcode::kBlend:
+            return blend(instruction.weight_);
+        case PatternOpcode::kVirtual:
+            return instruction.pattern_->PatternAt(point);
+    }
+    return commontypes::Color::MakeBlack();
+}
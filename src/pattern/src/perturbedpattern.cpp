@@ -0,0 +1,71 @@
+#include "perturbedpattern.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include "noise.h"
+
+pattern::PerturbedPattern::PerturbedPattern(std::shared_ptr<const Pattern> pattern,
+                                            const double scale,
+                                            const size_t octaves,
+                                            const double frequency)
+    : Pattern(),
+      pattern_(std::move(pattern)),
+      scale_(scale),
+      octaves_(octaves),
+      frequency_(frequency) {
+    if (!pattern_) {
+        throw std::invalid_argument("a PerturbedPattern needs a pattern to perturb");
+    }
+}
+
+void pattern::PerturbedPattern::Perturb(const commontypes::Point* points,
+                                        commontypes::Point* out,
+                                        const size_t n) const {
+    // the offset along each axis is the noise at a point displaced by a different amount, so
+    // that the three are uncorrelated; all three are evaluated as a single batch
+    constexpr double AXIS_SHIFT[3][3] = {{0, 0, 0}, {31.4, 7.7, 19.3}, {5.9, 43.1, 11.8}};
+    constexpr size_t N = 3 * NOISE_BATCH;
+    double x[N];
+    double y[N];
+    double z[N];
+    double noise[N];
+
+    for (size_t start = 0; start < n; start += NOISE_BATCH) {
+        const size_t count = std::min(NOISE_BATCH, n - start);
+        for (size_t axis = 0; axis < 3; ++axis) {
+            for (size_t i = 0; i < count; ++i) {
+                const commontypes::Point& point = points[start + i];
+                x[axis * count + i] = point.x() * frequency_ + AXIS_SHIFT[axis][0];
+                y[axis * count + i] = point.y() * frequency_ + AXIS_SHIFT[axis][1];
+                z[axis * count + i] = point.z() * frequency_ + AXIS_SHIFT[axis][2];
+            }
+        }
+        FractalNoise(x, y, z, noise, 3 * count, octaves_);
+
+        for (size_t i = 0; i < count; ++i) {
+            const commontypes::Point& point = points[start + i];
+            out[start + i] = commontypes::Point{point.x() + noise[i] * scale_,
+                                                point.y() + noise[count + i] * scale_,
+                                                point.z() + noise[2 * count + i] * scale_};
+        }
+    }
+}
+
+commontypes::Color pattern::PerturbedPattern::PatternAt(const commontypes::Point& point) const {
+    commontypes::Point perturbed{};
+    Perturb(&point, &perturbed, 1);
+    return pattern_->PatternAtObject(perturbed);
+}
+
+void pattern::PerturbedPattern::PatternsAt(const commontypes::Point* points,
+                                           commontypes::Color* out,
+                                           const size_t n) const {
+    commontypes::Point perturbed[NOISE_BATCH];
+    for (size_t start = 0; start < n; start += NOISE_BATCH) {
+        const size_t count = std::min(NOISE_BATCH, n - start);
+        Perturb(points + start, perturbed, count);
+        for (size_t i = 0; i < count; ++i) {
+            out[start + i] = pattern_->PatternAtObject(perturbed[i]);
+        }
+    }
+}
@@ -0,0 +1,8 @@
+#include "radialgradientpattern.h"
+#include "patternselection.h"
+
+commontypes::Color pattern::RadialGradientPattern::PatternAt(
+    const commontypes::Point& point) const {
+    const commontypes::Color distance = commontypes::Color{color_b_ - color_a_};
+    return commontypes::Color{color_a_ + distance * RadialGradientFraction(point)};
+}
@@ -1,16 +1,12 @@
 #include "ringpattern.h"
-#include <cmath>
 #include "color.h"
+#include "patternselection.h"
 
 // tests the distance of the point in both X and Z (see pg. 135)
 commontypes::Color pattern::RingPattern::PatternAt(const commontypes::Point& point) const {
-    const double x_sq = pow(point.x(), 2);
-    const double z_sq = pow(point.z(), 2);
-    const double sum_squared = sqrt(x_sq + z_sq);
-
-    if (fmod(floor(sum_squared), 2) == 0) {
+    if (RingSelectsFirst(point)) {
         return color_a_;
     }
 
     return color_b_;
-}
\ No newline at end of file
+}
@@ -0,0 +1,75 @@
+#include "texturecache.h"
+#include <fstream>
+#include <stdexcept>
+
+pattern::TextureCache& pattern::TextureCache::Global() {
+    static TextureCache cache{};
+    return cache;
+}
+
+std::shared_ptr<const pattern::ImageTexture> pattern::TextureCache::Load(
+    const std::filesystem::path& path) {
+    std::error_code error{};
+    const std::filesystem::path canonical = std::filesystem::weakly_canonical(path, error);
+    const std::string key = error ? path.string() : canonical.string();
+
+    // textures are decoded while holding the lock, so that each is decoded only once
+    std::lock_guard<std::mutex> lock{mutex_};
+    if (const auto it = entries_.find(key); it != entries_.end()) {
+        recency_.splice(recency_.begin(), recency_, it->second.recency_);
+        return it->second.texture_;
+    }
+
+    std::ifstream in{path, std::ios::binary};
+    if (!in) {
+        throw std::runtime_error("unable to open texture " + path.string());
+    }
+    const std::string ppm{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+    auto texture = std::make_shared<const ImageTexture>(ImageTexture::FromPPM(ppm));
+
+    recency_.push_front(key);
+    entries_.emplace(key, Entry{texture, recency_.begin()});
+    bytes_ += texture->bytes();
+    // were a texture larger than the budget dropped as soon as it's loaded, every later Load of
+    // it would decode it again
+    EvictToBudget(1);
+
+    return texture;
+}
+
+void pattern::TextureCache::SetBudget(const size_t budget) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    budget_ = budget;
+    EvictToBudget(0);
+}
+
+size_t pattern::TextureCache::budget() const {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return budget_;
+}
+
+size_t pattern::TextureCache::bytes() const {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return bytes_;
+}
+
+size_t pattern::TextureCache::size() const {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return entries_.size();
+}
+
+void pattern::TextureCache::Clear() {
+    std::lock_guard<std::mutex> lock{mutex_};
+    entries_.clear();
+    recency_.clear();
+    bytes_ = 0;
+}
+
+void pattern::TextureCache::EvictToBudget(const size_t n_kept) {
+    while (bytes_ > budget_ && recency_.size() > n_kept) {
+        const auto it = entries_.find(recency_.back());
+        bytes_ -= it->second.texture_->bytes();
+        entries_.erase(it);
+        recency_.pop_back();
+    }
+}
@@ -0,0 +1,21 @@
+#include "texturemappattern.h"
+
+namespace {
+// coordinates that wrap around the Shape (or tile it) repeat; the others, which reach 1 at a pole
+// or a cube face's edge, are clamped so that they don't filter across to the opposite edge
+pattern::TextureWrap WrapU(const pattern::UVMapping mapping) {
+    return mapping == pattern::UVMapping::kCubic ? pattern::TextureWrap::kClamp
+                                                 : pattern::TextureWrap::kRepeat;
+}
+
+pattern::TextureWrap WrapV(const pattern::UVMapping mapping) {
+    return mapping == pattern::UVMapping::kSpherical || mapping == pattern::UVMapping::kCubic
+               ? pattern::TextureWrap::kClamp
+               : pattern::TextureWrap::kRepeat;
+}
+}  // namespace
+
+commontypes::Color pattern::TextureMapPattern::PatternAt(const commontypes::Point& point) const {
+    const UV uv = MapToUV(mapping_, point);
+    return texture_->ColorAt(uv.u_, uv.v_, mip_level_, WrapU(mapping_), WrapV(mapping_));
+}
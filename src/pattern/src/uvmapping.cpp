@@ -0,0 +1,83 @@
+#include "uvmapping.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// x within [0, 1), for negative x as well
+double Wrap(const double x) {
+    return x - floor(x);
+}
+
+// the azimuth of `point` about the y-axis, as a fraction of a turn
+double AzimuthU(const commontypes::Point& point) {
+    const double theta = atan2(point.x(), point.z());
+    const double raw_u = theta / (2 * M_PI);
+    // flip, so that u increases counter-clockwise when viewed from above
+    return Wrap(1 - (raw_u + 0.5));
+}
+}  // namespace
+
+// see the "Texture Mapping" bonus chapter
+pattern::UV pattern::SphericalMap(const commontypes::Point& point) {
+    const double radius = sqrt(point.x() * point.x() + point.y() * point.y() +
+                               point.z() * point.z());
+    if (radius == 0) {
+        return UV{0, 0};
+    }
+    const double phi = acos(point.y() / radius);  // polar angle, from the north pole
+    return UV{AzimuthU(point), 1 - phi / M_PI};
+}
+
+pattern::UV pattern::PlanarMap(const commontypes::Point& point) {
+    return UV{Wrap(point.x()), Wrap(point.z())};
+}
+
+pattern::UV pattern::CylindricalMap(const commontypes::Point& point) {
+    return UV{AzimuthU(point), Wrap(point.y())};
+}
+
+pattern::UV pattern::CubicMap(const commontypes::Point& point) {
+    const double x = point.x();
+    const double y = point.y();
+    const double z = point.z();
+    const double abs_x = fabs(x);
+    const double abs_y = fabs(y);
+    const double abs_z = fabs(z);
+    const double coordinate = std::fmax(abs_x, std::fmax(abs_y, abs_z));
+
+    // the face's u and v (in [-1, 1]) as seen from outside the cube; each reaches 1 at the face's
+    // edge, rather than wrapping to the opposite one
+    const auto face_uv = [](const double u, const double v) {
+        return UV{std::clamp((u + 1) / 2, 0.0, 1.0), std::clamp((v + 1) / 2, 0.0, 1.0)};
+    };
+    if (coordinate == x) {
+        return face_uv(-z, y);
+    }
+    if (coordinate == -x) {
+        return face_uv(z, y);
+    }
+    if (coordinate == y) {
+        return face_uv(x, -z);
+    }
+    if (coordinate == -y) {
+        return face_uv(x, z);
+    }
+    if (coordinate == z) {
+        return face_uv(x, y);
+    }
+    return face_uv(-x, y);
+}
+
+pattern::UV pattern::MapToUV(const UVMapping mapping, const commontypes::Point& point) {
+    switch (mapping) {
+        case UVMapping::kSpherical:
+            return SphericalMap(point);
+        case UVMapping::kPlanar:
+            return PlanarMap(point);
+        case UVMapping::kCylindrical:
+            return CylindricalMap(point);
+        case UVMapping::kCubic:
+            return CubicMap(point);
+    }
+    return UV{0, 0};
+}
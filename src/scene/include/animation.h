@@ -0,0 +1,98 @@
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "camera.h"
+#include "canvas.h"
+#include "color.h"
+#include "matrix.h"
+#include "point.h"
+#include "renderstats.h"
+#include "shape.h"
+#include "vector.h"
+#include "world.h"
+
+namespace scene {
+// a transform given by its parts, which are interpolated separately between keys so that a
+// rotation (unlike its matrix) turns smoothly. the transform is translate * rotate_z * rotate_y
+// * rotate_x * scale
+struct TransformKey {
+    double time_;  // in seconds
+    std::array<double, 3> translation_{0, 0, 0};
+    std::array<double, 3> rotation_{0, 0, 0};  // radians about x, y and z
+    std::array<double, 3> scale_{1, 1, 1};
+
+    commontypes::Matrix ToMatrix() const;
+};
+
+// a Camera's view transform (see commontypes::ViewTransform)
+struct CameraKey {
+    double time_;
+    commontypes::Point from_;
+    commontypes::Point to_;
+    commontypes::Vector up_;
+};
+
+struct LightKey {
+    double time_;
+    commontypes::Point position_;
+    commontypes::Color intensity_;
+};
+
+// keyframes for the transforms of Shapes, the view of a Camera and the PointLights of a World.
+// between two keys each value is interpolated linearly; before the first key and after the last
+// the nearest key's values hold. keys may be added in any order.
+//
+// the frames are rendered from a single World: it's finalized once, and between frames only the
+// Shapes whose transforms actually changed are refit (see World::Refit). each frame's
+// RenderStats are passed on to the next, so TileOrder::kPreviousFrame orders its tiles by the
+// cost of the frame before
+class Animation {
+   public:
+    // the transforms keyed for `shape` are applied on top of (i.e. after) the transform it has
+    // when its first key is added
+    void AddTransformKey(const std::shared_ptr<geometry::Shape>& shape, const TransformKey& key);
+
+    void AddCameraKey(const CameraKey& key);
+
+    // for the PointLight at `light_idx` in World::lights()
+    void AddLightKey(size_t light_idx, const LightKey& key);
+
+    // the time of the last key (of any kind); 0 if there are none
+    double duration() const;
+
+    // poses `world` and `camera` as at `time`. only Shapes whose transforms differ from their
+    // current ones are transformed; returns how many were
+    size_t Apply(double time, World& world, Camera& camera) const;
+
+    // renders `n_frames` frames, spread evenly from time 0 up to (but not including)
+    // `duration()`, so that a looping animation (e.g. a turntable) doesn't repeat its first
+    // frame. `on_frame` is given each frame's index, image and stats as it's rendered
+    void Render(World& world,
+                Camera& camera,
+                size_t n_frames,
+                const std::function<void(size_t, const canvas::Canvas&, const RenderStats&)>&
+                    on_frame) const;
+
+   private:
+    struct TransformTrack {
+        std::shared_ptr<geometry::Shape> shape_;
+        commontypes::Matrix base_;  // the Shape's own transform, before any key
+        std::vector<TransformKey> keys_;
+    };
+
+    struct LightTrack {
+        size_t light_idx_;
+        std::vector<LightKey> keys_;
+    };
+
+    std::vector<TransformTrack> transform_tracks_;
+    std::vector<CameraKey> camera_keys_;
+    std::vector<LightTrack> light_tracks_;
+};
+}  // namespace scene
+
+#endif  // ANIMATION_H
@@ -1,19 +1,40 @@
 #ifndef CAMERA_H
 #define CAMERA_H
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "arena.h"
 #include "canvas.h"
 #include "identitymatrix.h"
 #include "ray.h"
+#include "renderstats.h"
+#include "workstealingscheduler.h"
 #include "world.h"
 
 namespace scene {
+// order in which the tiles of a frame are handed to the render threads
+enum class TileOrder {
+    // left to right, top to bottom
+    kScanline,
+    // most expensive first, as estimated by a sparse pre-pass over each tile
+    kPrepass,
+    // most expensive first, as recorded in the RenderStats passed to `Render`; falls back to
+    // kPrepass when those stats don't describe a previous frame of the same size
+    kPreviousFrame,
+};
+
 class Camera {
    public:
     Camera(const size_t hsize, const size_t vsize, const double field_of_view)
         : hsize_(hsize),
           vsize_(vsize),
           field_of_view_(field_of_view),
-          transform_(commontypes::IdentityMatrix{}) {
+          transform_(commontypes::IdentityMatrix{}),
+          inverse_transform_(commontypes::IdentityMatrix{}),
+          n_threads_(DefaultThreadCount()),
+          tile_order_(TileOrder::kScanline),
+          samples_per_axis_(1) {
         SetPixelSize();
     }
 
@@ -25,15 +46,44 @@ class Camera {
 
     inline void SetTransform(const commontypes::Matrix& transform_matrix) {
         this->transform_ = transform_matrix;
+        this->inverse_transform_ = transform_matrix.Inverse();
+    }
+
+    inline size_t n_threads() const { return n_threads_; }
+    inline void SetThreadCount(const size_t n_threads) {
+        n_threads_ = std::max<size_t>(n_threads, 1);
     }
 
+    inline TileOrder tile_order() const { return tile_order_; }
+    inline void SetTileOrder(const TileOrder tile_order) { tile_order_ = tile_order; }
+
+    inline size_t SamplesPerPixel() const { return samples_per_axis_ * samples_per_axis_; }
+
+    // supersample each pixel on a regular grid; `samples` must be a square number (1, 4, 9, ...)
+    void SetSamplesPerPixel(size_t samples);
+
     // computes the world coords for the center of the given pixel and
     // construct a ray that passes through that point
     commontypes::Ray RayForPixel(const size_t px, const size_t py) const;
 
+    // as above, through the point at (`x_offset_in_pixel`, `y_offset_in_pixel`) within the
+    // pixel, each in [0, 1)
+    commontypes::Ray RayForPixel(size_t px,
+                                 size_t py,
+                                 double x_offset_in_pixel,
+                                 double y_offset_in_pixel) const;
+
     // render the contents of the "world" to a Canvas
     canvas::Canvas Render(scene::World& world) const;
 
+    // as above, additionally recording the cost of each pixel in `stats`; with
+    // `TileOrder::kPreviousFrame`, the costs already in `stats` determine the order of the tiles
+    canvas::Canvas Render(scene::World& world, RenderStats& stats) const;
+
+    // as above, for a World that's already finalized (e.g. one brought up to date with
+    // World::Refit between the frames of an Animation), which is left as it is
+    canvas::Canvas RenderFinalized(const scene::World& world, RenderStats& stats) const;
+
    private:
     size_t
         hsize_;  // horizontal size (in pixels of the canvas that the picture will be rendered to)
@@ -41,12 +91,36 @@ class Camera {
     double field_of_view_;  // angle that describes how much the camera can see
     commontypes::Matrix
         transform_;  // matrix describing how the world should be oriented relative to the camera
+    commontypes::Matrix inverse_transform_;  // of `transform_`, rather than inverting per ray
     double half_width_;
     double half_height_;
     double pixel_size_;
+    size_t n_threads_;  // number of threads used to render
+    TileOrder tile_order_;
+    size_t samples_per_axis_;  // supersampling grid is samples_per_axis_ x samples_per_axis_
+
+    // one per render thread
+    using ThreadArenas = std::vector<std::unique_ptr<commontypes::Arena>>;
 
     // calculate (and set) the size of the pixels on the Canvas (in world-space units)
     void SetPixelSize();
+
+    void RenderTile(const World& world,
+                    const Tile& tile,
+                    canvas::Canvas& image,
+                    RenderStats& stats,
+                    commontypes::Arena& arena) const;
+
+    // tile indices in the order they should be rendered
+    std::vector<size_t> OrderTiles(const World& world,
+                                   const RenderStats& previous_stats,
+                                   WorkStealingScheduler& scheduler,
+                                   ThreadArenas& arenas) const;
+
+    // estimated cost of each tile, from timing a few pixels sampled from each
+    std::vector<uint64_t> EstimateTileCosts(const World& world,
+                                            WorkStealingScheduler& scheduler,
+                                            ThreadArenas& arenas) const;
 };
 }  // namespace scene
 #endif  // CAMERA_H
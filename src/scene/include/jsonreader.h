@@ -0,0 +1,87 @@
+#ifndef JSON_READER_H
+#define JSON_READER_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace scene {
+// thrown for malformed input; the message includes the line where the problem was found
+class ParseError : public std::runtime_error {
+   public:
+    explicit ParseError(const std::string& message) : std::runtime_error(message) {}
+};
+
+// Pull parser for JSON text. Values are consumed in document order directly from the underlying
+// buffer and no document tree is built; strings are returned as views into the buffer (which
+// must outlive the reader). String escape sequences are not supported.
+//
+//  reader.BeginObject();
+//  std::string_view key;
+//  while (reader.NextKey(key)) {
+//      if (key == "width") width = reader.ReadNumber();
+//      else reader.SkipValue();
+//  }
+class JsonReader {
+   public:
+    enum class TokenType {
+        kObjectBegin,
+        kObjectEnd,
+        kArrayBegin,
+        kArrayEnd,
+        kString,
+        kNumber,
+        kTrue,
+        kFalse,
+        kNull,
+        kEnd
+    };
+
+    explicit JsonReader(std::string_view text) : text_(text) {}
+
+    // type of the next token, without consuming it
+    TokenType Peek();
+
+    void BeginObject();
+
+    // reads the next key of the current object into `key`; returns false (having consumed the
+    // closing brace) once the object has no more members
+    bool NextKey(std::string_view& key);
+
+    void BeginArray();
+
+    // returns true if the current array has another element to read; false (having consumed the
+    // closing bracket) otherwise
+    bool NextElement();
+
+    double ReadNumber();
+    std::string_view ReadString();
+    bool ReadBool();
+
+    // consume the next value, whatever its type (including nested objects/arrays)
+    void SkipValue();
+
+    // fails unless only whitespace remains
+    void ExpectEnd();
+
+    inline size_t line() const { return line_; }
+
+    [[noreturn]] void Fail(const std::string& message) const;
+
+   private:
+    void SkipWhitespace();
+    void Expect(char c);
+
+    // handles the separator before the next member/element of the innermost object/array
+    bool NextInContainer(char closing);
+
+    std::string_view text_;
+    size_t pos_{0};
+    size_t line_{1};
+    // a value has just been read, so ',' or a closing token is next
+    bool expect_separator_{false};
+};
+}  // namespace scene
+
+#endif  // JSON_READER_H
@@ -0,0 +1,89 @@
+#ifndef RENDER_STATS_H
+#define RENDER_STATS_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "canvas.h"
+#include "world.h"
+
+namespace scene {
+// a rectangular region of the image, [x0_, x1_) x [y0_, y1_)
+struct Tile {
+    size_t x0_;
+    size_t y0_;
+    size_t x1_;
+    size_t y1_;
+};
+
+// the cost of a frame, recorded per pixel; a pixel's cost is the wall time taken to shade it and
+// the number of rays (of any kind) it cast
+class RenderStats {
+   public:
+    static constexpr size_t TILE_SIZE = 16;  // width and height (in pixels) of a Tile
+
+    RenderStats(size_t width, size_t height);
+
+    inline size_t width() const { return width_; }
+    inline size_t height() const { return height_; }
+
+    inline size_t n_tiles_x() const { return (width_ + TILE_SIZE - 1) / TILE_SIZE; }
+    inline size_t n_tiles_y() const { return (height_ + TILE_SIZE - 1) / TILE_SIZE; }
+    inline size_t n_tiles() const { return n_tiles_x() * n_tiles_y(); }
+
+    // tiles in scanline order; the last row and column may be partial
+    Tile TileAt(size_t tile_idx) const;
+    std::vector<Tile> Tiles() const;
+
+    inline void RecordPixel(const size_t x,
+                            const size_t y,
+                            const uint64_t nanoseconds,
+                            const uint64_t rays) {
+        pixel_nanoseconds_[y * width_ + x] = nanoseconds;
+        pixel_rays_[y * width_ + x] = rays;
+    }
+
+    inline uint64_t PixelNanoseconds(const size_t x, const size_t y) const {
+        return pixel_nanoseconds_[y * width_ + x];
+    }
+
+    inline uint64_t PixelRays(const size_t x, const size_t y) const {
+        return pixel_rays_[y * width_ + x];
+    }
+
+    uint64_t TileNanoseconds(size_t tile_idx) const;
+
+    uint64_t TileRays(size_t tile_idx) const;
+
+    uint64_t TotalRays() const;
+
+    inline void SetElapsed(const std::chrono::duration<double> elapsed) { elapsed_ = elapsed; }
+    inline std::chrono::duration<double> elapsed() const { return elapsed_; }
+
+    // millions of rays per second of wall time
+    double MraysPerSecond() const;
+
+    // summed over every render thread
+    inline void SetOccluderCacheStats(const OccluderCacheStats& occluder_cache_stats) {
+        occluder_cache_stats_ = occluder_cache_stats;
+    }
+    inline const OccluderCacheStats& occluder_cache_stats() const {
+        return occluder_cache_stats_;
+    }
+
+    // per-pixel cost as an image; cost is log-scaled and mapped from black (cheapest) through
+    // red and yellow to white (most expensive)
+    canvas::Canvas Heatmap() const;
+
+   private:
+    size_t width_;
+    size_t height_;
+    std::vector<uint64_t> pixel_nanoseconds_;
+    std::vector<uint64_t> pixel_rays_;
+    std::chrono::duration<double> elapsed_{0};
+    OccluderCacheStats occluder_cache_stats_{};
+};
+}  // namespace scene
+
+#endif  // RENDER_STATS_H
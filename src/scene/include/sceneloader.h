@@ -0,0 +1,70 @@
+#ifndef SCENE_LOADER_H
+#define SCENE_LOADER_H
+
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include "camera.h"
+#include "jsonreader.h"
+#include "world.h"
+
+namespace scene {
+// everything described by a scene file; the camera is optional so that a file may describe only
+// the contents of a world
+struct SceneDescription {
+    World world_;
+    std::optional<Camera> camera_;
+};
+
+// Builds a World (and Camera) from a JSON scene description. The document is read in a single
+// pass with a JsonReader, so named materials and patterns must be defined before they are
+// referenced. Materials and patterns that are identical (whether named or written inline) are
+// created once and shared by every shape that uses them. Further lights may be given as a
+// "lights" array of light objects. A light's type is point (the default), spot (with position,
+// direction, inner_angle and outer_angle in radians) or directional (with direction only).
+// Rectangular area lights (which cast soft shadows) are given as an "area_lights" array of
+// {"corner", "uvec", "usteps", "vvec", "vsteps", "intensity"} objects. A scene needs at least one
+// light of any kind.
+//
+//  {
+//    "camera": {"width": 100, "height": 50, "field_of_view": 0.785,
+//               "from": [0, 1.5, -5], "to": [0, 1, 0], "up": [0, 1, 0]},
+//    "light": {"position": [-10, 10, -10], "intensity": [1, 1, 1]},
+//    "patterns": {"checks": {"type": "checker", "colors": [[1, 1, 1], [0, 0, 0]],
+//                            "transform": [["scale", 0.5, 0.5, 0.5]]}},
+//    "materials": {"floor": {"pattern": "checks", "reflective": 0.1},
+//                  "shiny_floor": {"extends": "floor", "reflective": 0.5}},
+//    "prototypes": {"post": {"type": "cylinder", "minimum": 0, "maximum": 1}},
+//    "shapes": [
+//      {"type": "plane", "material": "floor"},
+//      {"type": "instance", "of": "post", "transform": [["translate", 2, 0, 0]]},
+//      {"type": "group", "transform": [["translate", 0, 1, 0]], "children": [
+//        {"type": "sphere", "material": {"color": [1, 0, 0], "diffuse": 0.7}},
+//        {"type": "cylinder", "minimum": 0, "maximum": 2, "closed": true}]}]
+//  }
+//
+// Shape types are sphere, plane, cube, cylinder, cone (with minimum, maximum and closed), triangle
+// (with p1, p2 and p3), mesh (a TriangleMesh read from the OBJ file given by file), group (with
+// children), csg (the union, intersection or difference, given as operation, of its two
+// children) and instance (of a named prototype, which is shared rather than copied; a material
+// given for an instance overrides the prototype's). Pattern types are stripe, gradient, ring,
+// checker, radial_gradient (each of which may be given two patterns, in place of its colors, as
+// patterns), blend (of the two patterns given as patterns, with the weight of the second),
+// texture (the PPM image given by file, wrapped onto the shape by a mapping of spherical (the
+// default), planar, cylindrical or cubic, and optionally sampled from a coarser mip_level; each
+// file is decoded once per process, see pattern::TextureCache) and perturbed (another pattern,
+// given by pattern, jittered by noise of the given scale, octaves and frequency). Transforms are
+// lists of translate, scale, rotate_x, rotate_y, rotate_z (radians) and shear (six values) steps,
+// applied in the order listed.
+class SceneLoader {
+   public:
+    // throws ParseError for malformed or inconsistent input, std::runtime_error if the file can't
+    // be read. files referred to by the scene are relative to the scene file's directory
+    static SceneDescription LoadFile(const std::filesystem::path& path);
+
+    // as above; files are relative to the working directory
+    static SceneDescription LoadString(std::string_view text);
+};
+}  // namespace scene
+
+#endif  // SCENE_LOADER_H
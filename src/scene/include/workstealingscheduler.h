@@ -0,0 +1,56 @@
+#ifndef WORK_STEALING_SCHEDULER_H
+#define WORK_STEALING_SCHEDULER_H
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace scene {
+// Runs a fixed batch of tasks on a pool of workers. Tasks are dealt round-robin, in the order
+// given, onto a deque per worker; a worker takes from the front of its own deque, and once that
+// is empty it steals from the back of another worker's. Putting the most expensive tasks first
+// therefore gets them started first, while the cheap ones left at the back of every deque even
+// out the end of the batch.
+class WorkStealingScheduler {
+   public:
+    using TaskFn = std::function<void(size_t worker_idx, size_t task)>;
+    using WorkerExitFn = std::function<void(size_t worker_idx)>;
+
+    explicit WorkStealingScheduler(size_t n_workers);
+
+    inline size_t n_workers() const { return n_workers_; }
+
+    // number of tasks taken from another worker's deque during the last `Run`
+    inline size_t steal_count() const { return steal_count_.load(); }
+
+    // invoke `task_fn` once for each of `tasks`, returning when every task has completed. the
+    // calling thread acts as worker 0. `worker_exit_fn` (optional) is invoked on each worker's
+    // own thread once it has run out of work
+    void Run(const std::vector<size_t>& tasks,
+             const TaskFn& task_fn,
+             const WorkerExitFn& worker_exit_fn = nullptr);
+
+   private:
+    struct WorkerQueue {
+        std::mutex mutex_;
+        std::deque<size_t> tasks_;
+    };
+
+    bool PopOwn(size_t worker_idx, size_t& task);
+    bool Steal(size_t worker_idx, size_t& task);
+    void WorkerLoop(size_t worker_idx, const TaskFn& task_fn, const WorkerExitFn& worker_exit_fn);
+
+    size_t n_workers_;
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::atomic<size_t> steal_count_{0};
+};
+
+// number of render threads to use when none is specified
+size_t DefaultThreadCount();
+}  // namespace scene
+
+#endif  // WORK_STEALING_SCHEDULER_H
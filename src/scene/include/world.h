@@ -4,15 +4,47 @@
 #include <initializer_list>
 #include <memory>
 #include <vector>
+#include "arealight.h"
+#include "concurrentshapelist.h"
+#include "directionallight.h"
+#include "lighting.h"
+#include "materialtable.h"
 #include "pointlight.h"
+#include "primitive.h"
+#include "spotlight.h"
 #include "sphere.h"
 
 namespace scene {
+// how often the last occluder of a light's shadow rays (see World::FindOccluded) occluded the
+// next shadow ray toward that light
+struct OccluderCacheStats {
+    uint64_t lookups_{0};
+    uint64_t hits_{0};
+
+    OccluderCacheStats& operator+=(const OccluderCacheStats& other) {
+        lookups_ += other.lookups_;
+        hits_ += other.hits_;
+        return *this;
+    }
+
+    inline double HitRate() const {
+        return lookups_ == 0 ? 0.0 : static_cast<double>(hits_) / static_cast<double>(lookups_);
+    }
+};
+
 class World {
    public:
     World() = default;
 
-    inline std::shared_ptr<lighting::PointLight> light() const { return light_; }
+    // the first PointLight, or nullptr if there are none. it's the World's own, so it's
+    // invalidated by any change to the lights
+    const lighting::PointLight* light() const;
+    inline const std::vector<lighting::PointLight>& lights() const { return lights_; }
+    inline const std::vector<lighting::SpotLight>& spot_lights() const { return spot_lights_; }
+    inline const std::vector<lighting::DirectionalLight>& directional_lights() const {
+        return directional_lights_;
+    }
+    inline const std::vector<lighting::AreaLight>& area_lights() const { return area_lights_; }
     inline std::vector<std::shared_ptr<geometry::Shape>> objects() const { return objects_; }
 
     // factory fn for constructing what the book describes as the "Default World"
@@ -24,8 +56,51 @@ class World {
 
     void AddObjects(std::vector<std::shared_ptr<geometry::Shape>>&& Shape_vec);
 
+    // may be called from any number of threads at once (e.g. by loader threads), unlike the
+    // above. the Shape only joins `objects()` at the next `Finalize`
+    void AddObjectConcurrently(std::shared_ptr<geometry::Shape> object_ptr);
+
+    // replaces every light with `light` (or with none, if it's nullptr)
     void SetLight(std::shared_ptr<lighting::PointLight> light);
 
+    // each kind of light is kept in its own array
+    void AddLight(const lighting::PointLight& light);
+    void AddLight(const lighting::SpotLight& light);
+    void AddLight(const lighting::DirectionalLight& light);
+
+    // replaces the PointLight at `idx` in `lights()`, e.g. to move it between the frames of an
+    // Animation; throws std::out_of_range if there's none
+    void ReplaceLight(size_t idx, const lighting::PointLight& light);
+
+    void AddAreaLight(const lighting::AreaLight& light);
+
+    // prepares the World for rendering by adding the Shapes passed to `AddObjectConcurrently`
+    // (and Group::AddChildConcurrently), caching each Shape's composed transforms (see
+    // Shape::CacheTransforms), flattening the Shapes' Materials into a MaterialTable, which
+    // `ShadeHit` reads, and by copying the simple Shapes into a PrimitiveList, which `Intersect`
+    // then uses. only Shapes whose transforms (or whose parents' transforms) have changed since
+    // the last call are recomputed. Camera::Render calls this; it must not be called while
+    // another thread is using the World, and must be called again after a Shape is added or
+    // transformed, or a Material is changed
+    void Finalize();
+
+    // as above, for a World whose Shapes have only been transformed since it was last finalized
+    // (e.g. between the frames of an Animation): only the Primitives of the Shapes whose
+    // transforms changed are updated (see PrimitiveList::Refit), and the MaterialTable is kept
+    // as is. falls back to `Finalize` if the World isn't finalized or Shapes have been added.
+    // returns the number of Primitives updated
+    size_t Refit();
+
+    // number of reflected/refracted bounces followed from each camera ray
+    inline uint8_t recursion_limit() const { return recursion_limit_; }
+    inline void SetRecursionLimit(const uint8_t recursion_limit) {
+        recursion_limit_ = recursion_limit;
+    }
+
+    // see lighting::ShadingMode; exact by default
+    inline lighting::ShadingMode shading_mode() const { return shading_mode_; }
+    inline void SetShadingMode(const lighting::ShadingMode mode) { shading_mode_ = mode; }
+
     bool WorldContains(const std::shared_ptr<geometry::Shape>& object) const;
 
     // collect all Intersections on the Shapes contained in this World; return these in sorted
@@ -44,12 +119,68 @@ class World {
     commontypes::Color RefractedColor(const geometry::Computations& comps,
                                       u_int8_t remaining_invocations = RECURSION_LIMIT) const;
 
+    // whether `point` is in shadow with respect to the first PointLight; false if there's none
     bool IsShadowed(const commontypes::Point& point) const;
 
+    // as above, for any light (`cache_slot` is as for `FindOccluded`; give each light its own)
+    bool IsShadowed(const lighting::Light& light,
+                    const commontypes::Point& point,
+                    uint32_t cache_slot = 0) const;
+
+    // the fraction of `light` that reaches `point`. the cells at the light's corners are sampled
+    // first; only when they disagree (i.e. `point` is in the penumbra) is every cell sampled
+    // (`cache_slot` is as for `FindOccluded`)
+    double IntensityAt(const lighting::AreaLight& light,
+                       const commontypes::Point& point,
+                       uint32_t cache_slot = 0) const;
+
+    // sets `occluded_` for each of `rays`, which all start from `point`; the rays are traced as a
+    // single batch when the World is finalized. one shadow ray is counted for each.
+    //
+    // neighboring points are usually shadowed by the same Shape, so once finalized, each thread
+    // remembers the last Shape to occlude a ray in each of the rays' `cache_slot_`s (ShadeHit
+    // gives every light its own slot) and tests it before tracing the ray through the World
+    void FindOccluded(const commontypes::Point& point,
+                      commontypes::ArenaVector<geometry::ShadowRay>& rays) const;
+
+    // lookups in, and hits of, the calling thread's occluder cache through any World
+    static OccluderCacheStats ThreadOccluderCacheStats();
+
+    // number of rays (of every kind) cast by the calling thread through any World
+    static uint64_t ThreadRaysCast();
+
    private:
-    std::shared_ptr<lighting::PointLight> light_;
+    // calls `fn(light, cache_slot)` for each PointLight, SpotLight and DirectionalLight
+    template <typename Fn>
+    void ForEachLight(Fn&& fn) const;
+
+    // the ShadingRecord of `object`'s Material in `materials_`; when there's none (the World
+    // isn't finalized, or the Shape's Material was replaced since), one is made in `fallback`
+    const lighting::ShadingRecord& ShadingRecordOf(const geometry::Shape& object,
+                                                   lighting::ShadingRecord& fallback) const;
+
+    commontypes::Color ReflectedColor(const geometry::Computations& comps,
+                                      const lighting::ShadingRecord& record,
+                                      u_int8_t remaining_invocations) const;
+
+    commontypes::Color RefractedColor(const geometry::Computations& comps,
+                                      const lighting::ShadingRecord& record,
+                                      u_int8_t remaining_invocations) const;
+
+    std::vector<lighting::PointLight> lights_;
+    std::vector<lighting::SpotLight> spot_lights_;
+    std::vector<lighting::DirectionalLight> directional_lights_;
+    std::vector<lighting::AreaLight> area_lights_;
     std::vector<std::shared_ptr<geometry::Shape>> objects_;
+    std::unique_ptr<geometry::ConcurrentShapeList> pending_objects_{
+        std::make_unique<geometry::ConcurrentShapeList>()};
+    geometry::PrimitiveList primitives_;  // of `objects_`, once finalized
+    lighting::MaterialTable materials_;   // of `objects_`, once finalized
+    bool finalized_{false};
+    uint64_t generation_{0};  // identifies `primitives_` as of the last `Finalize`
     static const uint8_t RECURSION_LIMIT = 5;
+    uint8_t recursion_limit_{RECURSION_LIMIT};
+    lighting::ShadingMode shading_mode_{lighting::ShadingMode::kExact};
 };
 }  // namespace scene
 
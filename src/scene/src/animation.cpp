@@ -0,0 +1,184 @@
+#include "animation.h"
+#include <algorithm>
+#include "pointlight.h"
+#include "rotationmatrix.h"
+#include "scalingmatrix.h"
+#include "translationmatrix.h"
+#include "viewtransform.h"
+
+namespace {
+double Lerp(const double a, const double b, const double fraction) {
+    return a + (b - a) * fraction;
+}
+
+std::array<double, 3> Lerp(const std::array<double, 3>& a,
+                           const std::array<double, 3>& b,
+                           const double fraction) {
+    return {Lerp(a[0], b[0], fraction), Lerp(a[1], b[1], fraction), Lerp(a[2], b[2], fraction)};
+}
+
+commontypes::Point Lerp(const commontypes::Point& a,
+                        const commontypes::Point& b,
+                        const double fraction) {
+    return commontypes::Point{Lerp(a.x(), b.x(), fraction), Lerp(a.y(), b.y(), fraction),
+                              Lerp(a.z(), b.z(), fraction)};
+}
+
+commontypes::Vector Lerp(const commontypes::Vector& a,
+                         const commontypes::Vector& b,
+                         const double fraction) {
+    return commontypes::Vector{Lerp(a.x(), b.x(), fraction), Lerp(a.y(), b.y(), fraction),
+                               Lerp(a.z(), b.z(), fraction)};
+}
+
+commontypes::Color Lerp(const commontypes::Color& a,
+                        const commontypes::Color& b,
+                        const double fraction) {
+    return commontypes::Color{Lerp(a.Red(), b.Red(), fraction),
+                              Lerp(a.Green(), b.Green(), fraction),
+                              Lerp(a.Blue(), b.Blue(), fraction)};
+}
+
+// keeps `keys` in order of time; a key at the same time as another follows it
+template <typename Key>
+void InsertKey(std::vector<Key>& keys, const Key& key) {
+    const auto it = std::upper_bound(
+        keys.begin(), keys.end(), key.time_,
+        [](const double time, const Key& other) { return time < other.time_; });
+    keys.insert(it, key);
+}
+
+// the keys either side of `time`, and how far `time` is between them; both are the nearest key
+// outside of the keys' times
+template <typename Key>
+struct KeyPair {
+    const Key& before_;
+    const Key& after_;
+    double fraction_;
+};
+
+template <typename Key>
+KeyPair<Key> KeysAround(const std::vector<Key>& keys, const double time) {
+    if (time <= keys.front().time_) {
+        return {keys.front(), keys.front(), 0};
+    }
+    if (time >= keys.back().time_) {
+        return {keys.back(), keys.back(), 0};
+    }
+
+    const auto after = std::upper_bound(
+        keys.begin(), keys.end(), time,
+        [](const double t, const Key& other) { return t < other.time_; });
+    const Key& before = *(after - 1);
+    return {before, *after, (time - before.time_) / (after->time_ - before.time_)};
+}
+}  // namespace
+
+commontypes::Matrix scene::TransformKey::ToMatrix() const {
+    return commontypes::TranslationMatrix{translation_[0], translation_[1], translation_[2]} *
+           commontypes::RotationMatrixZ{rotation_[2]} *
+           commontypes::RotationMatrixY{rotation_[1]} *
+           commontypes::RotationMatrixX{rotation_[0]} *
+           commontypes::ScalingMatrix{scale_[0], scale_[1], scale_[2]};
+}
+
+void scene::Animation::AddTransformKey(const std::shared_ptr<geometry::Shape>& shape,
+                                       const TransformKey& key) {
+    auto track = std::find_if(transform_tracks_.begin(), transform_tracks_.end(),
+                              [&shape](const auto& t) { return t.shape_ == shape; });
+    if (track == transform_tracks_.end()) {
+        transform_tracks_.push_back(TransformTrack{shape, shape->GetTransform(), {}});
+        track = transform_tracks_.end() - 1;
+    }
+    InsertKey(track->keys_, key);
+}
+
+void scene::Animation::AddCameraKey(const CameraKey& key) {
+    InsertKey(camera_keys_, key);
+}
+
+void scene::Animation::AddLightKey(const size_t light_idx, const LightKey& key) {
+    auto track = std::find_if(light_tracks_.begin(), light_tracks_.end(),
+                              [light_idx](const auto& t) { return t.light_idx_ == light_idx; });
+    if (track == light_tracks_.end()) {
+        light_tracks_.push_back(LightTrack{light_idx, {}});
+        track = light_tracks_.end() - 1;
+    }
+    InsertKey(track->keys_, key);
+}
+
+double scene::Animation::duration() const {
+    double duration = 0;
+    for (const auto& track : transform_tracks_) {
+        duration = std::max(duration, track.keys_.back().time_);
+    }
+    if (!camera_keys_.empty()) {
+        duration = std::max(duration, camera_keys_.back().time_);
+    }
+    for (const auto& track : light_tracks_) {
+        duration = std::max(duration, track.keys_.back().time_);
+    }
+    return duration;
+}
+
+size_t scene::Animation::Apply(const double time, World& world, Camera& camera) const {
+    if (!camera_keys_.empty()) {
+        const auto keys = KeysAround(camera_keys_, time);
+        camera.SetTransform(commontypes::ViewTransform{
+            Lerp(keys.before_.from_, keys.after_.from_, keys.fraction_),
+            Lerp(keys.before_.to_, keys.after_.to_, keys.fraction_),
+            Lerp(keys.before_.up_, keys.after_.up_, keys.fraction_)});
+    }
+
+    for (const auto& track : light_tracks_) {
+        const auto keys = KeysAround(track.keys_, time);
+        world.ReplaceLight(
+            track.light_idx_,
+            lighting::PointLight{
+                Lerp(keys.before_.position_, keys.after_.position_, keys.fraction_),
+                Lerp(keys.before_.intensity_, keys.after_.intensity_, keys.fraction_)});
+    }
+
+    // a Shape is only transformed (and so refit) when its transform changes; a Shape held still
+    // between two equal keys keeps its cached transforms
+    size_t n_transformed = 0;
+    for (const auto& track : transform_tracks_) {
+        const auto keys = KeysAround(track.keys_, time);
+        TransformKey key{time};
+        key.translation_ =
+            Lerp(keys.before_.translation_, keys.after_.translation_, keys.fraction_);
+        key.rotation_ = Lerp(keys.before_.rotation_, keys.after_.rotation_, keys.fraction_);
+        key.scale_ = Lerp(keys.before_.scale_, keys.after_.scale_, keys.fraction_);
+
+        const commontypes::Matrix transform = key.ToMatrix() * track.base_;
+        if (transform != track.shape_->GetTransform()) {
+            track.shape_->SetTransform(transform);
+            ++n_transformed;
+        }
+    }
+    return n_transformed;
+}
+
+void scene::Animation::Render(
+    World& world,
+    Camera& camera,
+    const size_t n_frames,
+    const std::function<void(size_t, const canvas::Canvas&, const RenderStats&)>& on_frame)
+    const {
+    const double frame_duration = n_frames == 0 ? 0 : duration() / static_cast<double>(n_frames);
+    RenderStats stats{camera.hsize(), camera.vsize()};
+
+    for (size_t frame = 0; frame < n_frames; ++frame) {
+        Apply(frame_duration * static_cast<double>(frame), world, camera);
+        // the whole World is prepared for the first frame; after that only the Shapes just
+        // transformed are refit
+        if (frame == 0) {
+            world.Finalize();
+        } else {
+            world.Refit();
+        }
+
+        const canvas::Canvas image = camera.RenderFinalized(world, stats);
+        on_frame(frame, image, stats);
+    }
+}
@@ -1,26 +1,68 @@
 #include "camera.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
 #include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include "arena.h"
+#include "instrumentation.h"
+
+namespace {
+void OutputArenaStats(const commontypes::ArenaStats& stats) {
+    std::clog << "\n\rArena: " << stats.arena_bytes_ / 1024 << " KiB from arena, "
+              << stats.oversized_bytes_ / 1024 << " KiB oversized for an arena block"
+              << std::flush;
+}
+
+void OutputRenderStats(const scene::RenderStats& stats,
+                       const scene::WorkStealingScheduler& scheduler) {
+    std::clog << "\n\rRays: " << stats.TotalRays() << " (" << std::fixed << std::setprecision(3)
+              << stats.MraysPerSecond() << " Mrays/s)" << std::defaultfloat << ", "
+              << scheduler.n_workers() << " threads, " << scheduler.steal_count()
+              << " tiles stolen, " << std::fixed << std::setprecision(1)
+              << stats.occluder_cache_stats().HitRate() * 100 << "% occluder cache hits"
+              << std::defaultfloat << std::flush;
+}
+}  // namespace
 
 commontypes::Ray scene::Camera::RayForPixel(const size_t px, const size_t py) const {
-    // offset from edge of the canvas to the pixel's center
-    const double x_offset = (static_cast<double>(px) + 0.5) * pixel_size_;
-    const double y_offset = (static_cast<double>(py) + 0.5) * pixel_size_;
+    return RayForPixel(px, py, 0.5, 0.5);
+}
+
+commontypes::Ray scene::Camera::RayForPixel(const size_t px,
+                                            const size_t py,
+                                            const double x_offset_in_pixel,
+                                            const double y_offset_in_pixel) const {
+    // offset from edge of the canvas to the point within the pixel (by default its center)
+    const double x_offset = (static_cast<double>(px) + x_offset_in_pixel) * pixel_size_;
+    const double y_offset = (static_cast<double>(py) + y_offset_in_pixel) * pixel_size_;
 
     // untransformed coords of the pixel in world space
     // recall that camera looks toward -z, so +x is "left"
     const double world_x = this->half_width_ - x_offset;
     const double world_y = this->half_height_ - y_offset;
-    const commontypes::Matrix transform_inverse = this->transform_.Inverse();
-
     const commontypes::Point pixel =
-        commontypes::Point(transform_inverse * commontypes::Point{world_x, world_y, -1});
+        commontypes::Point(inverse_transform_ * commontypes::Point{world_x, world_y, -1});
     const commontypes::Point origin =
-        commontypes::Point(transform_inverse * commontypes::Point{0, 0, 0});
+        commontypes::Point(inverse_transform_ * commontypes::Point{0, 0, 0});
     const commontypes::Vector direction = commontypes::Vector{(pixel - origin).Normalize()};
 
     return commontypes::Ray{origin, direction};
 }
 
+void scene::Camera::SetSamplesPerPixel(const size_t samples) {
+    const auto samples_per_axis = static_cast<size_t>(std::lround(std::sqrt(samples)));
+    if (samples == 0 || samples_per_axis * samples_per_axis != samples) {
+        throw std::invalid_argument("samples per pixel must be a square number, got " +
+                                    std::to_string(samples));
+    }
+    samples_per_axis_ = samples_per_axis;
+}
+
 // see discussion on p. 102
 void scene::Camera::SetPixelSize() {
     // cut the field of view in half
@@ -44,15 +86,178 @@ void scene::Camera::SetPixelSize() {
 }
 
 canvas::Canvas scene::Camera::Render(scene::World& world) const {
+    scene::RenderStats stats{hsize_, vsize_};
+    return Render(world, stats);
+}
+
+canvas::Canvas scene::Camera::Render(scene::World& world, scene::RenderStats& stats) const {
+    world.Finalize();
+    return RenderFinalized(world, stats);
+}
+
+canvas::Canvas scene::Camera::RenderFinalized(const scene::World& world,
+                                              scene::RenderStats& stats) const {
     canvas::Canvas image{hsize_, vsize_};
 
-    for (int y = 0; y < vsize_ - 1; ++y) {
-        std::clog << '\r' << "Scanlines remaining: " << (vsize_ - y) << " " << std::flush;
-        for (int x = 0; x < hsize_ - 1; ++x) {
-            commontypes::Ray ray = RayForPixel(x, y);
-            commontypes::Color color = world.ColorAt(ray);
+    scene::WorkStealingScheduler scheduler{n_threads_};
+
+    // temporaries created while shading a pixel (intersection lists, Shape copies, etc.) are
+    // drawn from the render thread's Arena, which is rewound as soon as the pixel is written
+    ThreadArenas arenas{};
+    for (size_t i = 0; i < scheduler.n_workers(); ++i) {
+        arenas.emplace_back(std::make_unique<commontypes::Arena>());
+    }
+
+    const std::vector<size_t> tile_order = OrderTiles(world, stats, scheduler, arenas);
+    stats = scene::RenderStats{hsize_, vsize_};
+    const auto start_time = std::chrono::steady_clock::now();
+
+    std::atomic<size_t> tiles_remaining{stats.n_tiles()};
+    std::vector<scene::OccluderCacheStats> worker_occluder_stats(scheduler.n_workers());
+    scheduler.Run(
+        tile_order,
+        [&](const size_t worker_idx, const size_t tile_idx) {
+            commontypes::Arena& arena = *arenas[worker_idx];
+            const commontypes::ArenaScope arena_scope{arena};
+            const scene::OccluderCacheStats before = scene::World::ThreadOccluderCacheStats();
+            RenderTile(world, stats.TileAt(tile_idx), image, stats, arena);
+
+            const scene::OccluderCacheStats after = scene::World::ThreadOccluderCacheStats();
+            worker_occluder_stats[worker_idx] +=
+                scene::OccluderCacheStats{after.lookups_ - before.lookups_,
+                                          after.hits_ - before.hits_};
+
+            const size_t remaining = --tiles_remaining;
+            if (worker_idx == 0) {
+                std::clog << '\r' << "Tiles remaining: " << remaining << " " << std::flush;
+            }
+        },
+        [](const size_t) { instrumentation::MergeThreadCounters(); });
+
+    stats.SetElapsed(std::chrono::steady_clock::now() - start_time);
+
+    scene::OccluderCacheStats occluder_stats{};
+    for (const auto& worker_stats : worker_occluder_stats) {
+        occluder_stats += worker_stats;
+    }
+    stats.SetOccluderCacheStats(occluder_stats);
+
+    commontypes::ArenaStats arena_stats{};
+    for (const auto& arena : arenas) {
+        arena_stats += arena->stats();
+    }
+
+    OutputArenaStats(arena_stats);
+    OutputRenderStats(stats, scheduler);
+    return image;
+}
+
+void scene::Camera::RenderTile(const scene::World& world,
+                               const scene::Tile& tile,
+                               canvas::Canvas& image,
+                               scene::RenderStats& stats,
+                               commontypes::Arena& arena) const {
+    for (size_t y = tile.y0_; y < tile.y1_; ++y) {
+        for (size_t x = tile.x0_; x < tile.x1_; ++x) {
+            const auto pixel_start_time = std::chrono::steady_clock::now();
+            const uint64_t rays_before = scene::World::ThreadRaysCast();
+
+            commontypes::Color color{};
+            for (size_t sy = 0; sy < samples_per_axis_; ++sy) {
+                for (size_t sx = 0; sx < samples_per_axis_; ++sx) {
+                    // centers of the cells of the sampling grid
+                    commontypes::Ray ray = RayForPixel(
+                        x, y, (static_cast<double>(sx) + 0.5) / samples_per_axis_,
+                        (static_cast<double>(sy) + 0.5) / samples_per_axis_);
+                    INSTRUMENT_COUNT_RAY(kPrimary);
+                    color += world.ColorAt(ray, world.recursion_limit());
+                    arena.Reset();
+                }
+            }
+
+            color = commontypes::Color{color / static_cast<double>(SamplesPerPixel())};
             image.WritePixel(x, y, color);
+
+            const auto pixel_nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - pixel_start_time);
+            stats.RecordPixel(x, y, pixel_nanoseconds.count(),
+                              scene::World::ThreadRaysCast() - rays_before);
         }
     }
-    return image;
+}
+
+std::vector<size_t> scene::Camera::OrderTiles(const scene::World& world,
+                                              const scene::RenderStats& previous_stats,
+                                              scene::WorkStealingScheduler& scheduler,
+                                              ThreadArenas& arenas) const {
+    const scene::RenderStats layout{hsize_, vsize_};
+    std::vector<size_t> tile_order(layout.n_tiles());
+    std::iota(tile_order.begin(), tile_order.end(), 0);
+
+    std::vector<uint64_t> tile_costs{};
+    switch (tile_order_) {
+        case TileOrder::kScanline:
+            return tile_order;
+        case TileOrder::kPreviousFrame:
+            if (previous_stats.width() == hsize_ && previous_stats.height() == vsize_ &&
+                previous_stats.TotalRays() > 0) {
+                for (size_t tile_idx = 0; tile_idx < layout.n_tiles(); ++tile_idx) {
+                    tile_costs.push_back(previous_stats.TileNanoseconds(tile_idx));
+                }
+                break;
+            }
+            [[fallthrough]];
+        case TileOrder::kPrepass:
+            tile_costs = EstimateTileCosts(world, scheduler, arenas);
+            break;
+    }
+
+    // most expensive first; ties keep scanline order
+    std::stable_sort(tile_order.begin(), tile_order.end(),
+                     [&tile_costs](const size_t lhs, const size_t rhs) {
+                         return tile_costs[lhs] > tile_costs[rhs];
+                     });
+    return tile_order;
+}
+
+std::vector<uint64_t> scene::Camera::EstimateTileCosts(const scene::World& world,
+                                                       scene::WorkStealingScheduler& scheduler,
+                                                       ThreadArenas& arenas) const {
+    const scene::RenderStats layout{hsize_, vsize_};
+    std::vector<uint64_t> tile_costs(layout.n_tiles(), 0);
+    std::vector<size_t> tiles(layout.n_tiles());
+    std::iota(tiles.begin(), tiles.end(), 0);
+
+    // the prepass's rays are traced for this frame, so every worker's counters are merged as
+    // for the frame's own
+    scheduler.Run(
+        tiles,
+        [&](const size_t worker_idx, const size_t tile_idx) {
+            commontypes::Arena& arena = *arenas[worker_idx];
+            const commontypes::ArenaScope arena_scope{arena};
+            const scene::Tile tile = layout.TileAt(tile_idx);
+
+            // a 2x2 grid of pixels, each at the center of one quadrant of the tile
+            const size_t tile_width = tile.x1_ - tile.x0_;
+            const size_t tile_height = tile.y1_ - tile.y0_;
+            const auto start_time = std::chrono::steady_clock::now();
+
+            const size_t ys[] = {tile.y0_ + tile_height / 4, tile.y0_ + (3 * tile_height) / 4};
+            const size_t xs[] = {tile.x0_ + tile_width / 4, tile.x0_ + (3 * tile_width) / 4};
+            for (const size_t y : ys) {
+                for (const size_t x : xs) {
+                    commontypes::Ray ray = RayForPixel(x, y);
+                    INSTRUMENT_COUNT_RAY(kPrimary);
+                    world.ColorAt(ray, world.recursion_limit());
+                    arena.Reset();
+                }
+            }
+
+            tile_costs[tile_idx] = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                       std::chrono::steady_clock::now() - start_time)
+                                       .count();
+        },
+        [](const size_t) { instrumentation::MergeThreadCounters(); });
+
+    return tile_costs;
 }
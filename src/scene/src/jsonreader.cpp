@@ -0,0 +1,244 @@
+#include "jsonreader.h"
+#include <cctype>
+#include <charconv>
+#include <cmath>
+
+namespace {
+// the length of the JSON number at the start of `text`, or 0 if there isn't one. the grammar is
+// stricter than from_chars's: -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?, so there's no nan,
+// inf, leading zero, leading '+' or bare '.'
+size_t NumberLength(const std::string_view text) {
+    size_t pos = 0;
+    const auto digits = [&]() {
+        const size_t start = pos;
+        while (pos < text.size() && std::isdigit(static_cast<unsigned char>(text[pos]))) {
+            ++pos;
+        }
+        return pos - start;
+    };
+
+    if (pos < text.size() && text[pos] == '-') {
+        ++pos;
+    }
+    const size_t int_start = pos;
+    const size_t n_int_digits = digits();
+    if (n_int_digits == 0 || (n_int_digits > 1 && text[int_start] == '0')) {
+        return 0;
+    }
+    if (pos < text.size() && text[pos] == '.') {
+        ++pos;
+        if (digits() == 0) {
+            return 0;
+        }
+    }
+    if (pos < text.size() && (text[pos] == 'e' || text[pos] == 'E')) {
+        ++pos;
+        if (pos < text.size() && (text[pos] == '+' || text[pos] == '-')) {
+            ++pos;
+        }
+        if (digits() == 0) {
+            return 0;
+        }
+    }
+    return pos;
+}
+}  // namespace
+
+void scene::JsonReader::SkipWhitespace() {
+    while (pos_ < text_.size()) {
+        const char c = text_[pos_];
+        if (c == '\n') {
+            ++line_;
+        } else if (c != ' ' && c != '\t' && c != '\r') {
+            return;
+        }
+        ++pos_;
+    }
+}
+
+void scene::JsonReader::Expect(const char c) {
+    SkipWhitespace();
+    if (pos_ >= text_.size() || text_[pos_] != c) {
+        Fail(std::string{"expected '"} + c + "'");
+    }
+    ++pos_;
+}
+
+void scene::JsonReader::Fail(const std::string& message) const {
+    throw scene::ParseError("line " + std::to_string(line_) + ": " + message);
+}
+
+scene::JsonReader::TokenType scene::JsonReader::Peek() {
+    SkipWhitespace();
+    if (pos_ >= text_.size()) {
+        return TokenType::kEnd;
+    }
+
+    switch (text_[pos_]) {
+        case '{':
+            return TokenType::kObjectBegin;
+        case '}':
+            return TokenType::kObjectEnd;
+        case '[':
+            return TokenType::kArrayBegin;
+        case ']':
+            return TokenType::kArrayEnd;
+        case '"':
+            return TokenType::kString;
+        case 't':
+            return TokenType::kTrue;
+        case 'f':
+            return TokenType::kFalse;
+        case 'n':
+            return TokenType::kNull;
+        default:
+            return TokenType::kNumber;
+    }
+}
+
+void scene::JsonReader::BeginObject() {
+    Expect('{');
+    expect_separator_ = false;
+}
+
+void scene::JsonReader::BeginArray() {
+    Expect('[');
+    expect_separator_ = false;
+}
+
+bool scene::JsonReader::NextInContainer(const char closing) {
+    SkipWhitespace();
+    if (pos_ < text_.size() && text_[pos_] == closing) {
+        ++pos_;
+        // the container just closed is itself a completed value
+        expect_separator_ = true;
+        return false;
+    }
+
+    if (expect_separator_) {
+        Expect(',');
+    }
+    expect_separator_ = false;
+    return true;
+}
+
+bool scene::JsonReader::NextKey(std::string_view& key) {
+    if (!NextInContainer('}')) {
+        return false;
+    }
+
+    key = ReadString();
+    Expect(':');
+    expect_separator_ = false;
+    return true;
+}
+
+bool scene::JsonReader::NextElement() {
+    return NextInContainer(']');
+}
+
+double scene::JsonReader::ReadNumber() {
+    SkipWhitespace();
+    const size_t length = NumberLength(text_.substr(pos_));
+    if (length == 0) {
+        Fail("expected a number");
+    }
+
+    // one too large for a double is out of range
+    double value{};
+    const char* begin = text_.data() + pos_;
+    const auto [ptr, ec] = std::from_chars(begin, begin + length, value);
+    if (ec != std::errc{} || ptr != begin + length || !std::isfinite(value)) {
+        Fail("expected a finite number");
+    }
+
+    pos_ += length;
+    expect_separator_ = true;
+    return value;
+}
+
+std::string_view scene::JsonReader::ReadString() {
+    Expect('"');
+    const size_t start = pos_;
+    while (pos_ < text_.size() && text_[pos_] != '"') {
+        if (text_[pos_] == '\\') {
+            Fail("escape sequences are not supported in strings");
+        }
+        if (text_[pos_] == '\n') {
+            Fail("unterminated string");
+        }
+        ++pos_;
+    }
+
+    if (pos_ >= text_.size()) {
+        Fail("unterminated string");
+    }
+
+    const std::string_view str = text_.substr(start, pos_ - start);
+    ++pos_;  // closing quote
+    expect_separator_ = true;
+    return str;
+}
+
+bool scene::JsonReader::ReadBool() {
+    SkipWhitespace();
+    bool value{};
+    if (text_.substr(pos_, 4) == "true") {
+        pos_ += 4;
+        value = true;
+    } else if (text_.substr(pos_, 5) == "false") {
+        pos_ += 5;
+        value = false;
+    } else {
+        Fail("expected true or false");
+    }
+
+    expect_separator_ = true;
+    return value;
+}
+
+void scene::JsonReader::SkipValue() {
+    switch (Peek()) {
+        case TokenType::kObjectBegin: {
+            BeginObject();
+            std::string_view key;
+            while (NextKey(key)) {
+                SkipValue();
+            }
+            break;
+        }
+        case TokenType::kArrayBegin:
+            BeginArray();
+            while (NextElement()) {
+                SkipValue();
+            }
+            break;
+        case TokenType::kString:
+            ReadString();
+            break;
+        case TokenType::kTrue:
+        case TokenType::kFalse:
+            ReadBool();
+            break;
+        case TokenType::kNull:
+            if (text_.substr(pos_, 4) != "null") {
+                Fail("expected null");
+            }
+            pos_ += 4;
+            expect_separator_ = true;
+            break;
+        case TokenType::kNumber:
+            ReadNumber();
+            break;
+        case TokenType::kObjectEnd:
+        case TokenType::kArrayEnd:
+        case TokenType::kEnd:
+            Fail("expected a value");
+    }
+}
+
+void scene::JsonReader::ExpectEnd() {
+    if (Peek() != TokenType::kEnd) {
+        Fail("unexpected content after the end of the document");
+    }
+}
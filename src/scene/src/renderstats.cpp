@@ -0,0 +1,87 @@
+#include "renderstats.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+scene::RenderStats::RenderStats(const size_t width, const size_t height)
+    : width_(width),
+      height_(height),
+      pixel_nanoseconds_(width * height, 0),
+      pixel_rays_(width * height, 0) {}
+
+scene::Tile scene::RenderStats::TileAt(const size_t tile_idx) const {
+    const size_t x0 = (tile_idx % n_tiles_x()) * TILE_SIZE;
+    const size_t y0 = (tile_idx / n_tiles_x()) * TILE_SIZE;
+    return scene::Tile{x0, y0, std::min(x0 + TILE_SIZE, width_),
+                       std::min(y0 + TILE_SIZE, height_)};
+}
+
+std::vector<scene::Tile> scene::RenderStats::Tiles() const {
+    std::vector<scene::Tile> tiles{};
+    tiles.reserve(n_tiles());
+    for (size_t tile_idx = 0; tile_idx < n_tiles(); ++tile_idx) {
+        tiles.push_back(TileAt(tile_idx));
+    }
+    return tiles;
+}
+
+uint64_t scene::RenderStats::TileNanoseconds(const size_t tile_idx) const {
+    const scene::Tile tile = TileAt(tile_idx);
+    uint64_t total{0};
+    for (size_t y = tile.y0_; y < tile.y1_; ++y) {
+        for (size_t x = tile.x0_; x < tile.x1_; ++x) {
+            total += PixelNanoseconds(x, y);
+        }
+    }
+    return total;
+}
+
+uint64_t scene::RenderStats::TileRays(const size_t tile_idx) const {
+    const scene::Tile tile = TileAt(tile_idx);
+    uint64_t total{0};
+    for (size_t y = tile.y0_; y < tile.y1_; ++y) {
+        for (size_t x = tile.x0_; x < tile.x1_; ++x) {
+            total += PixelRays(x, y);
+        }
+    }
+    return total;
+}
+
+uint64_t scene::RenderStats::TotalRays() const {
+    return std::accumulate(pixel_rays_.begin(), pixel_rays_.end(), uint64_t{0});
+}
+
+double scene::RenderStats::MraysPerSecond() const {
+    if (elapsed_.count() <= 0) {
+        return 0.0;
+    }
+    return static_cast<double>(TotalRays()) / elapsed_.count() / 1e6;
+}
+
+canvas::Canvas scene::RenderStats::Heatmap() const {
+    canvas::Canvas heatmap{width_, height_};
+
+    const uint64_t max_nanoseconds =
+        pixel_nanoseconds_.empty()
+            ? 0
+            : *std::max_element(pixel_nanoseconds_.begin(), pixel_nanoseconds_.end());
+    if (max_nanoseconds == 0) {
+        return heatmap;
+    }
+
+    // costs commonly span a couple orders of magnitude (e.g. floor vs. glass), so log-scale them
+    const double log_max = std::log1p(static_cast<double>(max_nanoseconds));
+
+    for (size_t y = 0; y < height_; ++y) {
+        for (size_t x = 0; x < width_; ++x) {
+            const double t =
+                std::log1p(static_cast<double>(PixelNanoseconds(x, y))) / log_max;
+            commontypes::Color color{std::clamp(3 * t, 0.0, 1.0),
+                                     std::clamp(3 * t - 1, 0.0, 1.0),
+                                     std::clamp(3 * t - 2, 0.0, 1.0)};
+            heatmap.WritePixel(x, y, color);
+        }
+    }
+
+    return heatmap;
+}
@@ -0,0 +1,856 @@
+#include "sceneloader.h"
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include "blendpattern.h"
+#include "checkerpattern.h"
+#include "cone.h"
+#include "csg.h"
+#include "cube.h"
+#include "cylinder.h"
+#include "directionallight.h"
+#include "gradientpattern.h"
+#include "group.h"
+#include "instance.h"
+#include "material.h"
+#include "nestedpattern.h"
+#include "objparser.h"
+#include "perturbedpattern.h"
+#include "plane.h"
+#include "pointlight.h"
+#include "radialgradientpattern.h"
+#include "ringpattern.h"
+#include "rotationmatrix.h"
+#include "scalingmatrix.h"
+#include "shearingmatrix.h"
+#include "spotlight.h"
+#include "sphere.h"
+#include "stripepattern.h"
+#include "texturecache.h"
+#include "texturemappattern.h"
+#include "translationmatrix.h"
+#include "triangle.h"
+#include "viewtransform.h"
+
+namespace {
+using Triple = std::array<double, 3>;
+
+// everything that determines a Pattern; equal specs produce a single shared Pattern
+struct PatternSpec {
+    std::string_view type_;
+    Triple color_a_{1, 1, 1};
+    Triple color_b_{0, 0, 0};
+    matrixtype transform_{commontypes::IdentityMatrix{}.matrix()};
+    std::string_view file_;  // of a texture
+    pattern::UVMapping mapping_{pattern::UVMapping::kSpherical};
+    size_t mip_level_{0};
+    std::shared_ptr<pattern::Pattern> pattern_;  // the one perturbed; compared by identity
+    double scale_{0.2};
+    size_t octaves_{3};
+    double frequency_{1};
+    // in place of the colors, for a nested or blended pattern; compared by identity
+    std::array<std::shared_ptr<pattern::Pattern>, 2> patterns_;
+    double weight_{0.5};  // of a blend's second pattern
+
+    bool operator<(const PatternSpec& other) const {
+        return std::tie(type_, color_a_, color_b_, transform_, file_, mapping_, mip_level_,
+                        pattern_, scale_, octaves_, frequency_, patterns_, weight_) <
+               std::tie(other.type_, other.color_a_, other.color_b_, other.transform_,
+                        other.file_, other.mapping_, other.mip_level_, other.pattern_,
+                        other.scale_, other.octaves_, other.frequency_, other.patterns_,
+                        other.weight_);
+    }
+};
+
+// as above, for Materials. Patterns are already shared, so they're compared by identity
+struct MaterialSpec {
+    MaterialSpec() {
+        const lighting::Material defaults{};
+        ambient_ = defaults.Ambient();
+        diffuse_ = defaults.Diffuse();
+        specular_ = defaults.Specular();
+        shininess_ = defaults.Shininess();
+        reflective_ = defaults.Reflective();
+        transparency_ = defaults.Transparency();
+        refractive_index_ = defaults.RefractiveIndex();
+        const commontypes::Color color = defaults.Color();
+        color_ = {color.Red(), color.Green(), color.Blue()};
+    }
+
+    bool operator<(const MaterialSpec& other) const {
+        return std::tie(ambient_, diffuse_, specular_, shininess_, reflective_, transparency_,
+                        refractive_index_, color_, pattern_) <
+               std::tie(other.ambient_, other.diffuse_, other.specular_, other.shininess_,
+                        other.reflective_, other.transparency_, other.refractive_index_,
+                        other.color_, other.pattern_);
+    }
+
+    double ambient_;
+    double diffuse_;
+    double specular_;
+    double shininess_;
+    double reflective_;
+    double transparency_;
+    double refractive_index_;
+    Triple color_;
+    std::shared_ptr<pattern::Pattern> pattern_;
+};
+
+commontypes::Color ToColor(const Triple& triple) {
+    return commontypes::Color{triple[0], triple[1], triple[2]};
+}
+
+// of a two-color pattern type given patterns in place of its colors
+pattern::NestedPattern::Kind NestedKindOf(const std::string_view type) {
+    if (type == "stripe") {
+        return pattern::NestedPattern::Kind::kStripe;
+    }
+    if (type == "gradient") {
+        return pattern::NestedPattern::Kind::kGradient;
+    }
+    if (type == "ring") {
+        return pattern::NestedPattern::Kind::kRing;
+    }
+    if (type == "radial_gradient") {
+        return pattern::NestedPattern::Kind::kRadialGradient;
+    }
+    return pattern::NestedPattern::Kind::kChecker;
+}
+
+class SceneBuilder {
+   public:
+    // files referred to by the scene are relative to `base_dir`
+    SceneBuilder(const std::string_view text, std::filesystem::path base_dir)
+        : reader_(text), base_dir_(std::move(base_dir)) {}
+
+    scene::SceneDescription Build();
+
+   private:
+    Triple ReadTriple();
+    size_t ReadSize();
+    commontypes::Matrix ReadTransform();
+
+    scene::Camera ReadCamera();
+    void ReadLight(scene::World& world);
+    lighting::AreaLight ReadAreaLight();
+
+    void ReadPatternDefinitions();
+    PatternSpec ReadPatternSpec();
+    std::shared_ptr<pattern::Pattern> ReadPattern();
+    std::shared_ptr<pattern::Pattern> InternPattern(const PatternSpec& spec);
+
+    void ReadMaterialDefinitions();
+    MaterialSpec ReadMaterialSpec();
+    std::shared_ptr<lighting::Material> ReadMaterial();
+    std::shared_ptr<lighting::Material> InternMaterial(const MaterialSpec& spec);
+
+    void ReadPrototypeDefinitions();
+    std::vector<std::shared_ptr<geometry::Shape>> ReadShapes();
+    std::shared_ptr<geometry::Shape> ReadShape();
+
+    scene::JsonReader reader_;
+    std::filesystem::path base_dir_;
+    std::unordered_map<std::string, std::shared_ptr<pattern::Pattern>> named_patterns_;
+    std::unordered_map<std::string, MaterialSpec> named_materials_;
+    std::unordered_map<std::string, std::shared_ptr<const geometry::Shape>> named_prototypes_;
+    std::map<PatternSpec, std::shared_ptr<pattern::Pattern>> patterns_;
+    std::map<MaterialSpec, std::shared_ptr<lighting::Material>> materials_;
+};
+
+scene::SceneDescription SceneBuilder::Build() {
+    scene::SceneDescription description{};
+
+    reader_.BeginObject();
+    std::string_view key;
+    while (reader_.NextKey(key)) {
+        if (key == "camera") {
+            description.camera_.emplace(ReadCamera());
+        } else if (key == "light") {
+            ReadLight(description.world_);
+        } else if (key == "lights") {
+            reader_.BeginArray();
+            while (reader_.NextElement()) {
+                ReadLight(description.world_);
+            }
+        } else if (key == "area_lights") {
+            reader_.BeginArray();
+            while (reader_.NextElement()) {
+                description.world_.AddAreaLight(ReadAreaLight());
+            }
+        } else if (key == "patterns") {
+            ReadPatternDefinitions();
+        } else if (key == "materials") {
+            ReadMaterialDefinitions();
+        } else if (key == "prototypes") {
+            ReadPrototypeDefinitions();
+        } else if (key == "shapes") {
+            description.world_.AddObjects(ReadShapes());
+        } else {
+            // allows for comments and other metadata
+            reader_.SkipValue();
+        }
+    }
+    reader_.ExpectEnd();
+
+    const scene::World& world = description.world_;
+    if (world.lights().empty() && world.spot_lights().empty() &&
+        world.directional_lights().empty() && world.area_lights().empty()) {
+        reader_.Fail("the scene has no light");
+    }
+
+    return description;
+}
+
+Triple SceneBuilder::ReadTriple() {
+    Triple triple{};
+    reader_.BeginArray();
+    for (double& value : triple) {
+        if (!reader_.NextElement()) {
+            reader_.Fail("expected three numbers");
+        }
+        value = reader_.ReadNumber();
+    }
+
+    if (reader_.NextElement()) {
+        reader_.Fail("expected three numbers");
+    }
+    return triple;
+}
+
+size_t SceneBuilder::ReadSize() {
+    const double value = reader_.ReadNumber();
+    if (value < 0 || value != static_cast<double>(static_cast<size_t>(value))) {
+        reader_.Fail("expected a non-negative integer");
+    }
+    return static_cast<size_t>(value);
+}
+
+commontypes::Matrix SceneBuilder::ReadTransform() {
+    commontypes::Matrix transform = commontypes::IdentityMatrix{};
+
+    reader_.BeginArray();
+    while (reader_.NextElement()) {
+        reader_.BeginArray();
+        if (!reader_.NextElement()) {
+            reader_.Fail("empty transform step");
+        }
+
+        const std::string_view operation = reader_.ReadString();
+        std::vector<double> args{};
+        while (reader_.NextElement()) {
+            args.push_back(reader_.ReadNumber());
+        }
+
+        const auto expect_n_args = [&](const size_t n_args) {
+            if (args.size() != n_args) {
+                reader_.Fail("'" + std::string{operation} + "' takes " + std::to_string(n_args) +
+                             " values");
+            }
+        };
+
+        // each step is applied after those preceding it
+        if (operation == "translate") {
+            expect_n_args(3);
+            transform = commontypes::TranslationMatrix{args[0], args[1], args[2]} * transform;
+        } else if (operation == "scale") {
+            expect_n_args(3);
+            transform = commontypes::ScalingMatrix{args[0], args[1], args[2]} * transform;
+        } else if (operation == "rotate_x") {
+            expect_n_args(1);
+            transform = commontypes::RotationMatrixX{args[0]} * transform;
+        } else if (operation == "rotate_y") {
+            expect_n_args(1);
+            transform = commontypes::RotationMatrixY{args[0]} * transform;
+        } else if (operation == "rotate_z") {
+            expect_n_args(1);
+            transform = commontypes::RotationMatrixZ{args[0]} * transform;
+        } else if (operation == "shear") {
+            expect_n_args(6);
+            transform = commontypes::ShearingMatrix{args[0], args[1], args[2],
+                                                    args[3], args[4], args[5]} *
+                        transform;
+        } else {
+            reader_.Fail("unknown transform '" + std::string{operation} + "'");
+        }
+    }
+
+    return transform;
+}
+
+scene::Camera SceneBuilder::ReadCamera() {
+    size_t width{0};
+    size_t height{0};
+    double field_of_view{0};
+    // the defaults describe the identity view transform
+    Triple from{0, 0, 0};
+    Triple to{0, 0, -1};
+    Triple up{0, 1, 0};
+
+    reader_.BeginObject();
+    std::string_view key;
+    while (reader_.NextKey(key)) {
+        if (key == "width") {
+            width = ReadSize();
+        } else if (key == "height") {
+            height = ReadSize();
+        } else if (key == "field_of_view") {
+            field_of_view = reader_.ReadNumber();
+        } else if (key == "from") {
+            from = ReadTriple();
+        } else if (key == "to") {
+            to = ReadTriple();
+        } else if (key == "up") {
+            up = ReadTriple();
+        } else {
+            reader_.Fail("unknown camera property '" + std::string{key} + "'");
+        }
+    }
+
+    if (width == 0 || height == 0 || field_of_view <= 0) {
+        reader_.Fail("the camera needs a width, height and field_of_view");
+    }
+
+    scene::Camera camera{width, height, field_of_view};
+    camera.SetTransform(commontypes::ViewTransform{commontypes::Point{from[0], from[1], from[2]},
+                                                   commontypes::Point{to[0], to[1], to[2]},
+                                                   commontypes::Vector{up[0], up[1], up[2]}});
+    return camera;
+}
+
+void SceneBuilder::ReadLight(scene::World& world) {
+    std::string_view type{"point"};
+    Triple position{0, 0, 0};
+    Triple intensity{1, 1, 1};
+    Triple direction{0, -1, 0};
+    double inner_angle = 0;
+    double outer_angle = 0;
+    bool has_direction = false;
+    bool has_angles = false;
+
+    reader_.BeginObject();
+    std::string_view key;
+    while (reader_.NextKey(key)) {
+        if (key == "type") {
+            type = reader_.ReadString();
+        } else if (key == "position") {
+            position = ReadTriple();
+        } else if (key == "intensity") {
+            intensity = ReadTriple();
+        } else if (key == "direction") {
+            direction = ReadTriple();
+            has_direction = true;
+        } else if (key == "inner_angle") {
+            inner_angle = reader_.ReadNumber();
+            has_angles = true;
+        } else if (key == "outer_angle") {
+            outer_angle = reader_.ReadNumber();
+            has_angles = true;
+        } else {
+            reader_.Fail("unknown light property '" + std::string{key} + "'");
+        }
+    }
+
+    if (has_direction && type == "point") {
+        reader_.Fail("only spot and directional lights have a direction");
+    }
+    if (has_angles && type != "spot") {
+        reader_.Fail("only spot lights have an inner_angle or outer_angle");
+    }
+
+    const commontypes::Point light_position{position[0], position[1], position[2]};
+    const commontypes::Vector light_direction{direction[0], direction[1], direction[2]};
+    if (type == "point") {
+        world.AddLight(lighting::PointLight{light_position, ToColor(intensity)});
+    } else if (type == "spot") {
+        if (inner_angle < 0 || inner_angle > outer_angle || outer_angle >= M_PI) {
+            reader_.Fail("a spot light's angles must satisfy "
+                         "0 <= inner_angle <= outer_angle < pi");
+        }
+        world.AddLight(lighting::SpotLight{light_position, light_direction, inner_angle,
+                                           outer_angle, ToColor(intensity)});
+    } else if (type == "directional") {
+        world.AddLight(lighting::DirectionalLight{light_direction, ToColor(intensity)});
+    } else {
+        reader_.Fail("unknown light type '" + std::string{type} + "'");
+    }
+}
+
+lighting::AreaLight SceneBuilder::ReadAreaLight() {
+    Triple corner{0, 0, 0};
+    Triple uvec{1, 0, 0};
+    Triple vvec{0, 0, 1};
+    Triple intensity{1, 1, 1};
+    size_t usteps = 1;
+    size_t vsteps = 1;
+
+    reader_.BeginObject();
+    std::string_view key;
+    while (reader_.NextKey(key)) {
+        if (key == "corner") {
+            corner = ReadTriple();
+        } else if (key == "uvec") {
+            uvec = ReadTriple();
+        } else if (key == "vvec") {
+            vvec = ReadTriple();
+        } else if (key == "usteps") {
+            usteps = ReadSize();
+        } else if (key == "vsteps") {
+            vsteps = ReadSize();
+        } else if (key == "intensity") {
+            intensity = ReadTriple();
+        } else {
+            reader_.Fail("unknown area light property '" + std::string{key} + "'");
+        }
+    }
+
+    if (usteps == 0 || vsteps == 0) {
+        reader_.Fail("an area light needs at least one step in each direction");
+    }
+    return lighting::AreaLight{commontypes::Point{corner[0], corner[1], corner[2]},
+                               commontypes::Vector{uvec[0], uvec[1], uvec[2]}, usteps,
+                               commontypes::Vector{vvec[0], vvec[1], vvec[2]}, vsteps,
+                               ToColor(intensity)};
+}
+
+void SceneBuilder::ReadPatternDefinitions() {
+    reader_.BeginObject();
+    std::string_view name;
+    while (reader_.NextKey(name)) {
+        const auto pattern = InternPattern(ReadPatternSpec());
+        if (!named_patterns_.emplace(name, pattern).second) {
+            reader_.Fail("pattern '" + std::string{name} + "' is already defined");
+        }
+    }
+}
+
+PatternSpec SceneBuilder::ReadPatternSpec() {
+    PatternSpec spec{};
+
+    reader_.BeginObject();
+    std::string_view key;
+    while (reader_.NextKey(key)) {
+        if (key == "type") {
+            spec.type_ = reader_.ReadString();
+        } else if (key == "colors") {
+            reader_.BeginArray();
+            for (Triple* color : {&spec.color_a_, &spec.color_b_}) {
+                if (!reader_.NextElement()) {
+                    reader_.Fail("a pattern takes two colors");
+                }
+                *color = ReadTriple();
+            }
+            if (reader_.NextElement()) {
+                reader_.Fail("a pattern takes two colors");
+            }
+        } else if (key == "transform") {
+            spec.transform_ = ReadTransform().matrix();
+        } else if (key == "file") {
+            spec.file_ = reader_.ReadString();
+        } else if (key == "mapping") {
+            const std::string_view mapping = reader_.ReadString();
+            if (mapping == "spherical") {
+                spec.mapping_ = pattern::UVMapping::kSpherical;
+            } else if (mapping == "planar") {
+                spec.mapping_ = pattern::UVMapping::kPlanar;
+            } else if (mapping == "cylindrical") {
+                spec.mapping_ = pattern::UVMapping::kCylindrical;
+            } else if (mapping == "cubic") {
+                spec.mapping_ = pattern::UVMapping::kCubic;
+            } else {
+                reader_.Fail("unknown mapping '" + std::string{mapping} + "'");
+            }
+        } else if (key == "mip_level") {
+            spec.mip_level_ = ReadSize();
+        } else if (key == "pattern") {
+            spec.pattern_ = ReadPattern();
+        } else if (key == "scale") {
+            spec.scale_ = reader_.ReadNumber();
+        } else if (key == "octaves") {
+            spec.octaves_ = ReadSize();
+        } else if (key == "frequency") {
+            spec.frequency_ = reader_.ReadNumber();
+        } else if (key == "patterns") {
+            reader_.BeginArray();
+            for (auto& sub_pattern : spec.patterns_) {
+                if (!reader_.NextElement()) {
+                    reader_.Fail("a pattern takes two patterns");
+                }
+                sub_pattern = ReadPattern();
+            }
+            if (reader_.NextElement()) {
+                reader_.Fail("a pattern takes two patterns");
+            }
+        } else if (key == "weight") {
+            spec.weight_ = reader_.ReadNumber();
+            if (spec.weight_ < 0.0 || spec.weight_ > 1.0) {
+                reader_.Fail("a blend's weight must be within [0, 1]");
+            }
+        } else {
+            reader_.Fail("unknown pattern property '" + std::string{key} + "'");
+        }
+    }
+
+    if (spec.type_ != "stripe" && spec.type_ != "gradient" && spec.type_ != "ring" &&
+        spec.type_ != "checker" && spec.type_ != "radial_gradient" && spec.type_ != "texture" &&
+        spec.type_ != "perturbed" && spec.type_ != "blend") {
+        reader_.Fail("unknown pattern type '" + std::string{spec.type_} + "'");
+    }
+    if ((spec.type_ == "texture") == spec.file_.empty()) {
+        reader_.Fail("a texture pattern (and only a texture pattern) needs a file");
+    }
+    if ((spec.type_ == "perturbed") != static_cast<bool>(spec.pattern_)) {
+        reader_.Fail("a perturbed pattern (and only a perturbed pattern) needs a pattern");
+    }
+    const bool has_patterns = static_cast<bool>(spec.patterns_[0]);
+    if (spec.type_ == "blend" && !has_patterns) {
+        reader_.Fail("a blend pattern needs patterns");
+    }
+    if (has_patterns && (spec.type_ == "texture" || spec.type_ == "perturbed")) {
+        reader_.Fail("a " + std::string{spec.type_} + " pattern doesn't take patterns");
+    }
+
+    return spec;
+}
+
+std::shared_ptr<pattern::Pattern> SceneBuilder::ReadPattern() {
+    if (reader_.Peek() != scene::JsonReader::TokenType::kString) {
+        return InternPattern(ReadPatternSpec());
+    }
+
+    const std::string name{reader_.ReadString()};
+    const auto it = named_patterns_.find(name);
+    if (it == named_patterns_.end()) {
+        reader_.Fail("undefined pattern '" + name + "'");
+    }
+    return it->second;
+}
+
+std::shared_ptr<pattern::Pattern> SceneBuilder::InternPattern(const PatternSpec& spec) {
+    auto& pattern = patterns_[spec];
+    if (pattern) {
+        return pattern;
+    }
+
+    const commontypes::Color color_a = ToColor(spec.color_a_);
+    const commontypes::Color color_b = ToColor(spec.color_b_);
+    if (spec.type_ == "blend") {
+        pattern = std::make_shared<pattern::BlendPattern>(spec.patterns_[0], spec.patterns_[1],
+                                                          spec.weight_);
+    } else if (spec.patterns_[0]) {
+        pattern = std::make_shared<pattern::NestedPattern>(NestedKindOf(spec.type_),
+                                                           spec.patterns_[0], spec.patterns_[1]);
+    } else if (spec.type_ == "stripe") {
+        pattern = std::make_shared<pattern::StripePattern>(color_a, color_b);
+    } else if (spec.type_ == "gradient") {
+        pattern = std::make_shared<pattern::GradientPattern>(color_a, color_b);
+    } else if (spec.type_ == "ring") {
+        pattern = std::make_shared<pattern::RingPattern>(color_a, color_b);
+    } else if (spec.type_ == "radial_gradient") {
+        pattern = std::make_shared<pattern::RadialGradientPattern>(color_a, color_b);
+    } else if (spec.type_ == "texture") {
+        try {
+            pattern = std::make_shared<pattern::TextureMapPattern>(
+                pattern::TextureCache::Global().Load(base_dir_ / spec.file_), spec.mapping_,
+                spec.mip_level_);
+        } catch (const std::exception& e) {
+            reader_.Fail(e.what());
+        }
+    } else if (spec.type_ == "perturbed") {
+        pattern = std::make_shared<pattern::PerturbedPattern>(spec.pattern_, spec.scale_,
+                                                              spec.octaves_, spec.frequency_);
+    } else {
+        pattern = std::make_shared<pattern::CheckerPattern>(color_a, color_b);
+    }
+    pattern->SetPatternTransform(commontypes::Matrix{spec.transform_});
+
+    return pattern;
+}
+
+void SceneBuilder::ReadMaterialDefinitions() {
+    reader_.BeginObject();
+    std::string_view name;
+    while (reader_.NextKey(name)) {
+        if (!named_materials_.emplace(name, ReadMaterialSpec()).second) {
+            reader_.Fail("material '" + std::string{name} + "' is already defined");
+        }
+    }
+}
+
+MaterialSpec SceneBuilder::ReadMaterialSpec() {
+    MaterialSpec spec{};
+    bool is_first_key = true;
+
+    reader_.BeginObject();
+    std::string_view key;
+    while (reader_.NextKey(key)) {
+        if (key == "extends") {
+            // overriding properties that were already set would be surprising
+            if (!is_first_key) {
+                reader_.Fail("'extends' must be the first material property");
+            }
+            const std::string name{reader_.ReadString()};
+            const auto it = named_materials_.find(name);
+            if (it == named_materials_.end()) {
+                reader_.Fail("undefined material '" + name + "'");
+            }
+            spec = it->second;
+        } else if (key == "color") {
+            spec.color_ = ReadTriple();
+        } else if (key == "ambient") {
+            spec.ambient_ = reader_.ReadNumber();
+        } else if (key == "diffuse") {
+            spec.diffuse_ = reader_.ReadNumber();
+        } else if (key == "specular") {
+            spec.specular_ = reader_.ReadNumber();
+        } else if (key == "shininess") {
+            spec.shininess_ = reader_.ReadNumber();
+        } else if (key == "reflective") {
+            spec.reflective_ = reader_.ReadNumber();
+        } else if (key == "transparency") {
+            spec.transparency_ = reader_.ReadNumber();
+        } else if (key == "refractive_index") {
+            spec.refractive_index_ = reader_.ReadNumber();
+        } else if (key == "pattern") {
+            spec.pattern_ = ReadPattern();
+        } else {
+            reader_.Fail("unknown material property '" + std::string{key} + "'");
+        }
+        is_first_key = false;
+    }
+
+    return spec;
+}
+
+std::shared_ptr<lighting::Material> SceneBuilder::ReadMaterial() {
+    if (reader_.Peek() != scene::JsonReader::TokenType::kString) {
+        return InternMaterial(ReadMaterialSpec());
+    }
+
+    const std::string name{reader_.ReadString()};
+    const auto it = named_materials_.find(name);
+    if (it == named_materials_.end()) {
+        reader_.Fail("undefined material '" + name + "'");
+    }
+    return InternMaterial(it->second);
+}
+
+std::shared_ptr<lighting::Material> SceneBuilder::InternMaterial(const MaterialSpec& spec) {
+    auto& material = materials_[spec];
+    if (!material) {
+        lighting::Material built = lighting::MaterialBuilder()
+                                       .WithAmbient(spec.ambient_)
+                                       .WithDiffuse(spec.diffuse_)
+                                       .WithSpecular(spec.specular_)
+                                       .WithShininess(spec.shininess_)
+                                       .WithReflective(spec.reflective_)
+                                       .WithTransparency(spec.transparency_)
+                                       .WithRefractiveIndex(spec.refractive_index_)
+                                       .WithColor(ToColor(spec.color_))
+                                       .WithPatternPtr(spec.pattern_);
+        material = std::make_shared<lighting::Material>(std::move(built));
+    }
+
+    return material;
+}
+
+void SceneBuilder::ReadPrototypeDefinitions() {
+    reader_.BeginObject();
+    std::string_view name;
+    while (reader_.NextKey(name)) {
+        if (!named_prototypes_.emplace(name, ReadShape()).second) {
+            reader_.Fail("prototype '" + std::string{name} + "' is already defined");
+        }
+    }
+}
+
+std::vector<std::shared_ptr<geometry::Shape>> SceneBuilder::ReadShapes() {
+    std::vector<std::shared_ptr<geometry::Shape>> shapes{};
+
+    reader_.BeginArray();
+    while (reader_.NextElement()) {
+        shapes.emplace_back(ReadShape());
+    }
+
+    return shapes;
+}
+
+std::shared_ptr<geometry::Shape> SceneBuilder::ReadShape() {
+    // the properties can appear in any order, so collect them all before constructing the Shape
+    std::string_view type;
+    commontypes::Matrix transform = commontypes::IdentityMatrix{};
+    std::shared_ptr<lighting::Material> material;
+    double minimum = -std::numeric_limits<double>::infinity();
+    double maximum = std::numeric_limits<double>::infinity();
+    bool closed = false;
+    bool has_bounds = false;
+    std::array<Triple, 3> vertices{};
+    uint8_t seen_vertices = 0;  // bit i is set once p(i + 1) is read
+    std::vector<std::shared_ptr<geometry::Shape>> children{};
+    bool has_children = false;
+    std::string_view file;
+    std::string_view prototype_name;
+    std::string_view operation;
+
+    reader_.BeginObject();
+    std::string_view key;
+    while (reader_.NextKey(key)) {
+        if (key == "type") {
+            type = reader_.ReadString();
+        } else if (key == "transform") {
+            transform = ReadTransform();
+        } else if (key == "material") {
+            material = ReadMaterial();
+        } else if (key == "minimum") {
+            minimum = reader_.ReadNumber();
+            has_bounds = true;
+        } else if (key == "maximum") {
+            maximum = reader_.ReadNumber();
+            has_bounds = true;
+        } else if (key == "closed") {
+            closed = reader_.ReadBool();
+            has_bounds = true;
+        } else if (key == "p1" || key == "p2" || key == "p3") {
+            const auto vertex_idx = static_cast<size_t>(key[1] - '1');
+            if (seen_vertices & (1u << vertex_idx)) {
+                reader_.Fail("duplicate vertex '" + std::string{key} + "'");
+            }
+            vertices[vertex_idx] = ReadTriple();
+            seen_vertices |= static_cast<uint8_t>(1u << vertex_idx);
+        } else if (key == "file") {
+            file = reader_.ReadString();
+        } else if (key == "of") {
+            prototype_name = reader_.ReadString();
+        } else if (key == "operation") {
+            operation = reader_.ReadString();
+        } else if (key == "children") {
+            children = ReadShapes();
+            has_children = true;
+        } else {
+            reader_.Fail("unknown shape property '" + std::string{key} + "'");
+        }
+    }
+
+    if (has_bounds && type != "cylinder" && type != "cone") {
+        reader_.Fail("only cylinders and cones have a minimum, maximum or closed property");
+    }
+    if (seen_vertices != 0 && type != "triangle") {
+        reader_.Fail("only triangles have vertices");
+    }
+    if (has_children && type != "group" && type != "csg") {
+        reader_.Fail("only groups and csgs have children");
+    }
+    if (!operation.empty() && type != "csg") {
+        reader_.Fail("only csgs have an operation");
+    }
+    if (!file.empty() && type != "mesh") {
+        reader_.Fail("only meshes are read from a file");
+    }
+    if (!prototype_name.empty() && type != "instance") {
+        reader_.Fail("only instances refer to a prototype");
+    }
+
+    std::shared_ptr<geometry::Shape> shape;
+    if (type == "sphere") {
+        shape = std::make_shared<geometry::Sphere>();
+    } else if (type == "plane") {
+        shape = std::make_shared<geometry::Plane>();
+    } else if (type == "cube") {
+        shape = std::make_shared<geometry::Cube>();
+    } else if (type == "cylinder") {
+        shape = std::make_shared<geometry::Cylinder>(minimum, maximum, closed);
+    } else if (type == "cone") {
+        shape = std::make_shared<geometry::Cone>(minimum, maximum, closed);
+    } else if (type == "triangle") {
+        for (size_t vertex_idx = 0; vertex_idx < vertices.size(); ++vertex_idx) {
+            if (!(seen_vertices & (1u << vertex_idx))) {
+                reader_.Fail("a triangle needs p1, p2 and p3; missing 'p" +
+                             std::to_string(vertex_idx + 1) + "'");
+            }
+        }
+        const auto to_point = [](const Triple& v) { return commontypes::Point{v[0], v[1], v[2]}; };
+        shape = std::make_shared<geometry::Triangle>(to_point(vertices[0]), to_point(vertices[1]),
+                                                     to_point(vertices[2]));
+    } else if (type == "mesh") {
+        if (file.empty()) {
+            reader_.Fail("a mesh needs an OBJ file");
+        }
+        try {
+            using geometry::ObjParser;
+            shape = ObjParser::ParseFile(base_dir_ / file, ObjParser::Output::kMesh).ToMesh();
+        } catch (const geometry::ObjParseError& e) {
+            reader_.Fail(e.what());
+        }
+    } else if (type == "group") {
+        if (material) {
+            reader_.Fail("groups have no material; set it on each child");
+        }
+        auto group = std::make_shared<geometry::Group>();
+        for (auto& child : children) {
+            group->AddChildToGroup(child);
+        }
+        shape = group;
+    } else if (type == "csg") {
+        if (material) {
+            reader_.Fail("csgs have no material; set it on each child");
+        }
+        if (children.size() != 2) {
+            reader_.Fail("a csg needs two children");
+        }
+        geometry::CSG::Operation csg_operation{};
+        if (operation == "union") {
+            csg_operation = geometry::CSG::Operation::kUnion;
+        } else if (operation == "intersection") {
+            csg_operation = geometry::CSG::Operation::kIntersection;
+        } else if (operation == "difference") {
+            csg_operation = geometry::CSG::Operation::kDifference;
+        } else {
+            reader_.Fail("unknown csg operation '" + std::string{operation} + "'");
+        }
+        shape = std::make_shared<geometry::CSG>(csg_operation, children[0], children[1]);
+    } else if (type == "instance") {
+        const auto prototype = named_prototypes_.find(std::string{prototype_name});
+        if (prototype == named_prototypes_.end()) {
+            reader_.Fail("undefined prototype '" + std::string{prototype_name} + "'");
+        }
+        auto instance = std::make_shared<geometry::Instance>(prototype->second);
+        instance->SetMaterialOverride(material);
+        shape = instance;
+    } else if (type.empty()) {
+        reader_.Fail("shape has no type");
+    } else {
+        reader_.Fail("unknown shape type '" + std::string{type} + "'");
+    }
+
+    shape->SetTransform(transform);
+    // shapes without a material of their own share the default one
+    shape->SetMaterial(material ? material : InternMaterial(MaterialSpec{}));
+
+    return shape;
+}
+}  // namespace
+
+scene::SceneDescription scene::SceneLoader::LoadFile(const std::filesystem::path& path) {
+    std::ifstream in{path, std::ios::binary};
+    if (!in) {
+        throw std::runtime_error("unable to open scene file " + path.string());
+    }
+
+    std::string text(std::filesystem::file_size(path), '\0');
+    in.read(text.data(), static_cast<std::streamsize>(text.size()));
+
+    try {
+        return SceneBuilder{text, path.parent_path()}.Build();
+    } catch (const ParseError& e) {
+        throw ParseError(path.string() + ": " + e.what());
+    }
+}
+
+scene::SceneDescription scene::SceneLoader::LoadString(const std::string_view text) {
+    return SceneBuilder{text, std::filesystem::current_path()}.Build();
+}
@@ -0,0 +1,80 @@
+#include "workstealingscheduler.h"
+#include <algorithm>
+#include <thread>
+
+scene::WorkStealingScheduler::WorkStealingScheduler(const size_t n_workers)
+    : n_workers_(std::max<size_t>(n_workers, 1)) {
+    for (size_t i = 0; i < n_workers_; ++i) {
+        queues_.emplace_back(std::make_unique<WorkerQueue>());
+    }
+}
+
+void scene::WorkStealingScheduler::Run(const std::vector<size_t>& tasks,
+                                       const TaskFn& task_fn,
+                                       const WorkerExitFn& worker_exit_fn) {
+    steal_count_ = 0;
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        queues_[i % n_workers_]->tasks_.push_back(tasks[i]);
+    }
+
+    // never start more threads than there is work for
+    const size_t n_threads = std::min(n_workers_, std::max<size_t>(tasks.size(), 1));
+
+    std::vector<std::thread> threads{};
+    threads.reserve(n_threads - 1);
+    for (size_t worker_idx = 1; worker_idx < n_threads; ++worker_idx) {
+        threads.emplace_back(&WorkStealingScheduler::WorkerLoop, this, worker_idx,
+                             std::cref(task_fn), std::cref(worker_exit_fn));
+    }
+
+    WorkerLoop(0, task_fn, worker_exit_fn);
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+bool scene::WorkStealingScheduler::PopOwn(const size_t worker_idx, size_t& task) {
+    WorkerQueue& queue = *queues_[worker_idx];
+    const std::lock_guard<std::mutex> lock{queue.mutex_};
+    if (queue.tasks_.empty()) {
+        return false;
+    }
+
+    task = queue.tasks_.front();
+    queue.tasks_.pop_front();
+    return true;
+}
+
+bool scene::WorkStealingScheduler::Steal(const size_t worker_idx, size_t& task) {
+    // visit the other workers starting with the next one, so thieves spread across victims
+    for (size_t offset = 1; offset < n_workers_; ++offset) {
+        WorkerQueue& victim = *queues_[(worker_idx + offset) % n_workers_];
+        const std::lock_guard<std::mutex> lock{victim.mutex_};
+        if (!victim.tasks_.empty()) {
+            task = victim.tasks_.back();
+            victim.tasks_.pop_back();
+            ++steal_count_;
+            return true;
+        }
+    }
+    return false;
+}
+
+void scene::WorkStealingScheduler::WorkerLoop(const size_t worker_idx,
+                                              const TaskFn& task_fn,
+                                              const WorkerExitFn& worker_exit_fn) {
+    // no tasks are added once the batch has started, so once every deque is empty we're done
+    size_t task{};
+    while (PopOwn(worker_idx, task) || Steal(worker_idx, task)) {
+        task_fn(worker_idx, task);
+    }
+
+    if (worker_exit_fn) {
+        worker_exit_fn(worker_idx);
+    }
+}
+
+size_t scene::DefaultThreadCount() {
+    return std::max<unsigned int>(std::thread::hardware_concurrency(), 1);
+}
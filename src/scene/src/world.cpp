@@ -1,12 +1,53 @@
 #include "world.h"
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
 #include <utility>
+#include "group.h"
 #include "identitymatrix.h"
+#include "instrumentation.h"
 #include "lighting.h"
 #include "scalingmatrix.h"
 
 using ShapePtr = std::shared_ptr<geometry::Shape>;
 
+namespace {
+// seeds the jittered samples of area lights, so that a point is always shaded with the same
+// samples
+uint64_t SampleSeed(const commontypes::Point& point) {
+    uint64_t seed = 0;
+    for (const double coordinate : {point.x(), point.y(), point.z()}) {
+        uint64_t bits;
+        std::memcpy(&bits, &coordinate, sizeof(bits));
+        seed = (seed ^ bits) * 0x100000001b3ULL;
+    }
+    return seed;
+}
+
+// every ray passes through either `ColorAt` or `FindOccluded`; counted there
+thread_local uint64_t rays_cast = 0;
+
+// the calling thread's last occluder of each cache slot, as indices into the PrimitiveList of
+// the World finalized as `generation_`
+struct OccluderCache {
+    uint64_t generation_{0};
+    std::vector<uint32_t> occluders_;
+};
+thread_local OccluderCache occluder_cache{};
+thread_local scene::OccluderCacheStats occluder_cache_stats{};
+
+std::atomic<uint64_t> next_generation{1};
+}  // namespace
+
+uint64_t scene::World::ThreadRaysCast() {
+    return rays_cast;
+}
+
+scene::OccluderCacheStats scene::World::ThreadOccluderCacheStats() {
+    return occluder_cache_stats;
+}
+
 // see description of the "Default World" on pg. 92
 scene::World scene::World::DefaultWorld() {
     scene::World world{};
@@ -33,20 +74,95 @@ scene::World scene::World::DefaultWorld() {
 
 void scene::World::AddObject(ShapePtr object_ptr) {
     objects_.insert(objects_.end(), std::move(object_ptr));
+    finalized_ = false;
+}
+
+void scene::World::AddObjectConcurrently(ShapePtr object_ptr) {
+    pending_objects_->Push(std::move(object_ptr));
+}
+
+void scene::World::Finalize() {
+    if (!pending_objects_->empty()) {
+        AddObjects(pending_objects_->TakeAll());
+    }
+
+    primitives_.Clear();
+    materials_.Clear();
+    for (const auto& object : objects_) {
+        if (auto* group = dynamic_cast<geometry::Group*>(object.get())) {
+            group->CommitPendingChildren();
+        }
+        object->CacheTransforms();
+        object->IndexMaterials(materials_);
+        primitives_.Add(object);
+    }
+    finalized_ = true;
+    generation_ = next_generation++;
+}
+
+size_t scene::World::Refit() {
+    if (!finalized_ || !pending_objects_->empty()) {
+        Finalize();
+        return primitives_.n_primitives();
+    }
+    return primitives_.Refit();
 }
 
 void scene::World::AddObjects(std::initializer_list<ShapePtr> object_ptrs) {
     for (const auto& object_ptr : object_ptrs) {
         objects_.emplace_back(object_ptr);
     }
+    finalized_ = false;
 }
 
 void scene::World::AddObjects(std::vector<ShapePtr>&& sphere_vec) {
     objects_.insert(objects_.end(), sphere_vec.begin(), sphere_vec.end());
+    finalized_ = false;
+}
+
+const lighting::PointLight* scene::World::light() const {
+    return lights_.empty() ? nullptr : &lights_.front();
 }
 
 void scene::World::SetLight(std::shared_ptr<lighting::PointLight> light) {
-    light_ = std::move(light);
+    lights_.clear();
+    if (light) {
+        lights_.push_back(*light);
+    }
+}
+
+void scene::World::AddLight(const lighting::PointLight& light) {
+    lights_.push_back(light);
+}
+
+void scene::World::ReplaceLight(const size_t idx, const lighting::PointLight& light) {
+    lights_.at(idx) = light;
+}
+
+void scene::World::AddLight(const lighting::SpotLight& light) {
+    spot_lights_.push_back(light);
+}
+
+void scene::World::AddLight(const lighting::DirectionalLight& light) {
+    directional_lights_.push_back(light);
+}
+
+template <typename Fn>
+void scene::World::ForEachLight(Fn&& fn) const {
+    uint32_t cache_slot = 0;
+    for (const auto& light : lights_) {
+        fn(light, cache_slot++);
+    }
+    for (const auto& light : spot_lights_) {
+        fn(light, cache_slot++);
+    }
+    for (const auto& light : directional_lights_) {
+        fn(light, cache_slot++);
+    }
+}
+
+void scene::World::AddAreaLight(const lighting::AreaLight& light) {
+    area_lights_.push_back(light);
 }
 
 bool scene::World::WorldContains(const ShapePtr& object) const {
@@ -55,35 +171,96 @@ bool scene::World::WorldContains(const ShapePtr& object) const {
 }
 
 std::vector<geometry::Intersection> scene::World::Intersect(const commontypes::Ray& ray) const {
+    INSTRUMENT_PHASE(kIntersect);
+
+    // return flattened intersections of all objects in ascending order (see rationale on
+    // page 93); each object's are merged in as they're found rather than sorting them all
     std::vector<geometry::Intersection> intersections;
 
-    for (const auto& object : objects_) {
-        const auto xs = object->Intersect(ray);
-        intersections.insert(intersections.end(), xs.begin(), xs.end());
+    if (finalized_) {
+        primitives_.Intersect(ray, intersections);
+    } else {
+        for (const auto& object : objects_) {
+            const auto xs = object->Intersect(ray);
+            const size_t run_begin = intersections.size();
+            intersections.insert(intersections.end(), xs.begin(), xs.end());
+            geometry::MergeIntersections(intersections, run_begin);
+        }
     }
 
-    // return flattened intersections of all objects in ascending order (see rationale on
-    // page 93)
-    std::sort(intersections.begin(), intersections.end(),
-              [](const auto& lhs, const auto& rhs) { return lhs.t_ < rhs.t_; });
-
     return intersections;
 }
 
 commontypes::Color scene::World::ShadeHit(const geometry::Computations& comps,
                                           const uint8_t remaining_invocations) const {
-    const bool shadowed = this->IsShadowed(comps.over_point_);
-
-    const commontypes::Color surface =
-        lighting::Lighting(comps.object_->Material(), commontypes::IdentityMatrix{}, light_,
-                           comps.over_point_, comps.eye_vector_, comps.normal_vector_, shadowed);
+    lighting::ShadingRecord fallback;
+    const lighting::ShadingRecord& record = ShadingRecordOf(*comps.object_, fallback);
+
+    // a light behind the surface (or that doesn't reach it, such as a SpotLight pointed
+    // elsewhere) contributes only its ambient term, whether or not it's occluded, so no shadow ray
+    // is cast toward it
+    const size_t n_lights = lights_.size() + spot_lights_.size() + directional_lights_.size();
+    commontypes::ArenaVector<geometry::ShadowRay> shadow_rays{};
+    commontypes::ArenaVector<size_t> shadow_ray_idx(n_lights, SIZE_MAX);
+    ForEachLight([&](const lighting::Light& light, const uint32_t cache_slot) {
+        const lighting::LightSample sample = light.SampleFrom(comps.over_point_);
+        if (!sample.Illuminates(comps.normal_vector_)) {
+            return;
+        }
+        shadow_ray_idx[cache_slot] = shadow_rays.size();
+        shadow_rays.push_back(
+            geometry::ShadowRay{sample.direction_, sample.distance_, false, cache_slot});
+    });
+    FindOccluded(comps.over_point_, shadow_rays);
+
+    // the surface color is the same for every light, so it's found (and any pattern evaluated)
+    // once per hit
+    const commontypes::Color surface_color =
+        lighting::SurfaceColor(record, commontypes::IdentityMatrix{}, comps.over_point_);
+    commontypes::Color surface = commontypes::Color::MakeBlack();
+    ForEachLight([&](const lighting::Light& light, const uint32_t cache_slot) {
+        const bool shadowed = shadow_ray_idx[cache_slot] == SIZE_MAX ||
+                              shadow_rays[shadow_ray_idx[cache_slot]].occluded_;
+        surface = commontypes::Color{
+            surface + lighting::Lighting(record, surface_color, light, comps.over_point_,
+                                         comps.eye_vector_, comps.normal_vector_,
+                                         shadowed ? 0.0 : 1.0, shading_mode_)};
+    });
+
+    for (size_t j = 0; j < area_lights_.size(); ++j) {
+        const auto& area_light = area_lights_[j];
+        // an area light wholly behind the surface is culled as above; as the light is convex, it
+        // is iff each of its corners is
+        const commontypes::Vector full_uvec{area_light.uvec() *
+                                            static_cast<double>(area_light.usteps())};
+        const commontypes::Vector full_vvec{area_light.vvec() *
+                                            static_cast<double>(area_light.vsteps())};
+        bool in_front = false;
+        for (const auto& corner :
+             {commontypes::Tuple{area_light.corner()},
+              commontypes::Tuple{area_light.corner() + full_uvec},
+              commontypes::Tuple{area_light.corner() + full_vvec},
+              commontypes::Tuple{area_light.corner() + full_uvec + full_vvec}}) {
+            const commontypes::Vector to_corner{corner - comps.over_point_};
+            in_front |= to_corner.Dot(comps.normal_vector_) >= 0;
+        }
+
+        const auto cache_slot = static_cast<uint32_t>(n_lights + j);
+        const double intensity =
+            in_front ? IntensityAt(area_light, comps.over_point_, cache_slot) : 0.0;
+        surface = commontypes::Color{
+            surface + lighting::Lighting(record, surface_color, area_light,
+                                         comps.over_point_, comps.eye_vector_,
+                                         comps.normal_vector_, intensity, shading_mode_)};
+    }
 
-    const commontypes::Color reflected_color = ReflectedColor(comps, remaining_invocations);
-    const commontypes::Color refracted_color = RefractedColor(comps, remaining_invocations);
+    const commontypes::Color reflected_color =
+        ReflectedColor(comps, record, remaining_invocations);
+    const commontypes::Color refracted_color =
+        RefractedColor(comps, record, remaining_invocations);
 
     // if the surface is both transparent and reflective (pg. 164)
-    if (comps.object_->Material()->Reflective() > 0 &&
-        comps.object_->Material()->Transparency() > 0) {
+    if (record.IsReflective() && record.IsTransparent()) {
         const double reflectance = geometry::Schlick(comps);
         return commontypes::Color{surface + reflected_color * reflectance +
                                   refracted_color * (1 - reflectance)};
@@ -95,6 +272,7 @@ commontypes::Color scene::World::ShadeHit(const geometry::Computations& comps,
 
 commontypes::Color scene::World::ColorAt(commontypes::Ray& r,
                                          const uint8_t remaining_invocations) const {
+    ++rays_cast;
     const auto intersections = scene::World::Intersect(r);
     const auto maybe_hit = geometry::Intersection::Hit(intersections);
 
@@ -108,46 +286,182 @@ commontypes::Color scene::World::ColorAt(commontypes::Ray& r,
 }
 
 bool scene::World::IsShadowed(const commontypes::Point& point) const {
-    const commontypes::Vector v = commontypes::Vector{this->light_->position() - point};
-    const double distance = v.Magnitude();
-    const commontypes::Vector direction = commontypes::Vector{v.Normalize()};
-    const commontypes::Ray r{point, direction};
+    // a World may hold only spot, directional or area lights
+    if (lights_.empty()) {
+        return false;
+    }
+    return IsShadowed(lights_.front(), point);
+}
 
-    const auto intersections = this->Intersect(r);
-    const auto maybe_hit = geometry::Intersection::Hit(intersections);
-    if (maybe_hit.has_value() && maybe_hit.value().t_ < distance) {
-        return true;
+bool scene::World::IsShadowed(const lighting::Light& light,
+                              const commontypes::Point& point,
+                              const uint32_t cache_slot) const {
+    const lighting::LightSample sample = light.SampleFrom(point);
+    commontypes::ArenaVector<geometry::ShadowRay> rays{
+        {sample.direction_, sample.distance_, false, cache_slot}};
+    FindOccluded(point, rays);
+    return rays.front().occluded_;
+}
+
+double scene::World::IntensityAt(const lighting::AreaLight& light,
+                                 const commontypes::Point& point,
+                                 const uint32_t cache_slot) const {
+    const uint64_t seed = SampleSeed(point);
+    const size_t usteps = light.usteps();
+    const size_t vsteps = light.vsteps();
+
+    const auto add_ray = [&](commontypes::ArenaVector<geometry::ShadowRay>& rays, const size_t u,
+                             const size_t v) {
+        const commontypes::Vector to_light{light.JitteredPointOnLight(u, v, seed) - point};
+        rays.push_back(geometry::ShadowRay{commontypes::Vector{to_light.Normalize()},
+                                           to_light.Magnitude(), false, cache_slot});
+    };
+    const auto is_corner = [usteps, vsteps](const size_t u, const size_t v) {
+        return (u == 0 || u == usteps - 1) && (v == 0 || v == vsteps - 1);
+    };
+
+    commontypes::ArenaVector<geometry::ShadowRay> rays{};
+    for (size_t v = 0; v < vsteps; v += std::max<size_t>(vsteps - 1, 1)) {
+        for (size_t u = 0; u < usteps; u += std::max<size_t>(usteps - 1, 1)) {
+            add_ray(rays, u, v);
+        }
     }
-    return false;
+    FindOccluded(point, rays);
+
+    const auto n_occluded = static_cast<size_t>(
+        std::count_if(rays.begin(), rays.end(), [](const auto& ray) { return ray.occluded_; }));
+    if (rays.size() == light.samples() || n_occluded == 0 || n_occluded == rays.size()) {
+        return 1.0 - static_cast<double>(n_occluded) / static_cast<double>(rays.size());
+    }
+
+    // the corners disagree, so the point is in the penumbra; sample the remaining cells
+    commontypes::ArenaVector<geometry::ShadowRay> penumbra_rays{};
+    for (size_t v = 0; v < vsteps; ++v) {
+        for (size_t u = 0; u < usteps; ++u) {
+            if (!is_corner(u, v)) {
+                add_ray(penumbra_rays, u, v);
+            }
+        }
+    }
+    FindOccluded(point, penumbra_rays);
+
+    const auto n_penumbra_occluded = static_cast<size_t>(
+        std::count_if(penumbra_rays.begin(), penumbra_rays.end(),
+                      [](const auto& ray) { return ray.occluded_; }));
+    return 1.0 - static_cast<double>(n_occluded + n_penumbra_occluded) /
+                     static_cast<double>(light.samples());
+}
+
+void scene::World::FindOccluded(const commontypes::Point& point,
+                                commontypes::ArenaVector<geometry::ShadowRay>& rays) const {
+    for (size_t i = 0; i < rays.size(); ++i) {
+        INSTRUMENT_COUNT_RAY(kShadow);
+        ++rays_cast;
+    }
+
+    if (finalized_) {
+        INSTRUMENT_PHASE(kIntersect);
+        if (occluder_cache.generation_ != generation_) {
+            occluder_cache.generation_ = generation_;
+            occluder_cache.occluders_.clear();
+        }
+        auto& occluders = occluder_cache.occluders_;
+
+        for (auto& ray : rays) {
+            ++occluder_cache_stats.lookups_;
+            if (ray.cache_slot_ >= occluders.size() ||
+                occluders[ray.cache_slot_] == geometry::ShadowRay::NO_OCCLUDER) {
+                continue;
+            }
+
+            const uint32_t last_occluder = occluders[ray.cache_slot_];
+            if (primitives_.Occludes(last_occluder, point, ray)) {
+                ray.occluded_ = true;
+                ray.occluder_ = last_occluder;
+                ++occluder_cache_stats.hits_;
+            }
+        }
+
+        primitives_.FindOccluded(point, rays);
+
+        // an unoccluded ray leaves its slot as it was, since the next point may well be shadowed
+        // by the same Shape
+        for (const auto& ray : rays) {
+            if (!ray.occluded_) {
+                continue;
+            }
+            if (ray.cache_slot_ >= occluders.size()) {
+                occluders.resize(ray.cache_slot_ + 1, geometry::ShadowRay::NO_OCCLUDER);
+            }
+            occluders[ray.cache_slot_] = ray.occluder_;
+        }
+        return;
+    }
+
+    for (auto& ray : rays) {
+        const auto intersections = this->Intersect(commontypes::Ray{point, ray.direction_});
+        const auto maybe_hit = geometry::Intersection::Hit(intersections);
+        ray.occluded_ = maybe_hit.has_value() && maybe_hit.value().t_ < ray.distance_;
+    }
+}
+
+const lighting::ShadingRecord& scene::World::ShadingRecordOf(
+    const geometry::Shape& object,
+    lighting::ShadingRecord& fallback) const {
+    if (finalized_) {
+        const lighting::ShadingRecord* record =
+            materials_.Find(object.material_index(), object.material());
+        if (record != nullptr) {
+            return *record;
+        }
+    }
+    fallback = lighting::ShadingRecord::FromMaterial(*object.material());
+    return fallback;
+}
+
+commontypes::Color scene::World::ReflectedColor(const geometry::Computations& comps,
+                                                const uint8_t remaining_invocations) const {
+    lighting::ShadingRecord fallback;
+    return ReflectedColor(comps, ShadingRecordOf(*comps.object_, fallback),
+                          remaining_invocations);
 }
 
 commontypes::Color scene::World::ReflectedColor(const geometry::Computations& comps,
+                                                const lighting::ShadingRecord& record,
                                                 const uint8_t remaining_invocations) const {
     // recursion limit hit
     if (remaining_invocations <= 0)
         return commontypes::Color::MakeBlack();
 
-    const auto material_reflective = comps.object_->Material()->Reflective();
-    if (material_reflective == 0) {
+    if (!record.IsReflective()) {
         return commontypes::Color{0, 0, 0};
     }
 
     commontypes::Ray reflect_ray{comps.over_point_, comps.reflect_vector_};
+    INSTRUMENT_COUNT_RAY(kReflect);
 
     // decrement the remaining invocations before invocation to eliminate infinite
     // recursion
     const auto color = ColorAt(reflect_ray, remaining_invocations - 1);
 
-    return commontypes::Color{color * material_reflective};
+    return commontypes::Color{color * record.reflective_};
+}
+
+commontypes::Color scene::World::RefractedColor(const geometry::Computations& comps,
+                                                u_int8_t remaining_invocations) const {
+    lighting::ShadingRecord fallback;
+    return RefractedColor(comps, ShadingRecordOf(*comps.object_, fallback),
+                          remaining_invocations);
 }
 
 commontypes::Color scene::World::RefractedColor(const geometry::Computations& comps,
+                                                const lighting::ShadingRecord& record,
                                                 u_int8_t remaining_invocations) const {
     if (remaining_invocations <= 0) {
         return commontypes::Color::MakeBlack();
     }
 
-    if (comps.object_->Material()->Transparency() == 0) {
+    if (!record.IsTransparent()) {
         return commontypes::Color::MakeBlack();
     }
 
@@ -159,7 +473,7 @@ commontypes::Color scene::World::RefractedColor(const geometry::Computations& co
     const double cos_i = comps.eye_vector_.Dot(comps.normal_vector_);
 
     // trigonometric identity
-    const double sin2_t = pow(n_ratio, 2) * (1 - pow(cos_i, 2));
+    const double sin2_t = n_ratio * n_ratio * (1 - cos_i * cos_i);
 
     if (sin2_t > 1) {
         // total internal reflection. return black
@@ -174,8 +488,9 @@ commontypes::Color scene::World::RefractedColor(const geometry::Computations& co
         comps.normal_vector_ * (n_ratio * cos_i - cos_t) - comps.eye_vector_ * n_ratio};
 
     auto refract_ray = commontypes::Ray{comps.under_point_, direction};
+    INSTRUMENT_COUNT_RAY(kRefract);
 
     // color of the refracted ray, accounting for opacity
     return commontypes::Color{this->ColorAt(refract_ray, remaining_invocations - 1) *
-                              comps.object_->Material()->Transparency()};
+                              record.transparency_};
 }
@@ -116,3 +116,25 @@ TEST(CanvasTests, TestCanvasPPMFilesAreNewlineTerminated) {
     // verify the final line has a newline
     EXPECT_EQ('\n', ppm_str.at(ppm_str.size() - 1));
 }
+
+TEST(CanvasTests, TestWritePixelDataToBinaryPPM) {
+    canvas::Canvas canvas{5, 3};
+    commontypes::Color c1{1.5, 0, 0};
+    commontypes::Color c2{0, 0.5, 0};
+    canvas.WritePixel(0, 0, c1);
+    canvas.WritePixel(2, 1, c2);
+
+    const std::string header = "P6\n5 3\n255\n";
+    const std::string ppm_str = canvas.WriteBinaryPPM();
+    ASSERT_EQ(ppm_str.size(), header.size() + 5 * 3 * 3);
+    EXPECT_EQ(ppm_str.substr(0, header.size()), header);
+
+    // same values as the text variant, one byte per channel
+    const auto channel = [&](const size_t x, const size_t y, const size_t i) {
+        return static_cast<unsigned char>(ppm_str[header.size() + (y * 5 + x) * 3 + i]);
+    };
+    EXPECT_EQ(channel(0, 0, 0), 255);
+    EXPECT_EQ(channel(0, 0, 1), 0);
+    EXPECT_EQ(channel(2, 1, 1), 128);
+    EXPECT_EQ(channel(4, 2, 2), 0);
+}
@@ -0,0 +1,90 @@
+#include "arena.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+
+TEST(ArenaTest, TestAllocationsAreAlignedAndCounted) {
+    commontypes::Arena arena{1024};
+    void* p1 = arena.Allocate(3, 1);
+    void* p2 = arena.Allocate(sizeof(double), alignof(double));
+
+    ASSERT_NE(p1, nullptr);
+    ASSERT_NE(p2, nullptr);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(p2) % alignof(double), 0);
+    ASSERT_EQ(arena.stats().arena_bytes_, 3 + sizeof(double));
+    ASSERT_EQ(arena.stats().oversized_bytes_, 0);
+    ASSERT_EQ(arena.n_blocks(), 1);
+}
+
+TEST(ArenaTest, TestResetReusesBlocks) {
+    commontypes::Arena arena{256};
+    void* first = arena.Allocate(200);
+    arena.Allocate(200);  // doesn't fit in the remainder of the first block
+    ASSERT_EQ(arena.n_blocks(), 2);
+
+    arena.Reset();
+    void* after_reset = arena.Allocate(200);
+    ASSERT_EQ(first, after_reset);
+    ASSERT_EQ(arena.n_blocks(), 2);
+
+    // stats span resets; they're cleared explicitly
+    ASSERT_EQ(arena.stats().arena_bytes_, 600);
+    arena.ResetStats();
+    ASSERT_EQ(arena.stats().arena_bytes_, 0);
+}
+
+TEST(ArenaTest, TestOversizedAllocationsComeFromTheHeap) {
+    commontypes::Arena arena{64};
+    void* p = arena.Allocate(128);
+    ASSERT_NE(p, nullptr);
+    ASSERT_EQ(arena.stats().oversized_bytes_, 128);
+    ASSERT_EQ(arena.stats().arena_bytes_, 0);
+    ASSERT_EQ(arena.n_blocks(), 0);
+}
+
+TEST(ArenaTest, TestScopeBindsArenaToThread) {
+    ASSERT_EQ(commontypes::Arena::Current(), nullptr);
+    commontypes::Arena outer{};
+    {
+        const commontypes::ArenaScope outer_scope{outer};
+        ASSERT_EQ(commontypes::Arena::Current(), &outer);
+
+        commontypes::Arena inner{};
+        {
+            const commontypes::ArenaScope inner_scope{inner};
+            ASSERT_EQ(commontypes::Arena::Current(), &inner);
+        }
+        ASSERT_EQ(commontypes::Arena::Current(), &outer);
+    }
+    ASSERT_EQ(commontypes::Arena::Current(), nullptr);
+}
+
+TEST(ArenaTest, TestArenaVectorDrawsFromCurrentArena) {
+    commontypes::Arena arena{};
+    const commontypes::ArenaScope scope{arena};
+
+    commontypes::ArenaVector<int> v{};
+    for (int i = 0; i < 100; ++i) {
+        v.push_back(i);
+    }
+
+    ASSERT_EQ(v.get_allocator().arena(), &arena);
+    ASSERT_EQ(v.at(99), 99);
+    ASSERT_GE(arena.stats().arena_bytes_, 100 * sizeof(int));
+}
+
+TEST(ArenaTest, TestArenaAllocatorFallsBackToHeapWithoutScope) {
+    commontypes::ArenaVector<int> v{1, 2, 3};
+    ASSERT_EQ(v.get_allocator().arena(), nullptr);
+    ASSERT_EQ(v.size(), 3);
+}
+
+TEST(ArenaTest, TestMakeArenaShared) {
+    commontypes::Arena arena{};
+    const commontypes::ArenaScope scope{arena};
+    {
+        const auto value_ptr = commontypes::MakeArenaShared<double>(4.5);
+        ASSERT_DOUBLE_EQ(*value_ptr, 4.5);
+        ASSERT_GE(arena.stats().arena_bytes_, sizeof(double));
+    }
+    arena.Reset();
+}
@@ -0,0 +1,93 @@
+#include "instrumentation.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <new>
+#include <sstream>
+#include <thread>
+
+TEST(InstrumentationTest, TestCountersAreMergedIntoTotals) {
+    instrumentation::MergeThreadCounters();
+    instrumentation::ResetTotalCounters();
+
+    instrumentation::CountRay(instrumentation::RayKind::kShadow);
+    instrumentation::CountRay(instrumentation::RayKind::kShadow);
+    instrumentation::CountIntersectionTest(instrumentation::ShapeKind::kCone);
+    instrumentation::CountMatrixInversion();
+
+    // nothing reaches the totals until the thread's counters are merged
+    ASSERT_EQ(instrumentation::TotalCounters().matrix_inversions_, 0);
+
+    instrumentation::MergeThreadCounters();
+    const auto totals = instrumentation::TotalCounters();
+    ASSERT_EQ(totals.rays_[static_cast<size_t>(instrumentation::RayKind::kShadow)], 2);
+    ASSERT_EQ(totals.rays_[static_cast<size_t>(instrumentation::RayKind::kPrimary)], 0);
+    ASSERT_EQ(totals.intersection_tests_[static_cast<size_t>(instrumentation::ShapeKind::kCone)],
+              1);
+    ASSERT_EQ(totals.matrix_inversions_, 1);
+
+    // merging zeroes the thread's counters
+    ASSERT_EQ(instrumentation::ThreadCounters().matrix_inversions_, 0);
+}
+
+TEST(InstrumentationTest, TestCountersFromSeveralThreadsAreMerged) {
+    instrumentation::MergeThreadCounters();
+    instrumentation::ResetTotalCounters();
+
+    const auto count_primary_rays = [] {
+        for (int i = 0; i < 10; ++i) {
+            instrumentation::CountRay(instrumentation::RayKind::kPrimary);
+        }
+        instrumentation::MergeThreadCounters();
+    };
+
+    std::thread t1{count_primary_rays};
+    std::thread t2{count_primary_rays};
+    t1.join();
+    t2.join();
+
+    const auto totals = instrumentation::TotalCounters();
+    ASSERT_EQ(totals.rays_[static_cast<size_t>(instrumentation::RayKind::kPrimary)], 20);
+}
+
+TEST(InstrumentationTest, TestScopedPhaseTimerCountsCalls) {
+    instrumentation::MergeThreadCounters();
+    instrumentation::ResetTotalCounters();
+
+    {
+        const instrumentation::ScopedPhaseTimer timer{instrumentation::Phase::kLighting};
+    }
+
+    instrumentation::MergeThreadCounters();
+    const auto totals = instrumentation::TotalCounters();
+    ASSERT_EQ(totals.phase_calls_[static_cast<size_t>(instrumentation::Phase::kLighting)], 1);
+    ASSERT_EQ(totals.phase_calls_[static_cast<size_t>(instrumentation::Phase::kIntersect)], 0);
+}
+
+TEST(InstrumentationTest, TestReportNamesEachCounter) {
+    std::ostringstream out;
+    instrumentation::OutputReport(out);
+    const std::string report = out.str();
+
+    ASSERT_NE(report.find("refract="), std::string::npos);
+    ASSERT_NE(report.find("Triangle="), std::string::npos);
+    ASSERT_NE(report.find("Matrix inversions"), std::string::npos);
+    ASSERT_NE(report.find("PrepareComputations"), std::string::npos);
+}
+
+#ifdef RAYTRACER_INSTRUMENTATION
+TEST(InstrumentationTest, TestNothrowAndAlignedAllocationsAreCounted) {
+    instrumentation::MergeThreadCounters();
+    instrumentation::ResetTotalCounters();
+
+    void* plain = ::operator new(16, std::nothrow);
+    void* aligned = ::operator new(100, std::align_val_t{64});
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(aligned) % 64, 0);
+    ::operator delete(plain, std::nothrow);
+    ::operator delete(aligned, 100, std::align_val_t{64});
+
+    instrumentation::MergeThreadCounters();
+    const auto totals = instrumentation::TotalCounters();
+    ASSERT_GE(totals.heap_allocations_, 2);
+    ASSERT_GE(totals.heap_bytes_, 116);
+}
+#endif
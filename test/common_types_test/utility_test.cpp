@@ -0,0 +1,37 @@
+#include "utility.h"
+#include <gtest/gtest.h>
+#include <cmath>
+
+TEST(UtilityTest, TestFastPowIsExactForIntegralExponents) {
+    for (const double base : {0.0, 0.25, 0.7071, 0.999, 1.0}) {
+        for (const double exponent : {0.0, 1.0, 2.0, 5.0, 10.0, 200.0}) {
+            ASSERT_NEAR(utility::FastPow(base, exponent), pow(base, exponent),
+                        1e-12 * pow(base, exponent) + 1e-300);
+        }
+    }
+}
+
+TEST(UtilityTest, TestFastPowIsNearPow) {
+    double max_relative_error = 0.0;
+    for (double base = 0.001; base <= 1.0; base += 0.001) {
+        for (const double exponent : {0.5, 1.7, 10.25, 57.3, 199.9, 300.5}) {
+            const double expected = pow(base, exponent);
+            if (expected < 1e-300) {
+                continue;
+            }
+            max_relative_error = std::max(
+                max_relative_error, fabs(utility::FastPow(base, exponent) - expected) / expected);
+        }
+    }
+    ASSERT_LT(max_relative_error, 2e-5);
+}
+
+TEST(UtilityTest, TestFastExp2AndLog2) {
+    for (const double x : {-1021.5, -30.3, -1.0, -0.5, -1e-9, 0.0}) {
+        ASSERT_NEAR(utility::FastExp2(x) / exp2(x), 1.0, 2e-5);
+    }
+    ASSERT_EQ(utility::FastExp2(-2000.0), 0.0);
+    for (const double x : {1e-200, 0.001, 0.3, 0.5, 0.9999, 1.0, 3.0}) {
+        ASSERT_NEAR(utility::FastLog2(x), log2(x), 2e-6);
+    }
+}
@@ -0,0 +1,166 @@
+#include "csg.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include "cube.h"
+#include "cylinder.h"
+#include "group.h"
+#include "sphere.h"
+#include "test_classes.h"
+#include "translationmatrix.h"
+
+namespace {
+using Operation = geometry::CSG::Operation;
+
+std::vector<double> TValues(const std::vector<geometry::Intersection>& xs) {
+    std::vector<double> ts{};
+    for (const auto& x : xs) {
+        ts.push_back(x.t_);
+    }
+    return ts;
+}
+}  // namespace
+
+TEST(CSGTest, TestCSGIsCreatedWithAnOperationAndTwoShapes) {
+    std::shared_ptr<geometry::Shape> s1 = std::make_shared<geometry::Sphere>();
+    std::shared_ptr<geometry::Shape> s2 = std::make_shared<geometry::Cube>();
+    const geometry::CSG c{Operation::kUnion, s1, s2};
+    ASSERT_EQ(c.operation(), Operation::kUnion);
+    ASSERT_EQ(c.left(), s1);
+    ASSERT_EQ(c.right(), s2);
+    ASSERT_EQ(s1->GetParent()->id(), c.id());
+    ASSERT_EQ(s2->GetParent()->id(), c.id());
+
+    ASSERT_THROW(geometry::CSG(Operation::kUnion, s1, std::make_shared<geometry::Sphere>()),
+                 std::invalid_argument);
+    ASSERT_THROW(geometry::CSG(Operation::kUnion, std::make_shared<geometry::Sphere>(), nullptr),
+                 std::invalid_argument);
+}
+
+TEST(CSGTest, TestEvaluatingTheRuleForCSGOperations) {
+    // (left_hit, in_left, in_right) in the order of the table on pg. 230
+    const bool cases[8][3] = {{true, true, true},   {true, true, false},  {true, false, true},
+                              {true, false, false}, {false, true, true},  {false, true, false},
+                              {false, false, true}, {false, false, false}};
+    const bool union_results[8] = {false, true, false, true, false, false, true, true};
+    const bool intersection_results[8] = {true, false, true, false, true, true, false, false};
+    const bool difference_results[8] = {false, true, false, true, true, true, false, false};
+
+    for (size_t i = 0; i < 8; ++i) {
+        const auto& [left_hit, in_left, in_right] = cases[i];
+        ASSERT_EQ(geometry::CSG::IntersectionAllowed(Operation::kUnion, left_hit, in_left,
+                                                     in_right),
+                  union_results[i]);
+        ASSERT_EQ(geometry::CSG::IntersectionAllowed(Operation::kIntersection, left_hit, in_left,
+                                                     in_right),
+                  intersection_results[i]);
+        ASSERT_EQ(geometry::CSG::IntersectionAllowed(Operation::kDifference, left_hit, in_left,
+                                                     in_right),
+                  difference_results[i]);
+    }
+}
+
+TEST(CSGTest, TestFilteringAListOfIntersections) {
+    const std::pair<Operation, std::pair<size_t, size_t>> cases[] = {
+        {Operation::kUnion, {0, 3}},
+        {Operation::kIntersection, {1, 2}},
+        {Operation::kDifference, {0, 1}}};
+
+    for (const auto& [operation, expected] : cases) {
+        std::shared_ptr<geometry::Shape> s1 = std::make_shared<geometry::Sphere>();
+        std::shared_ptr<geometry::Shape> s2 = std::make_shared<geometry::Cube>();
+        const geometry::CSG c{operation, s1, s2};
+        const std::vector<geometry::Intersection> xs{
+            geometry::Intersection{1, s1}, geometry::Intersection{2, s2},
+            geometry::Intersection{3, s1}, geometry::Intersection{4, s2}};
+
+        const auto result = c.FilterIntersections(xs);
+        ASSERT_EQ(result.size(), 2);
+        ASSERT_TRUE(result[0] == xs[expected.first]);
+        ASSERT_TRUE(result[1] == xs[expected.second]);
+    }
+}
+
+TEST(CSGTest, TestRayMissesCSGObject) {
+    const geometry::CSG c{Operation::kUnion, std::make_shared<geometry::Sphere>(),
+                          std::make_shared<geometry::Cube>()};
+    const commontypes::Ray r{commontypes::Point{0, 2, -5}, commontypes::Vector{0, 0, 1}};
+    ASSERT_TRUE(c.LocalIntersect(r).empty());
+}
+
+TEST(CSGTest, TestRayHitsCSGObject) {
+    std::shared_ptr<geometry::Shape> s1 = std::make_shared<geometry::Sphere>();
+    std::shared_ptr<geometry::Shape> s2 = std::make_shared<geometry::Sphere>();
+    s2->SetTransform(commontypes::TranslationMatrix{0, 0, 0.5});
+    const geometry::CSG c{Operation::kUnion, s1, s2};
+    const commontypes::Ray r{commontypes::Point{0, 0, -5}, commontypes::Vector{0, 0, 1}};
+
+    const auto xs = c.LocalIntersect(r);
+    ASSERT_EQ(xs.size(), 2);
+    ASSERT_DOUBLE_EQ(xs[0].t_, 4);
+    ASSERT_EQ(xs[0].object_->id(), s1->id());
+    ASSERT_DOUBLE_EQ(xs[1].t_, 6.5);
+    ASSERT_EQ(xs[1].object_->id(), s2->id());
+}
+
+TEST(CSGTest, TestMergedIntersectionsMatchFilteringTheSortedList) {
+    for (const auto operation :
+         {Operation::kUnion, Operation::kIntersection, Operation::kDifference}) {
+        // a capped Cylinder's intersections aren't returned in ascending order
+        std::shared_ptr<geometry::Shape> cylinder =
+            std::make_shared<geometry::Cylinder>(-0.5, 0.5, true);
+        auto group = std::make_shared<geometry::Group>();
+        std::shared_ptr<geometry::Shape> s1 = std::make_shared<geometry::Sphere>();
+        std::shared_ptr<geometry::Shape> s2 = std::make_shared<geometry::Sphere>();
+        s1->SetTransform(commontypes::TranslationMatrix{0, 0, -0.7});
+        s2->SetTransform(commontypes::TranslationMatrix{0, 0, 0.7});
+        group->AddChildToGroup(s1);
+        group->AddChildToGroup(s2);
+        const geometry::CSG c{operation, cylinder, group};
+
+        for (double y = -0.6; y < 0.6; y += 0.15) {
+            const commontypes::Ray r{commontypes::Point{0.1, y, -5},
+                                     commontypes::Vector{0, 0.1, 1}};
+            std::vector<geometry::Intersection> all = cylinder->Intersect(r);
+            const auto group_xs = group->Intersect(r);
+            all.insert(all.end(), group_xs.begin(), group_xs.end());
+            std::sort(all.begin(), all.end(),
+                      [](const auto& lhs, const auto& rhs) { return lhs.t_ < rhs.t_; });
+
+            ASSERT_EQ(TValues(c.LocalIntersect(r)), TValues(c.FilterIntersections(all)));
+        }
+    }
+}
+
+TEST(CSGTest, TestRightShapeIsSkippedWhenLeftIsMissed) {
+    for (const auto operation : {Operation::kIntersection, Operation::kDifference}) {
+        auto right = std::make_shared<geometry::TestShape>();
+        const geometry::CSG c{operation, std::make_shared<geometry::Sphere>(), right};
+        const commontypes::Ray r{commontypes::Point{0, 2, -5}, commontypes::Vector{0, 0, 1}};
+
+        ASSERT_TRUE(c.LocalIntersect(r).empty());
+        // the TestShape records the Ray it's intersected with
+        ASSERT_TRUE(right->saved_ray_.origin() == commontypes::Point{});
+    }
+
+    auto right = std::make_shared<geometry::TestShape>();
+    const geometry::CSG c{Operation::kUnion, std::make_shared<geometry::Sphere>(), right};
+    const commontypes::Ray r{commontypes::Point{0, 2, -5}, commontypes::Vector{0, 0, 1}};
+    c.LocalIntersect(r);
+    ASSERT_TRUE(right->saved_ray_.origin() == commontypes::Point(0, 2, -5));
+}
+
+TEST(CSGTest, TestCSGIncludesItsDescendants) {
+    std::shared_ptr<geometry::Shape> s1 = std::make_shared<geometry::Sphere>();
+    std::shared_ptr<geometry::Shape> s2 = std::make_shared<geometry::Sphere>();
+    auto group = std::make_shared<geometry::Group>();
+    group->AddChildToGroup(s2);
+    const geometry::CSG c{Operation::kDifference, s1, group};
+
+    ASSERT_TRUE(c.Includes(*s1));
+    ASSERT_TRUE(c.Includes(*s2));
+    ASSERT_TRUE(group->Includes(*s2));
+    ASSERT_FALSE(group->Includes(*s1));
+    ASSERT_FALSE(c.Includes(geometry::Sphere{}));
+}
@@ -1,5 +1,6 @@
 #include "group.h"
 #include <gtest/gtest.h>
+#include <thread>
 #include "scalingmatrix.h"
 #include "sphere.h"
 #include "test_classes.h"
@@ -123,4 +124,34 @@ TEST(GroupTest, TestLocalNormalAtThrowsException) {
     geometry::Group g{};
     // method should not be invoked directly (see pg. 200)
     EXPECT_THROW(g.LocalNormalAt(commontypes::Point(1, 2, 3)), IncorrectCallException);
-}
\ No newline at end of file
+}
+TEST(GroupTest, TestAddingChildrenConcurrently) {
+    auto outer = std::make_shared<geometry::Group>();
+    auto inner = std::make_shared<geometry::Group>();
+    outer->AddChildConcurrently(inner);
+
+    std::vector<std::thread> threads{};
+    for (size_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&outer, &inner]() {
+            for (size_t i = 0; i < 250; ++i) {
+                outer->AddChildConcurrently(std::make_shared<geometry::Sphere>());
+                inner->AddChildConcurrently(std::make_shared<geometry::Sphere>());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // nothing is added until the pending children are committed
+    ASSERT_TRUE(outer->GetChildren().empty());
+    outer->CommitPendingChildren();
+
+    const auto children = outer->GetChildren();
+    ASSERT_EQ(children.size(), 1001);
+    ASSERT_EQ(inner->GetChildren().size(), 1000);
+    for (const auto& child : children) {
+        ASSERT_EQ(child->GetParent(), outer.get());
+    }
+    ASSERT_EQ(inner->GetChildren()[0]->GetParent(), inner.get());
+}
@@ -0,0 +1,126 @@
+#include "instance.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include "group.h"
+#include "material.h"
+#include "rotationmatrix.h"
+#include "scalingmatrix.h"
+#include "sphere.h"
+#include "translationmatrix.h"
+
+// a scaled Group holding a translated Sphere, as on pg. 201
+static std::shared_ptr<geometry::Group> ScaledGroupWithSphere() {
+    auto group = std::make_shared<geometry::Group>();
+    group->SetTransform(commontypes::ScalingMatrix{1, 2, 3});
+    std::shared_ptr<geometry::Shape> sphere = std::make_shared<geometry::Sphere>();
+    sphere->SetTransform(commontypes::TranslationMatrix{5, 0, 0});
+    group->AddChildToGroup(sphere);
+    return group;
+}
+
+TEST(InstanceTest, TestIntersectingInstance) {
+    std::shared_ptr<geometry::Shape> sphere = std::make_shared<geometry::Sphere>();
+    geometry::Instance instance{sphere};
+    instance.SetTransform(commontypes::TranslationMatrix{5, 0, 0});
+
+    const commontypes::Ray r{commontypes::Point{5, 0, -5}, commontypes::Vector{0, 0, 1}};
+    const auto xs = instance.Intersect(r);
+    ASSERT_EQ(xs.size(), 2);
+    ASSERT_DOUBLE_EQ(xs[0].t_, 4);
+    ASSERT_DOUBLE_EQ(xs[1].t_, 6);
+    ASSERT_TRUE(*xs[0].object_ == instance);
+
+    const commontypes::Ray miss{commontypes::Point{0, 0, -5}, commontypes::Vector{0, 0, 1}};
+    ASSERT_TRUE(instance.Intersect(miss).empty());
+}
+
+TEST(InstanceTest, TestInstanceMatchesEquivalentHierarchy) {
+    // the hierarchy on pg. 201, and an Instance in place of its outer Group
+    auto outer = std::make_shared<geometry::Group>();
+    outer->SetTransform(commontypes::RotationMatrixY{M_PI_2});
+    std::shared_ptr<geometry::Shape> inner = ScaledGroupWithSphere();
+    outer->AddChildToGroup(inner);
+
+    geometry::Instance instance{ScaledGroupWithSphere()};
+    instance.SetTransform(commontypes::RotationMatrixY{M_PI_2});
+
+    for (const double y : {0.0, 0.5, 1.2}) {
+        commontypes::Ray r{commontypes::Point{0, y, -20}, commontypes::Vector{0, 0, 1}};
+        const auto expected = outer->Intersect(r);
+        const auto xs = instance.Intersect(r);
+        ASSERT_EQ(xs.size(), 2);
+        ASSERT_EQ(xs.size(), expected.size());
+
+        for (size_t i = 0; i < xs.size(); ++i) {
+            ASSERT_NEAR(xs[i].t_, expected[i].t_, utility::EPSILON_);
+            const auto comps = xs[i].PrepareComputations(r, xs);
+            const auto expected_comps = expected[i].PrepareComputations(r, expected);
+            ASSERT_TRUE(comps.normal_vector_ == expected_comps.normal_vector_);
+        }
+    }
+}
+
+TEST(InstanceTest, TestInstancesShareTheirPrototype) {
+    const std::shared_ptr<const geometry::Shape> prototype = ScaledGroupWithSphere();
+    std::vector<geometry::Instance> instances{};
+    for (size_t i = 0; i < 100; ++i) {
+        instances.emplace_back(prototype);
+        instances.back().SetTransform(commontypes::TranslationMatrix{0, 0, 10.0 * i});
+    }
+
+    ASSERT_EQ(prototype.use_count(), 101);
+    ASSERT_EQ(instances[0].prototype(), instances[99].prototype());
+}
+
+TEST(InstanceTest, TestInstanceMaterials) {
+    auto sphere = std::make_shared<geometry::Sphere>();
+    sphere->Material()->SetColor(commontypes::Color{1, 0, 0});
+    geometry::Instance instance{sphere};
+    const commontypes::Ray r{commontypes::Point{0, 0, -5}, commontypes::Vector{0, 0, 1}};
+
+    // the prototype's Material, unless overridden
+    ASSERT_EQ(instance.Intersect(r)[0].object_->Material(), sphere->Material());
+
+    auto material = std::make_shared<lighting::Material>();
+    instance.SetMaterialOverride(material);
+    ASSERT_EQ(instance.Intersect(r)[0].object_->Material(), material);
+    ASSERT_TRUE(sphere->Material()->Color() == commontypes::Color(1, 0, 0));
+}
+
+TEST(InstanceTest, TestPrototypeMustNotBelongToGroup) {
+    geometry::Group group{};
+    std::shared_ptr<geometry::Shape> sphere = std::make_shared<geometry::Sphere>();
+    group.AddChildToGroup(sphere);
+
+    ASSERT_THROW(geometry::Instance{sphere}, std::invalid_argument);
+    ASSERT_THROW(geometry::Instance{nullptr}, std::invalid_argument);
+}
+
+TEST(InstanceTest, TestRefractiveIndicesWithinInstancedNestedGlass) {
+    // a glass Sphere holding a denser Sphere, both within one instanced prototype (as on pg. 152)
+    std::shared_ptr<geometry::Shape> outer =
+        std::make_shared<geometry::Sphere>(geometry::Sphere::GlassSphere());
+    outer->SetTransform(commontypes::ScalingMatrix{2, 2, 2});
+    std::shared_ptr<geometry::Shape> inner =
+        std::make_shared<geometry::Sphere>(geometry::Sphere::GlassSphere());
+    inner->SetMaterial(std::make_shared<lighting::Material>());
+    inner->Material()->SetTransparency(1.0);
+    inner->Material()->SetRefractiveIndex(2.0);
+    auto prototype = std::make_shared<geometry::Group>();
+    prototype->AddChildToGroup(outer);
+    prototype->AddChildToGroup(inner);
+    geometry::Instance instance{prototype};
+    instance.SetTransform(commontypes::TranslationMatrix{0, 0, 1});
+
+    commontypes::Ray r{commontypes::Point{0, 0, -4}, commontypes::Vector{0, 0, 1}};
+    const auto xs = instance.Intersect(r);
+    ASSERT_EQ(xs.size(), 4);
+
+    // into the outer Sphere, into the inner one, then out of each
+    const double expected[4][2] = {{1.0, 1.5}, {1.5, 2.0}, {2.0, 1.5}, {1.5, 1.0}};
+    for (size_t i = 0; i < xs.size(); ++i) {
+        const auto comps = xs[i].PrepareComputations(r, xs);
+        ASSERT_DOUBLE_EQ(comps.n1, expected[i][0]);
+        ASSERT_DOUBLE_EQ(comps.n2, expected[i][1]);
+    }
+}
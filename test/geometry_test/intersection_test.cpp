@@ -256,3 +256,25 @@ TEST(IntersectionTest, TestSchlickApproximationWithSmallAngleAndN2GreaterThanN1)
     // expand this value quite a bit to get eq to pass
     ASSERT_DOUBLE_EQ(reflectance, 0.48873081012212183);
 }
+
+TEST(IntersectionTest, TestMergingRunsKeepsIntersectionsAscending) {
+    const auto s = std::make_shared<geometry::Sphere>();
+    std::vector<geometry::Intersection> xs{};
+    // short runs (one out of order, as a capped Cylinder's may be) and a long one
+    const std::vector<std::vector<double>> runs{
+        {2, 5}, {-1, 3}, {4, 1.5, 6}, {0.5, 0.7, 2.5, 2.7, 4.5, 7, 8}, {}, {9}};
+    for (const auto& run : runs) {
+        const size_t run_begin = xs.size();
+        for (const double t : run) {
+            xs.emplace_back(t, s);
+        }
+        geometry::MergeIntersections(xs, run_begin);
+    }
+
+    const std::vector<double> expected{-1, 0.5, 0.7, 1.5, 2, 2.5, 2.7, 3,
+                                       4,  4.5, 5,   6,   7, 8,   9};
+    ASSERT_EQ(xs.size(), expected.size());
+    for (size_t i = 0; i < xs.size(); ++i) {
+        ASSERT_DOUBLE_EQ(xs[i].t_, expected[i]);
+    }
+}
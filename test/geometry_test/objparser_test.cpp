@@ -0,0 +1,196 @@
+#include "objparser.h"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include "smoothtriangle.h"
+#include "triangle.h"
+
+static std::shared_ptr<geometry::Triangle> TriangleAt(
+    const std::shared_ptr<geometry::Group>& group,
+    const size_t idx) {
+    return std::dynamic_pointer_cast<geometry::Triangle>(group->GetChildren().at(idx));
+}
+
+TEST(ObjParserTest, TestIgnoringUnrecognizedLines) {
+    const auto parser = geometry::ObjParser::ParseString(
+        "There was a young lady named Bright\n"
+        "who traveled much faster than light.\n"
+        "She set out one day\n"
+        "in a relative way,\n"
+        "and came back the previous night.\n");
+    ASSERT_EQ(parser.ignored_lines(), 5);
+}
+
+TEST(ObjParserTest, TestVertexRecords) {
+    const auto parser = geometry::ObjParser::ParseString(
+        "v -1 1 0\n"
+        "v -1.0000 0.5000 0.0000\n"
+        "v 1 0 0\n"
+        "v 1 1 0\n");
+    ASSERT_EQ(parser.n_vertices(), 4);
+    ASSERT_TRUE(parser.Vertex(1) == commontypes::Point(-1, 1, 0));
+    ASSERT_TRUE(parser.Vertex(2) == commontypes::Point(-1, 0.5, 0));
+    ASSERT_TRUE(parser.Vertex(3) == commontypes::Point(1, 0, 0));
+    ASSERT_TRUE(parser.Vertex(4) == commontypes::Point(1, 1, 0));
+}
+
+TEST(ObjParserTest, TestParsingTriangleFaces) {
+    const auto parser = geometry::ObjParser::ParseString(
+        "v -1 1 0\n"
+        "v -1 0 0\n"
+        "v 1 0 0\n"
+        "v 1 1 0\n"
+        "\n"
+        "f 1 2 3\n"
+        "f 1 3 4\n");
+    const auto group = parser.DefaultGroup();
+    const auto t1 = TriangleAt(group, 0);
+    const auto t2 = TriangleAt(group, 1);
+
+    ASSERT_TRUE(t1->P1() == parser.Vertex(1));
+    ASSERT_TRUE(t1->P2() == parser.Vertex(2));
+    ASSERT_TRUE(t1->P3() == parser.Vertex(3));
+    ASSERT_TRUE(t2->P1() == parser.Vertex(1));
+    ASSERT_TRUE(t2->P2() == parser.Vertex(3));
+    ASSERT_TRUE(t2->P3() == parser.Vertex(4));
+    ASSERT_EQ(t1->GetParent(), group.get());
+
+    // one Material for the whole model
+    ASSERT_EQ(t1->Material(), t2->Material());
+}
+
+TEST(ObjParserTest, TestTriangulatingPolygons) {
+    const auto parser = geometry::ObjParser::ParseString(
+        "v -1 1 0\n"
+        "v -1 0 0\n"
+        "v 1 0 0\n"
+        "v 1 1 0\n"
+        "v 0 2 0\n"
+        "\n"
+        "f 1 2 3 4 5\n");
+    const auto group = parser.DefaultGroup();
+    ASSERT_EQ(parser.n_triangles(), 3);
+
+    for (size_t i = 0; i < 3; ++i) {
+        const auto t = TriangleAt(group, i);
+        ASSERT_TRUE(t->P1() == parser.Vertex(1));
+        ASSERT_TRUE(t->P2() == parser.Vertex(i + 2));
+        ASSERT_TRUE(t->P3() == parser.Vertex(i + 3));
+    }
+}
+
+TEST(ObjParserTest, TestTrianglesInGroups) {
+    const auto parser = geometry::ObjParser::ParseString(
+        "v -1 1 0\n"
+        "v -1 0 0\n"
+        "v 1 0 0\n"
+        "v 1 1 0\n"
+        "g FirstGroup\n"
+        "f 1 2 3\n"
+        "g SecondGroup\n"
+        "f 1 3 4\n");
+    const auto g1 = parser.NamedGroup("FirstGroup");
+    const auto g2 = parser.NamedGroup("SecondGroup");
+    ASSERT_NE(g1, nullptr);
+    ASSERT_NE(g2, nullptr);
+    ASSERT_EQ(parser.NamedGroup("ThirdGroup"), nullptr);
+    ASSERT_TRUE(parser.DefaultGroup()->GetChildren().empty());
+
+    ASSERT_TRUE(TriangleAt(g1, 0)->P3() == parser.Vertex(3));
+    ASSERT_TRUE(TriangleAt(g2, 0)->P3() == parser.Vertex(4));
+}
+
+TEST(ObjParserTest, TestConvertingToGroup) {
+    const auto parser = geometry::ObjParser::ParseString(
+        "v -1 1 0\n"
+        "v -1 0 0\n"
+        "v 1 0 0\n"
+        "v 1 1 0\n"
+        "g FirstGroup\n"
+        "f 1 2 3\n"
+        "g SecondGroup\n"
+        "f 1 3 4\n");
+    const auto group = parser.ToGroup();
+    const auto children = group->GetChildren();
+    ASSERT_EQ(children.size(), 2);
+    ASSERT_EQ(children[0], parser.NamedGroup("FirstGroup"));
+    ASSERT_EQ(children[1], parser.NamedGroup("SecondGroup"));
+}
+
+TEST(ObjParserTest, TestVertexNormalsAndIndexForms) {
+    const auto parser = geometry::ObjParser::ParseString(
+        "v 0 1 0\r\n"
+        "v -1 0 0\r\n"
+        "v 1 0 0\r\n"
+        "vn -1 0 0\r\n"
+        "vn 1 0 0\r\n"
+        "vn 0 1 0\r\n"
+        "f 1//3 2//1 3//2\r\n"
+        "f 1/1/3 2/2/1 3/3/2\r\n"
+        "f -3 -2 -1\r\n");
+    ASSERT_EQ(parser.n_normals(), 3);
+    ASSERT_TRUE(parser.Normal(1) == commontypes::Vector(-1, 0, 0));
+    ASSERT_EQ(parser.n_triangles(), 3);
+
+    // relative indices count back from the last vertex
+    const auto t = TriangleAt(parser.DefaultGroup(), 2);
+    ASSERT_TRUE(t->P1() == parser.Vertex(1));
+    ASSERT_TRUE(t->P3() == parser.Vertex(3));
+}
+
+TEST(ObjParserTest, TestFacesWithNormals) {
+    const auto parser = geometry::ObjParser::ParseString(
+        "v 0 1 0\n"
+        "v -1 0 0\n"
+        "v 1 0 0\n"
+        "vn -1 0 0\n"
+        "vn 1 0 0\n"
+        "vn 0 1 0\n"
+        "f 1//3 2//1 3//2\n"
+        "f 1/0/3 2/102/1 3/14/2\n"
+        "f 1 2 3\n");
+    const auto children = parser.DefaultGroup()->GetChildren();
+
+    // as on pg. 224; the texture vertex indices are ignored
+    for (const size_t idx : {0, 1}) {
+        const auto t = std::dynamic_pointer_cast<geometry::SmoothTriangle>(children[idx]);
+        ASSERT_NE(t, nullptr);
+        ASSERT_TRUE(t->P1() == parser.Vertex(1));
+        ASSERT_TRUE(t->N1() == parser.Normal(3));
+        ASSERT_TRUE(t->N2() == parser.Normal(1));
+        ASSERT_TRUE(t->N3() == parser.Normal(2));
+    }
+
+    ASSERT_EQ(std::dynamic_pointer_cast<geometry::SmoothTriangle>(children[2]), nullptr);
+}
+
+TEST(ObjParserTest, TestMalformedStatements) {
+    ASSERT_THROW(geometry::ObjParser::ParseString("v 1 2\n"), geometry::ObjParseError);
+    ASSERT_THROW(geometry::ObjParser::ParseString("v 1 2 3\nv 1 2 3\nf 1 2\n"),
+                 geometry::ObjParseError);
+    ASSERT_THROW(geometry::ObjParser::ParseString("v 1 2 3\nv 1 2 3\nv 1 2 3\nf 1 2 4\n"),
+                 geometry::ObjParseError);
+
+    try {
+        geometry::ObjParser::ParseString("v 0 0 0\n\nf 1 x 1\n");
+        FAIL() << "expected an ObjParseError for the invalid index";
+    } catch (const geometry::ObjParseError& e) {
+        ASSERT_STREQ(e.what(), "line 3: invalid index 'x'");
+    }
+}
+
+TEST(ObjParserTest, TestParsingFile) {
+    const auto path = std::filesystem::temp_directory_path() / "objparser_test.obj";
+    {
+        std::ofstream out{path};
+        out << "# a square\nv -1 1 0\nv -1 0 0\nv 1 0 0\nv 1 1 0\nf 1 2 3 4";
+    }
+
+    const auto parser = geometry::ObjParser::ParseFile(path);
+    std::filesystem::remove(path);
+
+    ASSERT_EQ(parser.ignored_lines(), 1);
+    ASSERT_EQ(parser.n_vertices(), 4);
+    ASSERT_EQ(parser.n_triangles(), 2);
+    ASSERT_THROW(geometry::ObjParser::ParseFile(path), geometry::ObjParseError);
+}
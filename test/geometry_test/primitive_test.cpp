@@ -0,0 +1,183 @@
+#include "primitive.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include "cone.h"
+#include "cube.h"
+#include "cylinder.h"
+#include "group.h"
+#include "objparser.h"
+#include "plane.h"
+#include "rotationmatrix.h"
+#include "scalingmatrix.h"
+#include "smoothtriangle.h"
+#include "sphere.h"
+#include "translationmatrix.h"
+#include "trianglemesh.h"
+
+// one of each simple Shape, transformed, with some inside a transformed Group
+static std::vector<std::shared_ptr<geometry::Shape>> EachKindOfShape() {
+    std::shared_ptr<geometry::Shape> sphere = std::make_shared<geometry::Sphere>();
+    sphere->SetTransform(commontypes::TranslationMatrix{0.5, 0, 0} *
+                         commontypes::ScalingMatrix{1, 2, 0.5});
+
+    std::shared_ptr<geometry::Shape> plane = std::make_shared<geometry::Plane>();
+    plane->SetTransform(commontypes::RotationMatrixX{0.3} *
+                        commontypes::TranslationMatrix{0, -2, 0});
+
+    std::shared_ptr<geometry::Shape> cube = std::make_shared<geometry::Cube>();
+    cube->SetTransform(commontypes::RotationMatrixY{0.7});
+
+    std::shared_ptr<geometry::Shape> cylinder = std::make_shared<geometry::Cylinder>(-1, 1, true);
+    cylinder->SetTransform(commontypes::RotationMatrixZ{0.4});
+
+    std::shared_ptr<geometry::Shape> cone = std::make_shared<geometry::Cone>(-1, 0.5, true);
+    std::shared_ptr<geometry::Shape> open_cone = std::make_shared<geometry::Cone>(-2, 2, false);
+
+    std::shared_ptr<geometry::Shape> triangle = std::make_shared<geometry::Triangle>(
+        commontypes::Point{0, 1, 0}, commontypes::Point{-1, 0, 0}, commontypes::Point{1, 0, 0});
+    std::shared_ptr<geometry::Shape> smooth_triangle = std::make_shared<geometry::SmoothTriangle>(
+        commontypes::Point{0, 1, 1}, commontypes::Point{-1, 0, 1}, commontypes::Point{1, 0, 1},
+        commontypes::Vector{0, 1, 0}, commontypes::Vector{-1, 0, 0}, commontypes::Vector{1, 0, 0});
+
+    auto group = std::make_shared<geometry::Group>();
+    group->SetTransform(commontypes::ScalingMatrix{1.5, 1.5, 1.5});
+    for (auto& child : {cube, cylinder, triangle}) {
+        auto child_ptr = child;
+        group->AddChildToGroup(child_ptr);
+    }
+
+    return {sphere, plane, cone, open_cone, smooth_triangle, group};
+}
+
+TEST(PrimitiveTest, TestGroupsAreFlattened) {
+    geometry::PrimitiveList list{};
+    for (const auto& shape : EachKindOfShape()) {
+        list.Add(shape);
+    }
+    ASSERT_EQ(list.n_primitives(), 8);
+    ASSERT_TRUE(list.others().empty());
+
+    // meshes have no Primitive form
+    const auto mesh_data = std::make_shared<geometry::MeshData>(
+        std::vector<float>{0, -1, 1}, std::vector<float>{1, 0, 0}, std::vector<float>{0, 0, 0},
+        std::vector<uint32_t>{0, 1, 2});
+    list.Add(std::make_shared<geometry::TriangleMesh>(mesh_data));
+    ASSERT_EQ(list.others().size(), 1);
+
+    list.Clear();
+    ASSERT_EQ(list.n_primitives(), 0);
+}
+
+TEST(PrimitiveTest, TestPrimitivesMatchShapes) {
+    const auto shapes = EachKindOfShape();
+    geometry::PrimitiveList list{};
+    for (const auto& shape : shapes) {
+        shape->CacheTransforms();
+        list.Add(shape);
+    }
+
+    for (size_t i = 0; i < 200; ++i) {
+        const double angle = 0.1 * i;
+        const commontypes::Point origin{5 * std::cos(angle), 0.3 * std::sin(3 * angle), -5};
+        const commontypes::Vector direction{-std::cos(angle), 0.02 * i, std::sin(angle) + 1};
+        commontypes::Ray ray{origin, commontypes::Vector{direction.Normalize()}};
+
+        std::vector<geometry::Intersection> expected{};
+        for (const auto& shape : shapes) {
+            const auto xs = shape->Intersect(ray);
+            expected.insert(expected.end(), xs.begin(), xs.end());
+        }
+        std::vector<geometry::Intersection> xs{};
+        list.Intersect(ray, xs);
+
+        const auto by_t = [](const auto& lhs, const auto& rhs) { return lhs.t_ < rhs.t_; };
+        std::stable_sort(expected.begin(), expected.end(), by_t);
+        std::stable_sort(xs.begin(), xs.end(), by_t);
+
+        ASSERT_EQ(xs.size(), expected.size());
+        for (size_t hit = 0; hit < xs.size(); ++hit) {
+            ASSERT_NEAR(xs[hit].t_, expected[hit].t_, 1e-9);
+            ASSERT_TRUE(*xs[hit].object_ == *expected[hit].object_);
+            ASSERT_NEAR(xs[hit].u_, expected[hit].u_, 1e-9);
+            ASSERT_NEAR(xs[hit].v_, expected[hit].v_, 1e-9);
+
+            // at the same point, as the t values may differ in the last few bits (which
+            // matters at a cube's edges)
+            const commontypes::Point point = ray.Position(expected[hit].t_);
+            ASSERT_TRUE(xs[hit].object_->NormalAt(point, xs[hit]) ==
+                        expected[hit].object_->NormalAt(point, expected[hit]));
+        }
+    }
+}
+
+TEST(PrimitiveTest, TestFindingOccluders) {
+    auto sphere = std::make_shared<geometry::Sphere>();
+    sphere->SetTransform(commontypes::TranslationMatrix{0, 5, 0});
+    auto mesh = geometry::ObjParser::ParseString("v -1 2 -1\nv 1 2 -1\nv 0 2 1\nf 1 2 3\n",
+                                                 geometry::ObjParser::Output::kMesh)
+                    .ToMesh();
+
+    geometry::PrimitiveList list{};
+    list.Add(sphere);
+    list.Add(mesh);
+    ASSERT_EQ(list.n_primitives(), 1);
+
+    // toward a light above both, one directly above the sphere only, and one past neither
+    const commontypes::Point origin{0, 0, 0};
+    commontypes::ArenaVector<geometry::ShadowRay> rays{
+        {commontypes::Vector{0, 1, 0}, 10, false},
+        {commontypes::Vector{0, 1, 0}, 3, false},
+        {commontypes::Vector{1, 0, 0}, 10, false}};
+    list.FindOccluded(origin, rays);
+
+    ASSERT_TRUE(rays[0].occluded_);
+    ASSERT_FALSE(rays[2].occluded_);
+    ASSERT_EQ(rays[2].occluder_, geometry::ShadowRay::NO_OCCLUDER);
+
+    // the triangle, at y = 2, is the only occluder of the shorter ray
+    ASSERT_TRUE(rays[1].occluded_);
+    ASSERT_EQ(rays[1].occluder_, 1);
+    ASSERT_TRUE(list.Occludes(1, origin, rays[1]));
+    ASSERT_FALSE(list.Occludes(0, origin, rays[1]));
+    ASSERT_TRUE(list.Occludes(0, origin, rays[0]));
+}
+
+TEST(PrimitiveTest, TestRefitUpdatesOnlyTransformedShapes) {
+    const auto shapes = EachKindOfShape();
+    geometry::PrimitiveList list{};
+    for (const auto& shape : shapes) {
+        shape->CacheTransforms();
+        list.Add(shape);
+    }
+    ASSERT_EQ(list.Refit(), 0);
+
+    // a Group's transform moves each of its children
+    size_t n_moved = 0;
+    for (const auto& shape : shapes) {
+        if (auto* group = dynamic_cast<geometry::Group*>(shape.get())) {
+            group->SetTransform(commontypes::RotationMatrixY{0.3} * group->GetTransform());
+            n_moved += group->GetChildren().size();
+        }
+    }
+    shapes.front()->SetTransform(commontypes::TranslationMatrix{0, 1, 0});
+    ASSERT_EQ(list.Refit(), n_moved + 1);
+
+    geometry::PrimitiveList rebuilt{};
+    for (const auto& shape : shapes) {
+        rebuilt.Add(shape);
+    }
+    for (size_t i = 0; i < 50; ++i) {
+        const double angle = 0.13 * i;
+        commontypes::Ray ray{commontypes::Point{5 * std::cos(angle), 0.2, -5},
+                             commontypes::Vector{-std::cos(angle), 0.01 * i, 1}};
+        std::vector<geometry::Intersection> xs{};
+        list.Intersect(ray, xs);
+        std::vector<geometry::Intersection> expected{};
+        rebuilt.Intersect(ray, expected);
+
+        ASSERT_EQ(xs.size(), expected.size());
+        for (size_t hit = 0; hit < xs.size(); ++hit) {
+            ASSERT_DOUBLE_EQ(xs[hit].t_, expected[hit].t_);
+        }
+    }
+}
@@ -1,6 +1,7 @@
 #include "shape.h"
 #include <gtest/gtest.h>
 #include <memory>
+#include <thread>
 #include "group.h"
 #include "identitymatrix.h"
 #include "material.h"
@@ -24,6 +25,30 @@ TEST(ShapeTest, TestEachShapeHasUniqueId) {
     ASSERT_EQ(shape_id_set.size(), n_elems);
 }
 
+TEST(ShapeTest, TestShapesConstructedOnManyThreadsHaveUniqueIds) {
+    const size_t n_threads{4};
+    const size_t n_shapes_per_thread{3000};
+    std::vector<std::vector<uint64_t>> ids(n_threads);
+
+    std::vector<std::thread> threads{};
+    for (size_t t = 0; t < n_threads; ++t) {
+        threads.emplace_back([&ids, t, n_shapes_per_thread]() {
+            for (size_t i = 0; i < n_shapes_per_thread; ++i) {
+                ids[t].push_back(geometry::TestShape{}.id());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::set<uint64_t> shape_id_set{};
+    for (const auto& thread_ids : ids) {
+        shape_id_set.insert(thread_ids.begin(), thread_ids.end());
+    }
+    ASSERT_EQ(shape_id_set.size(), n_threads * n_shapes_per_thread);
+}
+
 TEST(ShapeTest, TestTheDefaultTransformation) {
     geometry::TestShape s{};
     ASSERT_TRUE(s.Transform() == commontypes::IdentityMatrix());
@@ -146,3 +171,51 @@ TEST(ShapeTest, TestFindingTheNormalOnChildObject) {
 
     ASSERT_TRUE(n == commontypes::Vector(0.2857, 0.4286, -0.8571));
 }
+
+TEST(ShapeTest, TestCachedTransformsMatchParentChain) {
+    geometry::Group g1{};
+    g1.SetTransform(commontypes::RotationMatrixY{M_PI_2});
+
+    std::shared_ptr<geometry::Shape> group2_ptr = std::make_shared<geometry::Group>();
+    group2_ptr->SetTransform(commontypes::ScalingMatrix{1, 2, 3});
+    g1.AddChildToGroup(group2_ptr);
+
+    std::shared_ptr<geometry::Shape> sphere_ptr = std::make_shared<geometry::Sphere>();
+    sphere_ptr->SetTransform(commontypes::TranslationMatrix{5, 0, 0});
+    dynamic_cast<geometry::Group*>(group2_ptr.get())->AddChildToGroup(sphere_ptr);
+
+    const commontypes::Point world_point{1.7321, 1.1547, -5.5774};
+    const commontypes::Point expected_point = sphere_ptr->WorldToObject(world_point);
+    const commontypes::Vector expected_normal = sphere_ptr->NormalAt(world_point);
+
+    g1.CacheTransforms();
+    ASSERT_TRUE(g1.HasCachedTransforms());
+    ASSERT_TRUE(sphere_ptr->HasCachedTransforms());
+    ASSERT_TRUE(sphere_ptr->WorldToObject(world_point) == expected_point);
+    ASSERT_TRUE(sphere_ptr->NormalAt(world_point) == expected_normal);
+    ASSERT_TRUE(sphere_ptr->NormalAt(world_point) ==
+                commontypes::Vector(0.2857, 0.42854, -0.85716));
+}
+
+TEST(ShapeTest, TestSettingTransformInvalidatesDescendantsCaches) {
+    geometry::Group g1{};
+    std::shared_ptr<geometry::Shape> sphere_ptr = std::make_shared<geometry::Sphere>();
+    g1.AddChildToGroup(sphere_ptr);
+    g1.CacheTransforms();
+
+    // only the Shape and those beneath it
+    sphere_ptr->SetTransform(commontypes::ScalingMatrix{2, 2, 2});
+    ASSERT_TRUE(g1.HasCachedTransforms());
+    ASSERT_FALSE(sphere_ptr->HasCachedTransforms());
+
+    g1.CacheTransforms();
+    g1.SetTransform(commontypes::TranslationMatrix{5, 0, 0});
+    ASSERT_FALSE(g1.HasCachedTransforms());
+    ASSERT_FALSE(sphere_ptr->HasCachedTransforms());
+
+    // the new transform applies whether or not the cache has been rebuilt
+    const commontypes::Point expected{0, 0, -0.5};
+    ASSERT_TRUE(sphere_ptr->WorldToObject(commontypes::Point{5, 0, -1}) == expected);
+    g1.CacheTransforms();
+    ASSERT_TRUE(sphere_ptr->WorldToObject(commontypes::Point{5, 0, -1}) == expected);
+}
@@ -0,0 +1,59 @@
+#include "smoothtriangle.h"
+#include <gtest/gtest.h>
+#include <cmath>
+
+// the triangle used for each of the tests on pg. 222
+static geometry::SmoothTriangle DefaultSmoothTriangle() {
+    return geometry::SmoothTriangle{commontypes::Point{0, 1, 0},   commontypes::Point{-1, 0, 0},
+                                    commontypes::Point{1, 0, 0},   commontypes::Vector{0, 1, 0},
+                                    commontypes::Vector{-1, 0, 0}, commontypes::Vector{1, 0, 0}};
+}
+
+TEST(SmoothTriangleTest, TestConstructingSmoothTriangle) {
+    const geometry::SmoothTriangle tri = DefaultSmoothTriangle();
+
+    ASSERT_TRUE(tri.P1() == commontypes::Point(0, 1, 0));
+    ASSERT_TRUE(tri.P2() == commontypes::Point(-1, 0, 0));
+    ASSERT_TRUE(tri.P3() == commontypes::Point(1, 0, 0));
+    ASSERT_TRUE(tri.N1() == commontypes::Vector(0, 1, 0));
+    ASSERT_TRUE(tri.N2() == commontypes::Vector(-1, 0, 0));
+    ASSERT_TRUE(tri.N3() == commontypes::Vector(1, 0, 0));
+}
+
+TEST(SmoothTriangleTest, TestIntersectionCanEncapsulateUAndV) {
+    const std::shared_ptr<geometry::Shape> tri = std::make_shared<geometry::Triangle>(
+        commontypes::Point{0, 1, 0}, commontypes::Point{-1, 0, 0}, commontypes::Point{1, 0, 0});
+    const geometry::Intersection i{3.5, tri, 0.2, 0.4};
+
+    ASSERT_DOUBLE_EQ(i.u_, 0.2);
+    ASSERT_DOUBLE_EQ(i.v_, 0.4);
+}
+
+TEST(SmoothTriangleTest, TestIntersectionWithSmoothTriangleStoresUAndV) {
+    const geometry::SmoothTriangle tri = DefaultSmoothTriangle();
+    const commontypes::Ray r{commontypes::Point{-0.2, 0.3, -2}, commontypes::Vector{0, 0, 1}};
+
+    const auto xs = tri.LocalIntersect(r);
+    ASSERT_EQ(xs.size(), 1);
+    ASSERT_NEAR(xs[0].u_, 0.45, utility::EPSILON_);
+    ASSERT_NEAR(xs[0].v_, 0.25, utility::EPSILON_);
+}
+
+TEST(SmoothTriangleTest, TestSmoothTriangleUsesUAndVToInterpolateNormal) {
+    const std::shared_ptr<geometry::Shape> tri =
+        std::make_shared<geometry::SmoothTriangle>(DefaultSmoothTriangle());
+    const geometry::Intersection i{1, tri, 0.45, 0.25};
+
+    const commontypes::Vector n = tri->NormalAt(commontypes::Point{0, 0, 0}, i);
+    ASSERT_TRUE(n == commontypes::Vector(-0.5547, 0.83205, 0));
+}
+
+TEST(SmoothTriangleTest, TestPreparingNormalOnSmoothTriangle) {
+    const std::shared_ptr<geometry::Shape> tri =
+        std::make_shared<geometry::SmoothTriangle>(DefaultSmoothTriangle());
+    const geometry::Intersection i{1, tri, 0.45, 0.25};
+    commontypes::Ray r{commontypes::Point{-0.2, 0.3, -2}, commontypes::Vector{0, 0, 1}};
+
+    const geometry::Computations comps = i.PrepareComputations(r, {i});
+    ASSERT_TRUE(comps.normal_vector_ == commontypes::Vector(-0.5547, 0.83205, 0));
+}
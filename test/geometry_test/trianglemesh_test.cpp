@@ -0,0 +1,142 @@
+#include "trianglemesh.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+#include "group.h"
+#include "objparser.h"
+#include "triangle.h"
+
+// the triangle from the book's Triangle tests
+static std::shared_ptr<const geometry::MeshData> SingleTriangleMesh() {
+    return std::make_shared<const geometry::MeshData>(
+        std::vector<float>{0, -1, 1}, std::vector<float>{1, 0, 0}, std::vector<float>{0, 0, 0},
+        std::vector<uint32_t>{0, 1, 2});
+}
+
+// a bumpy n x n grid of quads in the xz plane, as OBJ text
+static std::string GridObj(const size_t n) {
+    std::string obj{};
+    for (size_t i = 0; i <= n; ++i) {
+        for (size_t j = 0; j <= n; ++j) {
+            obj += "v " + std::to_string(i * 0.25) + " " + std::to_string(std::sin(i + 2.0 * j)) +
+                   " " + std::to_string(j * 0.25) + "\n";
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            const size_t v = i * (n + 1) + j + 1;
+            obj += "f " + std::to_string(v) + " " + std::to_string(v + 1) + " " +
+                   std::to_string(v + n + 2) + " " + std::to_string(v + n + 1) + "\n";
+        }
+    }
+    return obj;
+}
+
+TEST(TriangleMeshTest, TestConstructingMeshData) {
+    const auto mesh_data = SingleTriangleMesh();
+    ASSERT_EQ(mesh_data->n_vertices(), 3);
+    ASSERT_EQ(mesh_data->n_triangles(), 1);
+    ASSERT_EQ(mesh_data->n_bvh_nodes(), 1);
+    ASSERT_TRUE(mesh_data->TriangleVertex(0, 1) == commontypes::Point(-1, 0, 0));
+    ASSERT_TRUE(mesh_data->TriangleNormal(0) == commontypes::Vector(0, 0, -1));
+}
+
+TEST(TriangleMeshTest, TestRayMissesMesh) {
+    const geometry::TriangleMesh mesh{SingleTriangleMesh()};
+
+    // parallel, then past each of the three edges
+    for (const auto& ray :
+         {commontypes::Ray{commontypes::Point{0, -1, -2}, commontypes::Vector{0, 1, 0}},
+          commontypes::Ray{commontypes::Point{1, 1, -2}, commontypes::Vector{0, 0, 1}},
+          commontypes::Ray{commontypes::Point{-1, 1, -2}, commontypes::Vector{0, 0, 1}},
+          commontypes::Ray{commontypes::Point{0, -1, -2}, commontypes::Vector{0, 0, 1}}}) {
+        ASSERT_TRUE(mesh.LocalIntersect(ray).empty());
+    }
+}
+
+TEST(TriangleMeshTest, TestRayStrikesMesh) {
+    const geometry::TriangleMesh mesh{SingleTriangleMesh()};
+    const commontypes::Ray ray{commontypes::Point{0, 0.5, -2}, commontypes::Vector{0, 0, 1}};
+
+    const auto xs = mesh.LocalIntersect(ray);
+    ASSERT_EQ(xs.size(), 1);
+    ASSERT_DOUBLE_EQ(xs[0].t_, 2);
+    // the hit refers to the mesh itself rather than a copy of it
+    ASSERT_EQ(xs[0].object_.get(), &mesh);
+    ASSERT_EQ(xs[0].triangle_idx_, 0);
+    ASSERT_TRUE(xs[0].object_->NormalAt(commontypes::Point{0, 0.5, 0}, xs[0]) ==
+                commontypes::Vector(0, 0, -1));
+    ASSERT_THROW(mesh.LocalNormalAt(commontypes::Point{0, 0.5, 0}), std::logic_error);
+}
+
+TEST(TriangleMeshTest, TestMeshMatchesTriangles) {
+    const std::string obj = GridObj(12);
+    const auto triangles = geometry::ObjParser::ParseString(obj).DefaultGroup();
+    const auto parser = geometry::ObjParser::ParseString(obj, geometry::ObjParser::Output::kMesh);
+    ASSERT_TRUE(parser.DefaultGroup()->GetChildren().empty());
+
+    ASSERT_THROW(geometry::ObjParser::ParseString(obj).ToMesh(), std::logic_error);
+
+    const auto mesh = parser.ToMesh();
+    ASSERT_EQ(mesh->mesh()->n_triangles(), 2 * 12 * 12);
+    ASSERT_GT(mesh->mesh()->n_bvh_nodes(), 1);
+
+    // rays from above, at an angle, and along the grid from the side
+    for (size_t i = 0; i < 50; ++i) {
+        const double x = 0.0625 + 0.06 * i;
+        const double z = 3 - 0.055 * i;
+        for (const auto& ray :
+             {commontypes::Ray{commontypes::Point{x, 5, z}, commontypes::Vector{0, -1, 0}},
+              commontypes::Ray{commontypes::Point{x, 5, z},
+                               commontypes::Vector{commontypes::Vector{0.3, -1, 0.2}.Normalize()}},
+              commontypes::Ray{commontypes::Point{-1, 0.1, z}, commontypes::Vector{1, 0, 0}}}) {
+            const auto expected = triangles->Intersect(ray);
+            const auto xs = mesh->Intersect(ray);
+            ASSERT_EQ(xs.size(), expected.size());
+
+            for (size_t hit = 0; hit < xs.size(); ++hit) {
+                ASSERT_NEAR(xs[hit].t_, expected[hit].t_, 1e-5);
+                const commontypes::Point point = ray.Position(xs[hit].t_);
+                ASSERT_EQ(xs[hit].object_.get(), mesh.get());
+                ASSERT_TRUE(xs[hit].object_->NormalAt(point, xs[hit]) ==
+                            expected[hit].object_->NormalAt(point));
+            }
+        }
+    }
+}
+
+TEST(TriangleMeshTest, TestMeshesShareMeshData) {
+    const auto mesh_data = SingleTriangleMesh();
+    const geometry::TriangleMesh m1{mesh_data};
+    const geometry::TriangleMesh m2{mesh_data};
+    ASSERT_EQ(m1.mesh(), m2.mesh());
+    ASSERT_FALSE(m1 == m2);
+
+    // three vertices and indices, and a single node
+    ASSERT_LE(mesh_data->MemoryBytes(), 3 * 3 * sizeof(float) + 3 * sizeof(uint32_t) + 32);
+}
+
+TEST(TriangleMeshTest, TestMeshInterpolatesVertexNormals) {
+    const std::string obj =
+        "v 0 1 0\nv -1 0 0\nv 1 0 0\nv 0 -1 0\n"
+        "vn 0 1 0\nvn -1 0 0\nvn 1 0 0\n"
+        "f 1//1 2//2 3//3\nf 2 4 3\n";
+    const auto mesh =
+        geometry::ObjParser::ParseString(obj, geometry::ObjParser::Output::kMesh).ToMesh();
+    const auto smooth = geometry::ObjParser::ParseString(obj).DefaultGroup();
+
+    // through the smooth triangle, then the flat one
+    for (const double y : {0.3, -0.3}) {
+        commontypes::Ray ray{commontypes::Point{-0.2, y, -2}, commontypes::Vector{0, 0, 1}};
+        const auto xs = mesh->Intersect(ray);
+        const auto expected = smooth->Intersect(ray);
+        ASSERT_EQ(xs.size(), 1);
+        ASSERT_EQ(expected.size(), 1);
+        ASSERT_NEAR(xs[0].u_, expected[0].u_, 1e-6);
+        ASSERT_NEAR(xs[0].v_, expected[0].v_, 1e-6);
+
+        const auto comps = xs[0].PrepareComputations(ray, xs);
+        const auto expected_comps = expected[0].PrepareComputations(ray, expected);
+        ASSERT_TRUE(comps.normal_vector_ == expected_comps.normal_vector_);
+    }
+}
@@ -1,7 +1,11 @@
 #include <gtest/gtest.h>
+#include <cmath>
+#include "arealight.h"
 #include "color.h"
+#include "directionallight.h"
 #include "point.h"
 #include "pointlight.h"
+#include "spotlight.h"
 
 TEST(LightingTest, TestPointLightHasIntensityAndPosition) {
     const commontypes::Point position{0, 0, 0};
@@ -10,3 +14,109 @@ TEST(LightingTest, TestPointLightHasIntensityAndPosition) {
     ASSERT_TRUE(point_light.position() == position);
     ASSERT_TRUE(point_light.intensity() == intensity);
 }
+
+TEST(LightingTest, TestCreatingAreaLight) {
+    const commontypes::Point corner{0, 0, 0};
+    const lighting::AreaLight light{corner, commontypes::Vector{2, 0, 0}, 4,
+                                    commontypes::Vector{0, 0, 1}, 2, commontypes::Color{1, 1, 1}};
+    ASSERT_TRUE(light.corner() == corner);
+    ASSERT_TRUE(light.uvec() == commontypes::Vector(0.5, 0, 0));
+    ASSERT_EQ(light.usteps(), 4);
+    ASSERT_TRUE(light.vvec() == commontypes::Vector(0, 0, 0.5));
+    ASSERT_EQ(light.vsteps(), 2);
+    ASSERT_EQ(light.samples(), 8);
+    ASSERT_TRUE(light.position() == commontypes::Point(1, 0, 0.5));
+
+    ASSERT_THROW((lighting::AreaLight{corner, commontypes::Vector{2, 0, 0}, 0,
+                                      commontypes::Vector{0, 0, 1}, 2, commontypes::Color{}}),
+                 std::invalid_argument);
+}
+
+TEST(LightingTest, TestFindingPointsOnAreaLight) {
+    const lighting::AreaLight light{commontypes::Point{0, 0, 0}, commontypes::Vector{2, 0, 0}, 4,
+                                    commontypes::Vector{0, 0, 1}, 2, commontypes::Color{1, 1, 1}};
+
+    // the center of each cell
+    ASSERT_TRUE(light.PointOnLight(0, 0) == commontypes::Point(0.25, 0, 0.25));
+    ASSERT_TRUE(light.PointOnLight(1, 0) == commontypes::Point(0.75, 0, 0.25));
+    ASSERT_TRUE(light.PointOnLight(0, 1) == commontypes::Point(0.25, 0, 0.75));
+    ASSERT_TRUE(light.PointOnLight(2, 0) == commontypes::Point(1.25, 0, 0.25));
+    ASSERT_TRUE(light.PointOnLight(3, 1) == commontypes::Point(1.75, 0, 0.75));
+    ASSERT_TRUE(light.PointOnLight(3, 1, 0.3, 0.7) == commontypes::Point(1.65, 0, 0.85));
+}
+
+TEST(LightingTest, TestJitteredPointsStayWithinTheirCells) {
+    const lighting::AreaLight light{commontypes::Point{0, 0, 0}, commontypes::Vector{2, 0, 0}, 4,
+                                    commontypes::Vector{0, 0, 1}, 2, commontypes::Color{1, 1, 1}};
+
+    for (uint64_t seed = 0; seed < 20; ++seed) {
+        for (size_t u = 0; u < light.usteps(); ++u) {
+            for (size_t v = 0; v < light.vsteps(); ++v) {
+                const commontypes::Point p = light.JitteredPointOnLight(u, v, seed);
+                ASSERT_TRUE(p == light.JitteredPointOnLight(u, v, seed));
+                ASSERT_GE(p.x(), u * 0.5);
+                ASSERT_LT(p.x(), (u + 1) * 0.5);
+                ASSERT_GE(p.z(), v * 0.5);
+                ASSERT_LT(p.z(), (v + 1) * 0.5);
+            }
+        }
+    }
+
+    // different seeds give different points
+    ASSERT_FALSE(light.JitteredPointOnLight(1, 1, 1) == light.JitteredPointOnLight(1, 1, 2));
+}
+
+TEST(LightingTest, TestSamplingPointLight) {
+    const lighting::PointLight light{commontypes::Point{0, 10, 0}, commontypes::Color{1, 1, 1}};
+    const lighting::LightSample sample = light.SampleFrom(commontypes::Point{0, 4, 0});
+    ASSERT_TRUE(sample.direction_ == commontypes::Vector(0, 1, 0));
+    ASSERT_DOUBLE_EQ(sample.distance_, 6);
+    ASSERT_TRUE(sample.intensity_ == commontypes::Color(1, 1, 1));
+
+    // facing toward, then away from, the light
+    ASSERT_TRUE(sample.Illuminates(commontypes::Vector{0, 1, 0}));
+    ASSERT_FALSE(sample.Illuminates(commontypes::Vector{0, -1, 0}));
+}
+
+TEST(LightingTest, TestSamplingSpotLight) {
+    const lighting::SpotLight light{commontypes::Point{0, 10, 0}, commontypes::Vector{0, -2, 0},
+                                    M_PI / 8, M_PI / 4, commontypes::Color{1, 1, 1}};
+    ASSERT_TRUE(light.direction() == commontypes::Vector(0, -1, 0));
+
+    // on the axis, within the inner cone, in the falloff, and outside the cone
+    const lighting::LightSample on_axis = light.SampleFrom(commontypes::Point{0, 0, 0});
+    ASSERT_TRUE(on_axis.direction_ == commontypes::Vector(0, 1, 0));
+    ASSERT_DOUBLE_EQ(on_axis.distance_, 10);
+    ASSERT_TRUE(on_axis.intensity_ == commontypes::Color(1, 1, 1));
+
+    const double inner_x = 10 * std::tan(M_PI / 10);
+    ASSERT_TRUE(light.SampleFrom(commontypes::Point{inner_x, 0, 0}).intensity_ ==
+                commontypes::Color(1, 1, 1));
+
+    const double falloff_x = 10 * std::tan(3 * M_PI / 16);
+    const commontypes::Color falloff =
+        light.SampleFrom(commontypes::Point{falloff_x, 0, 0}).intensity_;
+    ASSERT_GT(falloff.Red(), 0);
+    ASSERT_LT(falloff.Red(), 1);
+
+    const lighting::LightSample outside = light.SampleFrom(commontypes::Point{10, 0, 0});
+    ASSERT_TRUE(outside.intensity_ == commontypes::Color(0, 0, 0));
+    ASSERT_FALSE(outside.Illuminates(commontypes::Vector{0, 1, 0}));
+
+    ASSERT_THROW((lighting::SpotLight{commontypes::Point{}, commontypes::Vector{0, -1, 0},
+                                      M_PI / 4, M_PI / 8, commontypes::Color{1, 1, 1}}),
+                 std::invalid_argument);
+}
+
+TEST(LightingTest, TestSamplingDirectionalLight) {
+    const lighting::DirectionalLight light{commontypes::Vector{0, -3, 0},
+                                           commontypes::Color{1, 1, 1}};
+
+    // the same from everywhere
+    for (const auto& point : {commontypes::Point{0, 0, 0}, commontypes::Point{100, -20, 3}}) {
+        const lighting::LightSample sample = light.SampleFrom(point);
+        ASSERT_TRUE(sample.direction_ == commontypes::Vector(0, 1, 0));
+        ASSERT_TRUE(std::isinf(sample.distance_));
+        ASSERT_TRUE(sample.intensity_ == commontypes::Color(1, 1, 1));
+    }
+}
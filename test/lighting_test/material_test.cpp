@@ -2,10 +2,14 @@
 #include <gtest/gtest.h>
 #include <memory>
 #include "color.h"
+#include "directionallight.h"
 #include "identitymatrix.h"
 #include "lighting.h"
+#include "materialtable.h"
 #include "point.h"
 #include "pointlight.h"
+#include "scalingmatrix.h"
+#include "spotlight.h"
 #include "stripepattern.h"
 #include "vector.h"
 
@@ -296,4 +300,177 @@ TEST(MaterialTest, TestLightingWithPatternApplied) {
 
     ASSERT_TRUE(c1 == commontypes::Color(1, 1, 1));
     ASSERT_TRUE(c2 == commontypes::Color(0, 0, 0));
-}
\ No newline at end of file
+}
+TEST(MaterialTest, TestLightingScalesByLightIntensity) {
+    const auto material_ptr = std::make_shared<lighting::Material>(
+        lighting::MaterialBuilder().WithAmbient(0.1).WithDiffuse(0.9).WithSpecular(0).Build());
+    const lighting::PointLight light{commontypes::Point{0, 0, -10}, commontypes::Color{1, 1, 1}};
+    const commontypes::Point point{0, 0, -1};
+    const commontypes::Vector eye_v{0, 0, -1};
+    const commontypes::Vector normal_v{0, 0, -1};
+
+    for (const auto& [intensity, expected] :
+         {std::pair{1.0, commontypes::Color{1, 1, 1}},
+          std::pair{0.5, commontypes::Color{0.55, 0.55, 0.55}},
+          std::pair{0.0, commontypes::Color{0.1, 0.1, 0.1}}}) {
+        const commontypes::Color result = lighting::Lighting(
+            material_ptr, commontypes::IdentityMatrix{}, light, point, eye_v, normal_v, intensity);
+        ASSERT_TRUE(result == expected);
+    }
+}
+
+// the diffuse contribution is averaged over the area light's cells
+TEST(MaterialTest, TestLightingSamplesAreaLight) {
+    const auto material_ptr = std::make_shared<lighting::Material>(
+        lighting::MaterialBuilder().WithAmbient(0.1).WithDiffuse(0.9).WithSpecular(0).Build());
+    const lighting::AreaLight light{commontypes::Point{-0.5, -0.5, -5},
+                                    commontypes::Vector{1, 0, 0},
+                                    2,
+                                    commontypes::Vector{0, 1, 0},
+                                    2,
+                                    commontypes::Color{1, 1, 1}};
+    const commontypes::Point eye{0, 0, -5};
+
+    for (const auto& [point, expected] :
+         {std::pair{commontypes::Point{0, 0, -1}, commontypes::Color{0.9965, 0.9965, 0.9965}},
+          std::pair{commontypes::Point{0, 0.7071, -0.7071},
+                    commontypes::Color{0.6232, 0.6232, 0.6232}}}) {
+        const commontypes::Vector eye_v{(eye - point).Normalize()};
+        const commontypes::Vector normal_v{point - commontypes::Point{0, 0, 0}};
+        const commontypes::Color result = lighting::Lighting(
+            material_ptr, commontypes::IdentityMatrix{}, light, point, eye_v, normal_v, 1.0);
+        ASSERT_TRUE(result == expected);
+    }
+}
+
+TEST(MaterialTest, TestLightingWithSpotLight) {
+    const auto material_ptr = std::make_shared<lighting::Material>();
+    const commontypes::Vector eye_v{0, 0, -1};
+    const commontypes::Vector normal_v{0, 0, -1};
+    const lighting::SpotLight light{commontypes::Point{0, 0, -10}, commontypes::Vector{0, 0, 1},
+                                    0.1, 0.2, commontypes::Color{1, 1, 1}};
+
+    // as for a PointLight within the cone, and only ambient outside it
+    ASSERT_TRUE(lighting::Lighting(material_ptr, commontypes::IdentityMatrix{}, light,
+                                   commontypes::Point{0, 0, 0}, eye_v, normal_v) ==
+                commontypes::Color(1.9, 1.9, 1.9));
+    ASSERT_TRUE(lighting::Lighting(material_ptr, commontypes::IdentityMatrix{}, light,
+                                   commontypes::Point{5, 0, 0}, eye_v, normal_v) ==
+                commontypes::Color(0.1, 0.1, 0.1));
+}
+
+TEST(MaterialTest, TestLightingWithDirectionalLight) {
+    const auto material_ptr = std::make_shared<lighting::Material>();
+    const commontypes::Vector eye_v{0, 0, -1};
+    const commontypes::Vector normal_v{0, 0, -1};
+    const lighting::DirectionalLight light{commontypes::Vector{0, -1, 1},
+                                           commontypes::Color{1, 1, 1}};
+
+    // as for the PointLight at 45 degrees (pg 87), wherever the point is
+    for (const auto& point : {commontypes::Point{0, 0, 0}, commontypes::Point{30, -7, 0}}) {
+        const commontypes::Color result = lighting::Lighting(
+            material_ptr, commontypes::IdentityMatrix{}, light, point, eye_v, normal_v);
+        ASSERT_TRUE(result == commontypes::Color(0.7364, 0.7364, 0.7364));
+    }
+}
+
+TEST(MaterialTest, TestShadingRecordFromMaterial) {
+    auto material_ptr = std::make_shared<lighting::Material>();
+    material_ptr->SetReflective(0.5);
+    const lighting::ShadingRecord record = lighting::ShadingRecord::FromMaterial(*material_ptr);
+
+    ASSERT_TRUE(record.Color() == material_ptr->Color());
+    ASSERT_FLOAT_EQ(record.ambient_, 0.1);
+    ASSERT_FLOAT_EQ(record.reflective_, 0.5);
+    ASSERT_EQ(record.material_, material_ptr.get());
+    ASSERT_TRUE(record.IsReflective());
+    ASSERT_FALSE(record.IsTransparent());
+    ASSERT_FALSE(record.HasPattern());
+
+    material_ptr->SetPattern(std::make_shared<pattern::StripePattern>(
+        commontypes::Color::MakeWhite(), commontypes::Color::MakeBlack()));
+    material_ptr->SetTransparency(0.9);
+    const lighting::ShadingRecord patterned =
+        lighting::ShadingRecord::FromMaterial(*material_ptr);
+    ASSERT_TRUE(patterned.IsTransparent());
+    ASSERT_TRUE(patterned.HasPattern());
+    ASSERT_EQ(patterned.pattern_, material_ptr->Pattern().get());
+}
+
+TEST(MaterialTest, TestLightingWithShadingRecord) {
+    const auto material_ptr = std::make_shared<lighting::Material>();
+    const lighting::PointLight light{commontypes::Point{0, 10, -10},
+                                     commontypes::Color{1, 1, 1}};
+    const commontypes::Point point{0, 0, 0};
+    const commontypes::Vector eye_v{0, 0, -1};
+    const commontypes::Vector normal_v{0, 0, -1};
+
+    const lighting::ShadingRecord record = lighting::ShadingRecord::FromMaterial(*material_ptr);
+    const commontypes::Color surface_color =
+        lighting::SurfaceColor(record, commontypes::IdentityMatrix{}, point);
+    ASSERT_TRUE(lighting::Lighting(record, surface_color, light, point, eye_v, normal_v, 1.0) ==
+                lighting::Lighting(material_ptr, commontypes::IdentityMatrix{}, light, point,
+                                   eye_v, normal_v, 1.0));
+}
+
+// SurfaceColor takes the Shape's world-to-object matrix, where a Material takes its transform
+TEST(MaterialTest, TestSurfaceColorTakesWorldToObject) {
+    const auto pattern_ptr = std::make_shared<pattern::StripePattern>(
+        commontypes::Color{1, 1, 1}, commontypes::Color{0, 0, 0});
+    const auto material_ptr = std::make_shared<lighting::Material>(
+        lighting::MaterialBuilder().WithAmbient(1).WithPatternPtr(pattern_ptr).Build());
+    const lighting::PointLight light{commontypes::Point{0, 10, -10},
+                                     commontypes::Color{1, 1, 1}};
+    const commontypes::Matrix object_transform = commontypes::ScalingMatrix{2, 2, 2};
+    const commontypes::Vector eye_v{0, 0, -1};
+    const commontypes::Vector normal_v{0, 0, -1};
+
+    const lighting::ShadingRecord record = lighting::ShadingRecord::FromMaterial(*material_ptr);
+    for (const double x : {0.5, 1.5, 2.5, 3.5}) {
+        const commontypes::Point point{x, 0, 0};
+        const commontypes::Color surface_color =
+            lighting::SurfaceColor(record, object_transform.Inverse(), point);
+        ASSERT_TRUE(lighting::Lighting(record, surface_color, light, point, eye_v, normal_v,
+                                       1.0) ==
+                    lighting::Lighting(material_ptr, object_transform, light, point, eye_v,
+                                       normal_v, 1.0));
+    }
+}
+
+TEST(MaterialTest, TestMaterialTableSharesRecords) {
+    const auto material_a = std::make_shared<lighting::Material>();
+    const auto material_b = std::make_shared<lighting::Material>();
+    lighting::MaterialTable table{};
+
+    const uint32_t idx_a = table.Add(material_a);
+    const uint32_t idx_b = table.Add(material_b);
+    ASSERT_NE(idx_a, idx_b);
+    ASSERT_EQ(table.Add(material_a), idx_a);
+    ASSERT_EQ(table.size(), 2);
+    ASSERT_EQ(table[idx_b].material_, material_b.get());
+
+    // a record is only found for the Material it was made from
+    ASSERT_EQ(table.Find(idx_a, material_a.get()), &table[idx_a]);
+    ASSERT_EQ(table.Find(idx_a, material_b.get()), nullptr);
+    ASSERT_EQ(table.Find(lighting::MaterialTable::NO_INDEX, material_a.get()), nullptr);
+
+    table.Clear();
+    ASSERT_EQ(table.size(), 0);
+    ASSERT_EQ(table.Find(idx_a, material_a.get()), nullptr);
+}
+
+TEST(MaterialTest, TestMaterialTableCompilesEachPatternOnce) {
+    const auto stripes = std::make_shared<pattern::StripePattern>();
+    auto material_a = std::make_shared<lighting::Material>();
+    material_a->SetPattern(stripes);
+    auto material_b = std::make_shared<lighting::Material>();
+    material_b->SetPattern(stripes);
+    lighting::MaterialTable table{};
+
+    const uint32_t idx_a = table.Add(material_a);
+    const uint32_t idx_b = table.Add(material_b);
+    const uint32_t idx_plain = table.Add(std::make_shared<lighting::Material>());
+    ASSERT_NE(table[idx_a].program_, nullptr);
+    ASSERT_EQ(table[idx_a].program_, table[idx_b].program_);
+    ASSERT_EQ(table[idx_plain].program_, nullptr);
+}
@@ -0,0 +1,33 @@
+#include "blendpattern.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include "scalingmatrix.h"
+#include "stripepattern.h"
+#include "test_classes.h"
+
+TEST(BlendPatternTest, TestBlendIsTheWeightedAverage) {
+    const auto white = std::make_shared<pattern::StripePattern>(commontypes::Color::MakeWhite(),
+                                                                commontypes::Color::MakeWhite());
+    const auto black = std::make_shared<pattern::StripePattern>(commontypes::Color::MakeBlack(),
+                                                                commontypes::Color::MakeBlack());
+    const pattern::BlendPattern even{white, black};
+    ASSERT_TRUE(even.PatternAt(commontypes::Point(0, 0, 0)) == commontypes::Color(0.5, 0.5, 0.5));
+    const pattern::BlendPattern mostly_black{white, black, 0.75};
+    ASSERT_TRUE(mostly_black.PatternAt(commontypes::Point(0, 0, 0)) ==
+                commontypes::Color(0.25, 0.25, 0.25));
+}
+
+TEST(BlendPatternTest, TestEachPatternUsesItsOwnTransform) {
+    auto scaled = std::make_shared<pattern::TestPattern>();
+    scaled->SetPatternTransform(commontypes::ScalingMatrix{2, 2, 2});
+    const pattern::BlendPattern blend{std::make_shared<pattern::TestPattern>(), scaled};
+    // (2, 4, 6) * 0.5 + (1, 2, 3) * 0.5
+    ASSERT_TRUE(blend.PatternAt(commontypes::Point(2, 4, 6)) == commontypes::Color(1.5, 3, 4.5));
+}
+
+TEST(BlendPatternTest, TestInvalidBlendsThrow) {
+    const auto stripes = std::make_shared<pattern::StripePattern>();
+    ASSERT_THROW(pattern::BlendPattern(stripes, nullptr), std::invalid_argument);
+    ASSERT_THROW(pattern::BlendPattern(stripes, stripes, 1.5), std::invalid_argument);
+}
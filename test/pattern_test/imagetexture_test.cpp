@@ -0,0 +1,158 @@
+#include "imagetexture.h"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include "texturecache.h"
+#include "texturemappattern.h"
+
+// a 2x2 texture: red, green on the top row; blue, white on the bottom
+static pattern::ImageTexture MakeQuadTexture() {
+    return pattern::ImageTexture{2,
+                                 2,
+                                 {commontypes::Color{1, 0, 0}, commontypes::Color{0, 1, 0},
+                                  commontypes::Color{0, 0, 1}, commontypes::Color{1, 1, 1}}};
+}
+
+TEST(ImageTextureTest, TestReadingTextPPM) {
+    const auto texture = pattern::ImageTexture::FromPPM(
+        "P3\n# a comment\n3 2\n255\n"
+        "255 0 0  0 255 0  0 0 255\n"
+        "255 255 255  0 0 0  127 127 127\n");
+    ASSERT_EQ(texture.width(), 3);
+    ASSERT_EQ(texture.height(), 2);
+    ASSERT_TRUE(texture.Texel(0, 0) == commontypes::Color(1, 0, 0));
+    ASSERT_TRUE(texture.Texel(2, 0) == commontypes::Color(0, 0, 1));
+    ASSERT_TRUE(texture.Texel(2, 1) == commontypes::Color(0.498, 0.498, 0.498));
+}
+
+TEST(ImageTextureTest, TestReadingBinaryPPM) {
+    std::string ppm{"P6\n2 1\n255\n"};
+    for (const unsigned char byte : {255, 0, 0, 0, 0, 255}) {
+        ppm.push_back(static_cast<char>(byte));
+    }
+    const auto texture = pattern::ImageTexture::FromPPM(ppm);
+    ASSERT_TRUE(texture.Texel(0, 0) == commontypes::Color(1, 0, 0));
+    ASSERT_TRUE(texture.Texel(1, 0) == commontypes::Color(0, 0, 1));
+}
+
+TEST(ImageTextureTest, TestMalformedPPM) {
+    ASSERT_THROW(pattern::ImageTexture::FromPPM("P5\n1 1\n255\n0"), std::invalid_argument);
+    ASSERT_THROW(pattern::ImageTexture::FromPPM("P3\n2 1\n255\n0 0 0"), std::invalid_argument);
+    ASSERT_THROW(pattern::ImageTexture::FromPPM("P3\n1 1\n1024\n0 0 0"), std::invalid_argument);
+}
+
+TEST(ImageTextureTest, TestTiledStorageCoversEveryTexel) {
+    // wider and taller than a tile, and not a multiple of one
+    const size_t width = pattern::ImageTexture::TILE_SIZE * 2 + 3;
+    const size_t height = pattern::ImageTexture::TILE_SIZE + 5;
+    std::vector<commontypes::Color> pixels{};
+    for (size_t y = 0; y < height; ++y) {
+        for (size_t x = 0; x < width; ++x) {
+            pixels.emplace_back(x / 32.0, y / 32.0, 0);
+        }
+    }
+    const pattern::ImageTexture texture{width, height, pixels};
+
+    for (size_t y = 0; y < height; ++y) {
+        for (size_t x = 0; x < width; ++x) {
+            ASSERT_TRUE(texture.Texel(x, y) == pixels[y * width + x]);
+        }
+    }
+}
+
+TEST(ImageTextureTest, TestMipLevelsAverageTheLevelAbove) {
+    const auto texture = MakeQuadTexture();
+    ASSERT_EQ(texture.levels(), 2);
+    ASSERT_TRUE(texture.Texel(0, 0, 1) == commontypes::Color(0.5, 0.5, 0.5));
+    // levels past the last are clamped to it
+    ASSERT_TRUE(texture.Texel(0, 0, 7) == commontypes::Color(0.5, 0.5, 0.5));
+    ASSERT_TRUE(texture.ColorAt(0.3, 0.9, 1) == commontypes::Color(0.5, 0.5, 0.5));
+}
+
+TEST(ImageTextureTest, TestColorAtFiltersBetweenTexelCenters) {
+    const auto texture = MakeQuadTexture();
+    // the centers of the texels; v = 0 is at the bottom
+    ASSERT_TRUE(texture.ColorAt(0.25, 0.75) == commontypes::Color(1, 0, 0));
+    ASSERT_TRUE(texture.ColorAt(0.75, 0.75) == commontypes::Color(0, 1, 0));
+    ASSERT_TRUE(texture.ColorAt(0.25, 0.25) == commontypes::Color(0, 0, 1));
+    // halfway between red and green, and (wrapping around) between green and red
+    ASSERT_TRUE(texture.ColorAt(0.5, 0.75) == commontypes::Color(0.5, 0.5, 0));
+    ASSERT_TRUE(texture.ColorAt(1.0, 0.75) == commontypes::Color(0.5, 0.5, 0));
+    ASSERT_TRUE(texture.ColorAt(-0.75, 1.75) == commontypes::Color(1, 0, 0));
+}
+
+TEST(ImageTextureTest, TestClampedColorAtExtendsTheEdgeTexels) {
+    const auto texture = MakeQuadTexture();
+    const auto clamp = pattern::TextureWrap::kClamp;
+    const auto repeat = pattern::TextureWrap::kRepeat;
+    // the top edge is the top row's color, rather than blending with the bottom row's
+    ASSERT_TRUE(texture.ColorAt(0.25, 1.0, 0, repeat, clamp) == commontypes::Color(1, 0, 0));
+    ASSERT_TRUE(texture.ColorAt(0.25, 7.0, 0, repeat, clamp) == commontypes::Color(1, 0, 0));
+    ASSERT_TRUE(texture.ColorAt(1.0, 0.75, 0, clamp, repeat) == commontypes::Color(0, 1, 0));
+    ASSERT_TRUE(texture.ColorAt(0.0, 0.0, 0, clamp, clamp) == commontypes::Color(0, 0, 1));
+    // u still repeats, halfway between green and red
+    ASSERT_TRUE(texture.ColorAt(1.0, 1.0, 0, repeat, clamp) == commontypes::Color(0.5, 0.5, 0));
+}
+
+// the north pole and a cube face's edge don't filter across to the opposite edge of the texture
+TEST(ImageTextureTest, TestTextureMapPatternClampsAtPolesAndFaceEdges) {
+    const auto texture = std::make_shared<const pattern::ImageTexture>(MakeQuadTexture());
+    const pattern::TextureMapPattern sphere{texture, pattern::UVMapping::kSpherical};
+    // halfway between red and green, with none of the bottom row's blue
+    ASSERT_TRUE(sphere.PatternAt(commontypes::Point{0, 1, 0}) == commontypes::Color(0.5, 0.5, 0));
+
+    // the top right corner of the right face
+    const pattern::TextureMapPattern cube{texture, pattern::UVMapping::kCubic};
+    ASSERT_TRUE(cube.PatternAt(commontypes::Point{1, 1, -1}) == commontypes::Color(0, 1, 0));
+}
+
+TEST(ImageTextureTest, TestTextureMapPattern) {
+    const pattern::TextureMapPattern pattern{
+        std::make_shared<const pattern::ImageTexture>(MakeQuadTexture()),
+        pattern::UVMapping::kPlanar};
+    ASSERT_TRUE(pattern.PatternAt(commontypes::Point{0.25, 0, 0.75}) ==
+                commontypes::Color(1, 0, 0));
+    ASSERT_TRUE(pattern.PatternAt(commontypes::Point{3.75, 7, -0.75}) ==
+                commontypes::Color(1, 1, 1));
+}
+
+TEST(ImageTextureTest, TestTextureCacheSharesAndEvicts) {
+    const auto dir = std::filesystem::temp_directory_path() / "imagetexture_test";
+    std::filesystem::create_directories(dir);
+    for (const char* name : {"a.ppm", "b.ppm"}) {
+        std::ofstream{dir / name} << "P3\n1 1\n255\n255 0 0\n";
+    }
+
+    pattern::TextureCache cache{};
+    const auto a = cache.Load(dir / "a.ppm");
+    ASSERT_EQ(cache.Load(dir / "." / "a.ppm"), a);
+    ASSERT_EQ(cache.size(), 1);
+    ASSERT_EQ(cache.bytes(), a->bytes());
+
+    // room for only one texture; the least recently loaded is dropped
+    cache.SetBudget(a->bytes());
+    const auto b = cache.Load(dir / "b.ppm");
+    ASSERT_EQ(cache.size(), 1);
+    ASSERT_EQ(cache.Load(dir / "b.ppm"), b);
+    const auto reloaded_a = cache.Load(dir / "a.ppm");
+    ASSERT_NE(reloaded_a, a);
+    ASSERT_TRUE(reloaded_a->Texel(0, 0) == a->Texel(0, 0));
+
+    // a texture larger than the budget is kept until the next is loaded, so it's shared too
+    cache.SetBudget(a->bytes() / 2);
+    ASSERT_EQ(cache.size(), 0);
+    const auto large_a = cache.Load(dir / "a.ppm");
+    ASSERT_EQ(cache.size(), 1);
+    ASSERT_EQ(cache.Load(dir / "a.ppm"), large_a);
+    ASSERT_NE(cache.Load(dir / "b.ppm"), b);
+    ASSERT_EQ(cache.size(), 1);
+
+    cache.SetBudget(0);
+    ASSERT_EQ(cache.size(), 0);
+    ASSERT_EQ(cache.bytes(), 0);
+
+    ASSERT_THROW(cache.Load(dir / "missing.ppm"), std::runtime_error);
+    std::filesystem::remove_all(dir);
+}
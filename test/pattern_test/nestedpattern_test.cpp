@@ -0,0 +1,39 @@
+#include "nestedpattern.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include "checkerpattern.h"
+#include "stripepattern.h"
+#include "translationmatrix.h"
+
+TEST(NestedPatternTest, TestCheckerOfStripesSelectsASubPattern) {
+    const auto red = commontypes::Color{1, 0, 0};
+    const auto blue = commontypes::Color{0, 0, 1};
+    const auto stripes_a = std::make_shared<pattern::StripePattern>(red, blue);
+    auto stripes_b = std::make_shared<pattern::StripePattern>(red, blue);
+    stripes_b->SetPatternTransform(commontypes::TranslationMatrix{1, 0, 0});
+    const pattern::NestedPattern nested{pattern::NestedPattern::Kind::kChecker, stripes_a,
+                                        stripes_b};
+
+    // the first checker (and its stripes) or the second checker (and its shifted stripes)
+    ASSERT_TRUE(nested.PatternAt(commontypes::Point(0.5, 0.5, 0.5)) == red);
+    ASSERT_TRUE(nested.PatternAt(commontypes::Point(1.5, 0.5, 0.5)) == red);
+    ASSERT_TRUE(nested.PatternAt(commontypes::Point(0.5, 1.5, 0.5)) == blue);
+}
+
+TEST(NestedPatternTest, TestGradientBlendsItsSubPatterns) {
+    const pattern::NestedPattern nested{
+        pattern::NestedPattern::Kind::kGradient,
+        std::make_shared<pattern::CheckerPattern>(commontypes::Color::MakeWhite(),
+                                                  commontypes::Color::MakeWhite()),
+        std::make_shared<pattern::CheckerPattern>(commontypes::Color::MakeBlack(),
+                                                  commontypes::Color::MakeBlack())};
+    ASSERT_TRUE(nested.PatternAt(commontypes::Point(0.25, 0, 0)) ==
+                commontypes::Color(0.75, 0.75, 0.75));
+}
+
+TEST(NestedPatternTest, TestMissingPatternThrows) {
+    ASSERT_THROW(pattern::NestedPattern(pattern::NestedPattern::Kind::kRing,
+                                        std::make_shared<pattern::StripePattern>(), nullptr),
+                 std::invalid_argument);
+}
@@ -0,0 +1,78 @@
+#include "noise.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+TEST(NoiseTest, TestPerlinNoiseMatchesReferenceImplementation) {
+    // the value printed by Ken Perlin's reference (Java) implementation
+    ASSERT_NEAR(pattern::PerlinNoise(commontypes::Point{3.14, 42, 7}), 0.136919958784, 1e-12);
+}
+
+// noise repeats every 256 units, however far a coordinate is beyond the range of int32_t
+TEST(NoiseTest, TestPerlinNoiseRepeatsAtLargeCoordinates) {
+    const double noise = pattern::PerlinNoise(commontypes::Point{3.25, 42, 7});
+    for (const double offset : {std::ldexp(1.0, 40), -std::ldexp(1.0, 40), std::ldexp(1.0, 31)}) {
+        ASSERT_DOUBLE_EQ(pattern::PerlinNoise(commontypes::Point{3.25 + offset, 42, 7}), noise);
+    }
+}
+
+TEST(NoiseTest, TestPerlinNoiseIsNaNAtNonFiniteCoordinates) {
+    ASSERT_TRUE(std::isnan(pattern::PerlinNoise(commontypes::Point{INFINITY, 0.5, 0.5})));
+    ASSERT_TRUE(std::isnan(pattern::PerlinNoise(commontypes::Point{0.5, -INFINITY, 0.5})));
+    ASSERT_TRUE(std::isnan(pattern::PerlinNoise(commontypes::Point{0.5, 0.5, NAN})));
+}
+
+TEST(NoiseTest, TestPerlinNoiseIsZeroAtLatticePoints) {
+    for (const double x : {-3.0, 0.0, 1.0, 17.0}) {
+        for (const double y : {-1.0, 0.0, 5.0}) {
+            ASSERT_NEAR(pattern::PerlinNoise(commontypes::Point{x, y, 2}), 0.0, 1e-12);
+        }
+    }
+}
+
+TEST(NoiseTest, TestPerlinNoiseIsSmoothAndBounded) {
+    const commontypes::Point point{0.3, 1.7, -2.2};
+    const double noise = pattern::PerlinNoise(point);
+    ASSERT_NEAR(pattern::PerlinNoise(commontypes::Point{0.3 + 1e-6, 1.7, -2.2}), noise, 1e-5);
+
+    for (double t = -10; t < 10; t += 0.37) {
+        const commontypes::Point p{t, t * 0.7 + 0.1, -t * 1.3 + 0.2};
+        ASSERT_LE(std::fabs(pattern::PerlinNoise(p)), 1.05);
+        ASSERT_LE(std::fabs(pattern::FractalNoise(p, 4)), 1.05);
+        const double turbulence = pattern::Turbulence(p, 4);
+        ASSERT_GE(turbulence, 0.0);
+        ASSERT_LE(turbulence, 1.05);
+    }
+}
+
+TEST(NoiseTest, TestBatchedNoiseMatchesEachPoint) {
+    // more than one batch, and not a multiple of the batch size
+    const size_t n = pattern::NOISE_BATCH * 2 + 3;
+    std::vector<double> x{};
+    std::vector<double> y{};
+    std::vector<double> z{};
+    for (size_t i = 0; i < n; ++i) {
+        x.push_back(0.13 * static_cast<double>(i) - 1.1);
+        y.push_back(0.71 * static_cast<double>(i));
+        z.push_back(-0.29 * static_cast<double>(i) + 3.3);
+    }
+
+    std::vector<double> noise(n);
+    std::vector<double> fractal(n);
+    std::vector<double> turbulence(n);
+    pattern::PerlinNoise(x.data(), y.data(), z.data(), noise.data(), n);
+    pattern::FractalNoise(x.data(), y.data(), z.data(), fractal.data(), n, 3, 0.6);
+    pattern::Turbulence(x.data(), y.data(), z.data(), turbulence.data(), n, 3, 0.6);
+    for (size_t i = 0; i < n; ++i) {
+        const commontypes::Point point{x[i], y[i], z[i]};
+        ASSERT_DOUBLE_EQ(noise[i], pattern::PerlinNoise(point));
+        ASSERT_DOUBLE_EQ(fractal[i], pattern::FractalNoise(point, 3, 0.6));
+        ASSERT_DOUBLE_EQ(turbulence[i], pattern::Turbulence(point, 3, 0.6));
+    }
+}
+
+TEST(NoiseTest, TestSingleOctaveIsPlainNoise) {
+    const commontypes::Point point{1.5, -0.25, 9.75};
+    ASSERT_DOUBLE_EQ(pattern::FractalNoise(point, 1), pattern::PerlinNoise(point));
+    ASSERT_DOUBLE_EQ(pattern::Turbulence(point, 1), std::fabs(pattern::PerlinNoise(point)));
+}
@@ -0,0 +1,94 @@
+#include "patternprogram.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include "blendpattern.h"
+#include "checkerpattern.h"
+#include "gradientpattern.h"
+#include "nestedpattern.h"
+#include "radialgradientpattern.h"
+#include "ringpattern.h"
+#include "rotationmatrix.h"
+#include "scalingmatrix.h"
+#include "stripepattern.h"
+#include "test_classes.h"
+#include "translationmatrix.h"
+
+namespace {
+// a ring of checkers and a blend of stripes with a radial gradient, each with a transform
+std::shared_ptr<pattern::Pattern> MakeTree() {
+    auto checkers = std::make_shared<pattern::CheckerPattern>(commontypes::Color{1, 0, 0},
+                                                              commontypes::Color{0, 1, 0});
+    checkers->SetPatternTransform(commontypes::ScalingMatrix{0.25, 0.25, 0.25});
+    auto stripes = std::make_shared<pattern::StripePattern>(commontypes::Color{0, 0, 1},
+                                                            commontypes::Color{1, 1, 0});
+    stripes->SetPatternTransform(commontypes::RotationMatrixY{0.5});
+    auto radial = std::make_shared<pattern::RadialGradientPattern>();
+    radial->SetPatternTransform(commontypes::TranslationMatrix{0.3, 0, -0.2});
+    auto blend = std::make_shared<pattern::BlendPattern>(stripes, radial, 0.3);
+    blend->SetPatternTransform(commontypes::ScalingMatrix{2, 1, 2});
+
+    auto rings = std::make_shared<pattern::NestedPattern>(pattern::NestedPattern::Kind::kRing,
+                                                          checkers, blend);
+    rings->SetPatternTransform(commontypes::TranslationMatrix{0.5, 0, 0.5});
+    return rings;
+}
+}  // namespace
+
+TEST(PatternProgramTest, TestProgramIsThePatternsInPreOrder) {
+    const auto program = pattern::PatternProgram::Compile(*MakeTree());
+    ASSERT_EQ(program.size(), 5);
+    ASSERT_EQ(program[0].opcode_, pattern::PatternOpcode::kRing);
+    ASSERT_EQ(program[0].operands_[0], 1);
+    ASSERT_EQ(program[0].operands_[1], 2);
+    ASSERT_EQ(program[1].opcode_, pattern::PatternOpcode::kChecker);
+    ASSERT_EQ(program[1].operands_[0], pattern::PatternInstruction::CONSTANT);
+    ASSERT_EQ(program[2].opcode_, pattern::PatternOpcode::kBlend);
+    ASSERT_DOUBLE_EQ(program[2].weight_, 0.3);
+    ASSERT_EQ(program[2].operands_[0], 3);
+    ASSERT_EQ(program[2].operands_[1], 4);
+    ASSERT_EQ(program[3].opcode_, pattern::PatternOpcode::kStripe);
+    ASSERT_EQ(program[4].opcode_, pattern::PatternOpcode::kRadialGradient);
+}
+
+TEST(PatternProgramTest, TestProgramMatchesThePatterns) {
+    const auto tree = MakeTree();
+    const auto program = pattern::PatternProgram::Compile(*tree);
+    const commontypes::Matrix shape_transform =
+        commontypes::TranslationMatrix{1, 2, 3} * commontypes::ScalingMatrix{2, 2, 2};
+    const commontypes::Matrix world_to_object = shape_transform.Inverse();
+    for (double t = -3; t < 3; t += 0.173) {
+        const commontypes::Point point{t, 0.3 * t - 1, 1.7 - t};
+        ASSERT_TRUE(program.ColorAtObject(point) == tree->PatternAtObject(point));
+        ASSERT_TRUE(program.ColorAtShape(world_to_object, point) ==
+                    tree->PatternAtShape(shape_transform, point));
+    }
+}
+
+TEST(PatternProgramTest, TestSimplePatternsCompileToOneInstruction) {
+    auto gradient = std::make_shared<pattern::GradientPattern>(commontypes::Color::MakeWhite(),
+                                                               commontypes::Color{1, 0, 0});
+    gradient->SetPatternTransform(commontypes::ScalingMatrix{3, 1, 1});
+    const auto program = pattern::PatternProgram::Compile(*gradient);
+    ASSERT_EQ(program.size(), 1);
+    ASSERT_EQ(program[0].opcode_, pattern::PatternOpcode::kGradient);
+    ASSERT_TRUE(program.ColorAtObject(commontypes::Point(1.5, 0, 0)) ==
+                commontypes::Color(1, 0.5, 0.5));
+
+    const pattern::RingPattern rings{};
+    const auto ring_program = pattern::PatternProgram::Compile(rings);
+    ASSERT_TRUE(ring_program.ColorAtObject(commontypes::Point(1, 0, 0)) ==
+                commontypes::Color::MakeBlack());
+}
+
+TEST(PatternProgramTest, TestOtherPatternsAreEvaluatedVirtually) {
+    auto inner = std::make_shared<pattern::TestPattern>();
+    inner->SetPatternTransform(commontypes::TranslationMatrix{1, 2, 3});
+    auto blend = std::make_shared<pattern::BlendPattern>(inner, inner, 0.5);
+    blend->SetPatternTransform(commontypes::ScalingMatrix{2, 2, 2});
+    const auto program = pattern::PatternProgram::Compile(*blend);
+    ASSERT_EQ(program.size(), 3);
+    ASSERT_EQ(program[1].opcode_, pattern::PatternOpcode::kVirtual);
+    ASSERT_EQ(program[1].pattern_, inner.get());
+    // (4, 6, 8) / 2 - (1, 2, 3)
+    ASSERT_TRUE(program.ColorAtObject(commontypes::Point(4, 6, 8)) == commontypes::Color(1, 1, 1));
+}
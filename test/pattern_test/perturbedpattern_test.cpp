@@ -0,0 +1,62 @@
+#include "perturbedpattern.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include "noise.h"
+#include "stripepattern.h"
+#include "test_classes.h"
+#include "translationmatrix.h"
+
+TEST(PerturbedPatternTest, TestUnscaledPerturbationIsTheWrappedPattern) {
+    const auto stripes = std::make_shared<pattern::StripePattern>();
+    const pattern::PerturbedPattern perturbed{stripes, 0.0};
+    for (const double x : {0.1, 0.9, 1.1, 2.5}) {
+        const commontypes::Point point{x, 0.3, -0.7};
+        ASSERT_TRUE(perturbed.PatternAt(point) == stripes->PatternAt(point));
+    }
+}
+
+TEST(PerturbedPatternTest, TestPointsAreMovedByAtMostTheScale) {
+    const pattern::PerturbedPattern perturbed{std::make_shared<pattern::TestPattern>(), 0.3};
+    bool moved = false;
+    for (double t = -3; t < 3; t += 0.41) {
+        const commontypes::Point point{t, 0.5 * t + 0.2, 1 - t};
+        commontypes::Point result{};
+        perturbed.Perturb(&point, &result, 1);
+
+        // a TestPattern's color is the point it's evaluated at
+        ASSERT_TRUE(perturbed.PatternAt(point) ==
+                    commontypes::Color(result.x(), result.y(), result.z()));
+        for (const double offset :
+             {result.x() - point.x(), result.y() - point.y(), result.z() - point.z()}) {
+            ASSERT_LE(std::fabs(offset), 0.3 * 1.05);
+            moved |= std::fabs(offset) > 1e-3;
+        }
+    }
+    ASSERT_TRUE(moved);
+}
+
+TEST(PerturbedPatternTest, TestWrappedPatternTransformApplies) {
+    auto inner = std::make_shared<pattern::TestPattern>();
+    inner->SetPatternTransform(commontypes::TranslationMatrix{1, 2, 3});
+    const pattern::PerturbedPattern perturbed{inner, 0.0};
+    ASSERT_TRUE(perturbed.PatternAt(commontypes::Point{1, 2, 3}) == commontypes::Color(0, 0, 0));
+}
+
+TEST(PerturbedPatternTest, TestBatchedColorsMatchEachPoint) {
+    const pattern::PerturbedPattern perturbed{std::make_shared<pattern::StripePattern>(), 0.5, 4,
+                                              2.0};
+    std::vector<commontypes::Point> points{};
+    for (size_t i = 0; i < pattern::NOISE_BATCH + 5; ++i) {
+        points.emplace_back(0.17 * static_cast<double>(i), 0.4, -0.05 * static_cast<double>(i));
+    }
+    std::vector<commontypes::Color> colors(points.size());
+    perturbed.PatternsAt(points.data(), colors.data(), points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        ASSERT_TRUE(colors[i] == perturbed.PatternAt(points[i]));
+    }
+}
+
+TEST(PerturbedPatternTest, TestPerturbingNothingThrows) {
+    ASSERT_THROW(pattern::PerturbedPattern{nullptr}, std::invalid_argument);
+}
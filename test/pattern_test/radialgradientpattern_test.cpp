@@ -0,0 +1,16 @@
+#include "radialgradientpattern.h"
+#include <gtest/gtest.h>
+#include "pattern.h"
+#include "point.h"
+
+TEST(RadialGradientPatternTest, TestRadialGradientBlendsWithDistanceFromYAxis) {
+    const pattern::RadialGradientPattern pattern{commontypes::Color::MakeWhite(),
+                                                 commontypes::Color::MakeBlack()};
+    ASSERT_TRUE(pattern.PatternAt(commontypes::Point(0, 0, 0)) == commontypes::Color::MakeWhite());
+    ASSERT_TRUE(pattern.PatternAt(commontypes::Point(0.25, 7, 0)) ==
+                commontypes::Color(0.75, 0.75, 0.75));
+    ASSERT_TRUE(pattern.PatternAt(commontypes::Point(0, -2, 0.5)) ==
+                commontypes::Color(0.5, 0.5, 0.5));
+    ASSERT_TRUE(pattern.PatternAt(commontypes::Point(0.6, 0, 0.8)) ==
+                commontypes::Color::MakeWhite());
+}
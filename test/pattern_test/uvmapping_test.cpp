@@ -0,0 +1,63 @@
+#include "uvmapping.h"
+#include <gtest/gtest.h>
+#include <cmath>
+
+static void ExpectUV(const pattern::UV& uv, const double u, const double v) {
+    EXPECT_NEAR(uv.u_, u, 1e-9);
+    EXPECT_NEAR(uv.v_, v, 1e-9);
+}
+
+TEST(UVMappingTest, TestSphericalMapping) {
+    const double sqrt2over2 = sqrt(2) / 2;
+    ExpectUV(pattern::SphericalMap(commontypes::Point{0, 0, -1}), 0.0, 0.5);
+    ExpectUV(pattern::SphericalMap(commontypes::Point{1, 0, 0}), 0.25, 0.5);
+    ExpectUV(pattern::SphericalMap(commontypes::Point{0, 0, 1}), 0.5, 0.5);
+    ExpectUV(pattern::SphericalMap(commontypes::Point{-1, 0, 0}), 0.75, 0.5);
+    ExpectUV(pattern::SphericalMap(commontypes::Point{0, 1, 0}), 0.5, 1.0);
+    ExpectUV(pattern::SphericalMap(commontypes::Point{0, -1, 0}), 0.5, 0.0);
+    ExpectUV(pattern::SphericalMap(commontypes::Point{sqrt2over2, sqrt2over2, 0}), 0.25, 0.75);
+}
+
+TEST(UVMappingTest, TestPlanarMapping) {
+    ExpectUV(pattern::PlanarMap(commontypes::Point{0.25, 0, 0.5}), 0.25, 0.5);
+    ExpectUV(pattern::PlanarMap(commontypes::Point{0.25, 0, -0.25}), 0.25, 0.75);
+    ExpectUV(pattern::PlanarMap(commontypes::Point{0.25, 0.5, -0.25}), 0.25, 0.75);
+    ExpectUV(pattern::PlanarMap(commontypes::Point{1.25, 0, 0.5}), 0.25, 0.5);
+    ExpectUV(pattern::PlanarMap(commontypes::Point{-0.25, 0, -1.75}), 0.75, 0.25);
+    ExpectUV(pattern::PlanarMap(commontypes::Point{1, 0, -1}), 0.0, 0.0);
+}
+
+TEST(UVMappingTest, TestCylindricalMapping) {
+    const double sqrt2over2 = sqrt(2) / 2;
+    ExpectUV(pattern::CylindricalMap(commontypes::Point{0, 0, -1}), 0.0, 0.0);
+    ExpectUV(pattern::CylindricalMap(commontypes::Point{0, 0.5, -1}), 0.0, 0.5);
+    ExpectUV(pattern::CylindricalMap(commontypes::Point{0, 1, -1}), 0.0, 0.0);
+    ExpectUV(pattern::CylindricalMap(commontypes::Point{sqrt2over2, 0.5, -sqrt2over2}), 0.125,
+             0.5);
+    ExpectUV(pattern::CylindricalMap(commontypes::Point{1, 0.5, 0}), 0.25, 0.5);
+    ExpectUV(pattern::CylindricalMap(commontypes::Point{-sqrt2over2, -0.25, sqrt2over2}), 0.625,
+             0.75);
+}
+
+TEST(UVMappingTest, TestCubicMappingOfEachFace) {
+    // front, back, left, right, up and down
+    ExpectUV(pattern::CubicMap(commontypes::Point{-0.5, 0.5, 1}), 0.25, 0.75);
+    ExpectUV(pattern::CubicMap(commontypes::Point{0.5, -0.5, -1}), 0.25, 0.25);
+    ExpectUV(pattern::CubicMap(commontypes::Point{-1, 0.5, -0.5}), 0.25, 0.75);
+    ExpectUV(pattern::CubicMap(commontypes::Point{1, -0.5, 0.5}), 0.25, 0.25);
+    ExpectUV(pattern::CubicMap(commontypes::Point{-0.5, 1, -0.5}), 0.25, 0.75);
+    ExpectUV(pattern::CubicMap(commontypes::Point{0.5, -1, 0.5}), 0.75, 0.75);
+}
+
+TEST(UVMappingTest, TestCubicMappingReachesOneAtFaceEdges) {
+    ExpectUV(pattern::CubicMap(commontypes::Point{1, 1, -1}), 1.0, 1.0);
+    ExpectUV(pattern::CubicMap(commontypes::Point{-1, -0.5, -1}), 0.0, 0.25);
+}
+
+TEST(UVMappingTest, TestMapToUVDispatchesOnMapping) {
+    const commontypes::Point point{1, 0.5, 0};
+    ExpectUV(pattern::MapToUV(pattern::UVMapping::kCylindrical, point),
+             pattern::CylindricalMap(point).u_, pattern::CylindricalMap(point).v_);
+    ExpectUV(pattern::MapToUV(pattern::UVMapping::kCubic, point), pattern::CubicMap(point).u_,
+             pattern::CubicMap(point).v_);
+}
@@ -0,0 +1,103 @@
+#include "animation.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "rotationmatrix.h"
+#include "scalingmatrix.h"
+#include "translationmatrix.h"
+#include "viewtransform.h"
+
+TEST(AnimationTest, TestTransformKeysAreInterpolated) {
+    scene::World world = scene::World::DefaultWorld();
+    scene::Camera camera{11, 11, M_PI / 2};
+    const auto inner = world.objects()[1];  // scaled by 0.5
+    scene::Animation animation{};
+
+    // added out of order
+    scene::TransformKey last{2};
+    last.translation_ = {4, 0, 0};
+    last.rotation_ = {0, M_PI, 0};
+    animation.AddTransformKey(inner, last);
+    animation.AddTransformKey(inner, scene::TransformKey{0});
+    ASSERT_DOUBLE_EQ(animation.duration(), 2);
+
+    // keyed transforms apply on top of the Shape's own
+    const commontypes::Matrix base = commontypes::ScalingMatrix{0.5, 0.5, 0.5};
+    ASSERT_EQ(animation.Apply(1, world, camera), 1);
+    const commontypes::Matrix halfway = commontypes::TranslationMatrix{2, 0, 0} *
+                                        commontypes::RotationMatrixY{M_PI / 2} * base;
+    ASSERT_TRUE(inner->GetTransform() == halfway);
+
+    // the last key holds after it, and the first before it
+    animation.Apply(5, world, camera);
+    const commontypes::Matrix end =
+        commontypes::TranslationMatrix{4, 0, 0} * commontypes::RotationMatrixY{M_PI} * base;
+    ASSERT_TRUE(inner->GetTransform() == end);
+    ASSERT_EQ(animation.Apply(-1, world, camera), 1);
+    ASSERT_TRUE(inner->GetTransform() == base);
+
+    // a Shape that doesn't move isn't transformed again
+    ASSERT_EQ(animation.Apply(0, world, camera), 0);
+    ASSERT_TRUE(world.objects()[0]->GetTransform() == commontypes::IdentityMatrix{});
+}
+
+TEST(AnimationTest, TestCameraAndLightKeysAreInterpolated) {
+    scene::World world = scene::World::DefaultWorld();
+    scene::Camera camera{11, 11, M_PI / 2};
+    scene::Animation animation{};
+    const commontypes::Vector up{0, 1, 0};
+    animation.AddCameraKey(
+        scene::CameraKey{0, commontypes::Point{0, 0, -5}, commontypes::Point{0, 0, 0}, up});
+    animation.AddCameraKey(
+        scene::CameraKey{1, commontypes::Point{0, 2, -5}, commontypes::Point{0, 2, 0}, up});
+    animation.AddLightKey(0, scene::LightKey{0, commontypes::Point{-10, 10, -10},
+                                             commontypes::Color{1, 1, 1}});
+    animation.AddLightKey(0, scene::LightKey{4, commontypes::Point{10, 10, -10},
+                                             commontypes::Color{0, 0, 0}});
+    ASSERT_DOUBLE_EQ(animation.duration(), 4);
+
+    animation.Apply(0.5, world, camera);
+    const commontypes::Matrix view =
+        commontypes::ViewTransform{commontypes::Point{0, 1, -5}, commontypes::Point{0, 1, 0}, up};
+    ASSERT_TRUE(camera.transform() == view);
+    animation.Apply(1, world, camera);
+    ASSERT_TRUE(world.lights()[0].position() == commontypes::Point(-5, 10, -10));
+    ASSERT_TRUE(world.lights()[0].intensity() == commontypes::Color(0.75, 0.75, 0.75));
+}
+
+TEST(AnimationTest, TestFramesMatchStillsOfTheSamePose) {
+    scene::World world = scene::World::DefaultWorld();
+    scene::Camera camera{11, 11, M_PI / 2};
+    camera.SetThreadCount(1);
+    camera.SetTransform(commontypes::ViewTransform{
+        commontypes::Point{0, 0, -5}, commontypes::Point{0, 0, 0}, commontypes::Vector{0, 1, 0}});
+
+    scene::Animation animation{};
+    const auto outer = world.objects()[0];
+    animation.AddTransformKey(outer, scene::TransformKey{0});
+    scene::TransformKey moved{1};
+    moved.translation_ = {1.5, 0, 0};
+    animation.AddTransformKey(outer, moved);
+
+    std::vector<canvas::Canvas> frames{};
+    animation.Render(world, camera, 3,
+                     [&frames](const size_t frame, const canvas::Canvas& image,
+                               const scene::RenderStats&) {
+                         ASSERT_EQ(frame, frames.size());
+                         frames.push_back(image);
+                     });
+    ASSERT_EQ(frames.size(), 3);
+
+    // a World built from scratch for each pose renders the same images
+    for (size_t frame = 0; frame < frames.size(); ++frame) {
+        scene::World still = scene::World::DefaultWorld();
+        still.objects()[0]->SetTransform(commontypes::TranslationMatrix{0.5 * frame, 0, 0});
+        const canvas::Canvas image = camera.Render(still);
+        for (size_t y = 0; y < image.height(); ++y) {
+            for (size_t x = 0; x < image.width(); ++x) {
+                ASSERT_TRUE(frames[frame].GetPixel(x, y) == image.GetPixel(x, y));
+            }
+        }
+    }
+    ASSERT_FALSE(frames[0].GetPixel(7, 5) == frames[2].GetPixel(7, 5));
+}
@@ -1,6 +1,8 @@
 #include "camera.h"
 #include <gtest/gtest.h>
 #include "color.h"
+#include "instrumentation.h"
+#include "renderstats.h"
 #include "rotationmatrix.h"
 #include "translationmatrix.h"
 #include "viewtransform.h"
@@ -63,3 +65,94 @@ TEST(CameraTest, TestRenderingWorldWithCamera) {
     const commontypes::Color pixel_at = image.GetPixel(5, 5);
     ASSERT_TRUE(pixel_at == commontypes::Color(0.38066, 0.47583, 0.2855));
 }
+
+TEST(CameraTest, TestConstructingRayThroughPointWithinPixel) {
+    scene::Camera c{201, 101, M_PI_2};
+    ASSERT_TRUE(c.RayForPixel(0, 0, 0.5, 0.5).direction() == c.RayForPixel(0, 0).direction());
+
+    // the far corner of pixel (99, 49) is the center of a 200x100 canvas
+    const scene::Camera even_c{200, 100, M_PI_2};
+    const auto r = even_c.RayForPixel(99, 49, 1.0, 1.0);
+    ASSERT_TRUE(r.direction() == commontypes::Vector(0, 0, -1));
+}
+
+TEST(CameraTest, TestSamplesPerPixelMustBeSquare) {
+    scene::Camera c{11, 11, M_PI_2};
+    ASSERT_EQ(c.SamplesPerPixel(), 1);
+    c.SetSamplesPerPixel(9);
+    ASSERT_EQ(c.SamplesPerPixel(), 9);
+    ASSERT_THROW(c.SetSamplesPerPixel(0), std::invalid_argument);
+    ASSERT_THROW(c.SetSamplesPerPixel(8), std::invalid_argument);
+}
+
+TEST(CameraTest, TestSupersampledPixelIsAverageOfSamples) {
+    scene::World world = scene::World::DefaultWorld();
+    scene::Camera camera{11, 11, M_PI_2};
+    camera.SetTransform(commontypes::ViewTransform{
+        commontypes::Point{0, 0, -5}, commontypes::Point{0, 0, 0}, commontypes::Vector{0, 1, 0}});
+    camera.SetSamplesPerPixel(4);
+    const canvas::Canvas image = camera.Render(world);
+
+    // pixel (3, 4) straddles the edge of the outer sphere
+    commontypes::Color expected{};
+    for (const double y_offset : {0.25, 0.75}) {
+        for (const double x_offset : {0.25, 0.75}) {
+            commontypes::Ray ray = camera.RayForPixel(3, 4, x_offset, y_offset);
+            expected += world.ColorAt(ray);
+        }
+    }
+    expected = commontypes::Color{expected / 4};
+
+    ASSERT_TRUE(image.GetPixel(3, 4) == expected);
+}
+
+TEST(CameraTest, TestFastShadingIsNearExactShading) {
+    scene::World world = scene::World::DefaultWorld();
+    // a non-integral shininess, so that the approximated part of FastPow is exercised
+    world.objects().front()->Material()->SetShininess(57.3);
+    world.objects().front()->Material()->SetSpecular(0.9);
+    world.AddLight(
+        lighting::PointLight{commontypes::Point{5, 3, -8}, commontypes::Color{1, 1, 1}});
+    scene::Camera camera{41, 41, M_PI / 3};
+    camera.SetTransform(commontypes::ViewTransform{
+        commontypes::Point{0, 0, -5}, commontypes::Point{0, 0, 0}, commontypes::Vector{0, 1, 0}});
+
+    const canvas::Canvas exact = camera.Render(world);
+    world.SetShadingMode(lighting::ShadingMode::kFast);
+    const canvas::Canvas fast = camera.Render(world);
+
+    // measured at about 6e-6
+    double max_difference = 0.0;
+    for (size_t y = 0; y < camera.vsize(); ++y) {
+        for (size_t x = 0; x < camera.hsize(); ++x) {
+            const commontypes::Color diff{exact.GetPixel(x, y) - fast.GetPixel(x, y)};
+            for (const double channel : {diff.Red(), diff.Green(), diff.Blue()}) {
+                max_difference = std::max(max_difference, fabs(channel));
+            }
+        }
+    }
+    ASSERT_LT(max_difference, 1e-4);
+}
+
+#ifdef RAYTRACER_INSTRUMENTATION
+TEST(CameraTest, TestPrepassRaysAreCountedOnEveryWorker) {
+    scene::World world = scene::World::DefaultWorld();
+    scene::Camera camera{40, 40, M_PI / 3};
+    camera.SetThreadCount(4);
+    camera.SetTileOrder(scene::TileOrder::kPrepass);
+    camera.SetTransform(commontypes::ViewTransform{
+        commontypes::Point{0, 0, -5}, commontypes::Point{0, 0, 0}, commontypes::Vector{0, 1, 0}});
+
+    instrumentation::MergeThreadCounters();
+    instrumentation::ResetTotalCounters();
+    camera.Render(world);
+
+    // every worker (the calling thread included) merges its counts once each pass ends, so
+    // nothing is left behind on the calling thread
+    const auto primary = static_cast<size_t>(instrumentation::RayKind::kPrimary);
+    ASSERT_EQ(instrumentation::ThreadCounters().rays_[primary], 0);
+    const scene::RenderStats layout{camera.hsize(), camera.vsize()};
+    const auto totals = instrumentation::TotalCounters();
+    ASSERT_EQ(totals.rays_[primary], camera.hsize() * camera.vsize() + 4 * layout.n_tiles());
+}
+#endif
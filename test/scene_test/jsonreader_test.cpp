@@ -0,0 +1,107 @@
+#include "jsonreader.h"
+#include <gtest/gtest.h>
+
+TEST(JsonReaderTest, TestReadingNestedValues) {
+    scene::JsonReader reader{R"({"a": 1.5, "b": [true, false, "x"], "c": {"d": -2e3}})"};
+
+    reader.BeginObject();
+    std::string_view key;
+
+    ASSERT_TRUE(reader.NextKey(key));
+    ASSERT_EQ(key, "a");
+    ASSERT_DOUBLE_EQ(reader.ReadNumber(), 1.5);
+
+    ASSERT_TRUE(reader.NextKey(key));
+    ASSERT_EQ(key, "b");
+    reader.BeginArray();
+    ASSERT_TRUE(reader.NextElement());
+    ASSERT_TRUE(reader.ReadBool());
+    ASSERT_TRUE(reader.NextElement());
+    ASSERT_FALSE(reader.ReadBool());
+    ASSERT_TRUE(reader.NextElement());
+    ASSERT_EQ(reader.ReadString(), "x");
+    ASSERT_FALSE(reader.NextElement());
+
+    ASSERT_TRUE(reader.NextKey(key));
+    ASSERT_EQ(key, "c");
+    ASSERT_EQ(reader.Peek(), scene::JsonReader::TokenType::kObjectBegin);
+    reader.BeginObject();
+    ASSERT_TRUE(reader.NextKey(key));
+    ASSERT_EQ(key, "d");
+    ASSERT_DOUBLE_EQ(reader.ReadNumber(), -2000);
+    ASSERT_FALSE(reader.NextKey(key));
+
+    ASSERT_FALSE(reader.NextKey(key));
+    reader.ExpectEnd();
+}
+
+TEST(JsonReaderTest, TestSkippingValues) {
+    scene::JsonReader reader{R"({"skip": {"a": [1, [2, {}], null], "b": "c"}, "keep": 3})"};
+
+    reader.BeginObject();
+    std::string_view key;
+    ASSERT_TRUE(reader.NextKey(key));
+    reader.SkipValue();
+    ASSERT_TRUE(reader.NextKey(key));
+    ASSERT_EQ(key, "keep");
+    ASSERT_DOUBLE_EQ(reader.ReadNumber(), 3);
+    ASSERT_FALSE(reader.NextKey(key));
+}
+
+TEST(JsonReaderTest, TestEmptyContainers) {
+    scene::JsonReader reader{"[[], {}]"};
+
+    reader.BeginArray();
+    ASSERT_TRUE(reader.NextElement());
+    reader.BeginArray();
+    ASSERT_FALSE(reader.NextElement());
+    ASSERT_TRUE(reader.NextElement());
+    reader.BeginObject();
+    std::string_view key;
+    ASSERT_FALSE(reader.NextKey(key));
+    ASSERT_FALSE(reader.NextElement());
+}
+
+TEST(JsonReaderTest, TestReadingNumbersFollowsJsonGrammar) {
+    for (const auto& [text, expected] :
+         {std::pair{"0", 0.0}, std::pair{"-0.25", -0.25}, std::pair{"10", 10.0},
+          std::pair{"1E2", 100.0}, std::pair{"2.5e-1", 0.25}, std::pair{"3e+0", 3.0}}) {
+        scene::JsonReader reader{text};
+        ASSERT_DOUBLE_EQ(reader.ReadNumber(), expected);
+        reader.ExpectEnd();
+    }
+
+    for (const char* text :
+         {"nan", "-nan", "inf", "-infinity", "01", "-01", ".5", "5.", "1e", "1e+", "-", "+1",
+          "1e999"}) {
+        scene::JsonReader reader{text};
+        ASSERT_THROW(reader.ReadNumber(), scene::ParseError) << text;
+    }
+}
+
+TEST(JsonReaderTest, TestMalformedInputReportsLine) {
+    scene::JsonReader reader{"{\n\"a\": 1\n\"b\": 2}"};
+
+    reader.BeginObject();
+    std::string_view key;
+    ASSERT_TRUE(reader.NextKey(key));
+    reader.ReadNumber();
+
+    try {
+        reader.NextKey(key);
+        FAIL() << "expected a ParseError for the missing comma";
+    } catch (const scene::ParseError& e) {
+        ASSERT_STREQ(e.what(), "line 3: expected ','");
+    }
+}
+
+TEST(JsonReaderTest, TestInvalidValues) {
+    ASSERT_THROW(scene::JsonReader{"abc"}.ReadNumber(), scene::ParseError);
+    ASSERT_THROW(scene::JsonReader{R"("unterminated)"}.ReadString(), scene::ParseError);
+    ASSERT_THROW(scene::JsonReader{R"("a\"b")"}.ReadString(), scene::ParseError);
+    ASSERT_THROW(scene::JsonReader{"nope"}.ReadBool(), scene::ParseError);
+
+    scene::JsonReader trailing{"1 2"};
+    trailing.ReadNumber();
+    ASSERT_THROW(trailing.ExpectEnd(), scene::ParseError);
+}
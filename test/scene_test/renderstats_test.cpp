@@ -0,0 +1,83 @@
+#include "renderstats.h"
+#include <gtest/gtest.h>
+#include "camera.h"
+#include "viewtransform.h"
+#include "world.h"
+
+TEST(RenderStatsTest, TestTilesCoverTheImage) {
+    const scene::RenderStats stats{40, 20};
+    ASSERT_EQ(stats.n_tiles_x(), 3);
+    ASSERT_EQ(stats.n_tiles_y(), 2);
+    ASSERT_EQ(stats.n_tiles(), 6);
+
+    const auto tiles = stats.Tiles();
+    ASSERT_EQ(tiles.size(), 6);
+
+    // last tile in each row and column is partial
+    const scene::Tile last = tiles.back();
+    ASSERT_EQ(last.x0_, 32);
+    ASSERT_EQ(last.y0_, 16);
+    ASSERT_EQ(last.x1_, 40);
+    ASSERT_EQ(last.y1_, 20);
+
+    size_t n_pixels{0};
+    for (const auto& tile : tiles) {
+        n_pixels += (tile.x1_ - tile.x0_) * (tile.y1_ - tile.y0_);
+    }
+    ASSERT_EQ(n_pixels, 40 * 20);
+}
+
+TEST(RenderStatsTest, TestTileCostIsSumOfPixelCosts) {
+    scene::RenderStats stats{20, 20};
+    stats.RecordPixel(0, 0, 100, 1);
+    stats.RecordPixel(15, 15, 50, 3);
+    stats.RecordPixel(16, 0, 7, 2);
+
+    ASSERT_EQ(stats.TileNanoseconds(0), 150);
+    ASSERT_EQ(stats.TileRays(0), 4);
+    ASSERT_EQ(stats.TileNanoseconds(1), 7);
+    ASSERT_EQ(stats.TotalRays(), 6);
+}
+
+TEST(RenderStatsTest, TestMraysPerSecond) {
+    scene::RenderStats stats{1, 2};
+    ASSERT_DOUBLE_EQ(stats.MraysPerSecond(), 0.0);
+
+    stats.RecordPixel(0, 0, 0, 1'500'000);
+    stats.RecordPixel(0, 1, 0, 1'500'000);
+    stats.SetElapsed(std::chrono::duration<double>(2.0));
+    ASSERT_DOUBLE_EQ(stats.MraysPerSecond(), 1.5);
+}
+
+TEST(RenderStatsTest, TestHeatmapMapsMostExpensivePixelToWhite) {
+    scene::RenderStats stats{2, 1};
+    stats.RecordPixel(0, 0, 0, 1);
+    stats.RecordPixel(1, 0, 1000, 1);
+
+    const canvas::Canvas heatmap = stats.Heatmap();
+    ASSERT_EQ(heatmap.width(), 2);
+    ASSERT_EQ(heatmap.height(), 1);
+    ASSERT_TRUE(heatmap.GetPixel(0, 0) == commontypes::Color::MakeBlack());
+    ASSERT_TRUE(heatmap.GetPixel(1, 0) == commontypes::Color::MakeWhite());
+}
+
+TEST(RenderStatsTest, TestRenderRecordsRaysForEveryPixel) {
+    scene::World world = scene::World::DefaultWorld();
+    scene::Camera camera{11, 11, M_PI_2};
+    camera.SetTransform(commontypes::ViewTransform{
+        commontypes::Point{0, 0, -5}, commontypes::Point{0, 0, 0}, commontypes::Vector{0, 1, 0}});
+
+    scene::RenderStats stats{1, 1};
+    camera.Render(world, stats);
+
+    ASSERT_EQ(stats.width(), 11);
+    ASSERT_EQ(stats.height(), 11);
+    for (size_t y = 0; y < 11; ++y) {
+        for (size_t x = 0; x < 11; ++x) {
+            ASSERT_GE(stats.PixelRays(x, y), 1);
+        }
+    }
+
+    // the center pixel hits the sphere and so also casts a shadow ray
+    ASSERT_GE(stats.PixelRays(5, 5), 2);
+}
@@ -0,0 +1,372 @@
+#include "sceneloader.h"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include "blendpattern.h"
+#include "csg.h"
+#include "cylinder.h"
+#include "group.h"
+#include "instance.h"
+#include "nestedpattern.h"
+#include "perturbedpattern.h"
+#include "scalingmatrix.h"
+#include "stripepattern.h"
+#include "texturemappattern.h"
+#include "translationmatrix.h"
+#include "trianglemesh.h"
+#include "viewtransform.h"
+
+static const char* const LIGHT =
+    R"("light": {"position": [-10, 10, -10], "intensity": [1, 1, 1]})";
+
+TEST(SceneLoaderTest, TestLoadingCameraAndLight) {
+    const auto description = scene::SceneLoader::LoadString(
+        std::string{"{"} + LIGHT +
+        R"(, "camera": {"width": 100, "height": 50, "field_of_view": 0.785,
+                        "from": [0, 1.5, -5], "to": [0, 1, 0], "up": [0, 1, 0]}})");
+
+    ASSERT_TRUE(description.camera_.has_value());
+    ASSERT_EQ(description.camera_->hsize(), 100);
+    ASSERT_EQ(description.camera_->vsize(), 50);
+    ASSERT_DOUBLE_EQ(description.camera_->field_of_view(), 0.785);
+    ASSERT_TRUE(description.camera_->transform() ==
+                commontypes::ViewTransform(commontypes::Point{0, 1.5, -5},
+                                           commontypes::Point{0, 1, 0},
+                                           commontypes::Vector{0, 1, 0}));
+
+    const lighting::PointLight expected_light{commontypes::Point{-10, 10, -10},
+                                              commontypes::Color{1, 1, 1}};
+    ASSERT_TRUE(*description.world_.light() == expected_light);
+    ASSERT_TRUE(description.world_.objects().empty());
+}
+
+TEST(SceneLoaderTest, TestLoadingSeveralLights) {
+    const auto description = scene::SceneLoader::LoadString(std::string{"{"} + LIGHT + R"(,
+        "lights": [{"position": [10, 10, -10], "intensity": [0.5, 0.5, 0.5]},
+                   {"position": [0, 5, 0]}]})");
+
+    const auto& lights = description.world_.lights();
+    ASSERT_EQ(lights.size(), 3);
+    ASSERT_TRUE(lights[0].position() == commontypes::Point(-10, 10, -10));
+    ASSERT_TRUE(lights[1].intensity() == commontypes::Color(0.5, 0.5, 0.5));
+    ASSERT_TRUE(lights[2].intensity() == commontypes::Color(1, 1, 1));
+
+    ASSERT_THROW(scene::SceneLoader::LoadString(R"({"lights": []})"), scene::ParseError);
+}
+
+TEST(SceneLoaderTest, TestLoadingLightTypes) {
+    const auto description = scene::SceneLoader::LoadString(R"({"lights": [
+        {"type": "spot", "position": [0, 10, 0], "direction": [0, -1, 0], "inner_angle": 0.2,
+         "outer_angle": 0.4},
+        {"type": "directional", "direction": [1, -1, 0], "intensity": [0.5, 0.5, 0.5]}]})");
+
+    const auto& world = description.world_;
+    ASSERT_TRUE(world.lights().empty());
+    ASSERT_EQ(world.spot_lights().size(), 1);
+    ASSERT_TRUE(world.spot_lights()[0] ==
+                lighting::SpotLight(commontypes::Point{0, 10, 0}, commontypes::Vector{0, -1, 0},
+                                    0.2, 0.4, commontypes::Color{1, 1, 1}));
+    ASSERT_EQ(world.directional_lights().size(), 1);
+    ASSERT_TRUE(world.directional_lights()[0] ==
+                lighting::DirectionalLight(commontypes::Vector{1, -1, 0},
+                                           commontypes::Color{0.5, 0.5, 0.5}));
+
+    for (const std::string& scene_text :
+         {std::string{R"({"lights": [{"type": "laser"}]})"},
+          std::string{R"({"lights": [{"direction": [0, -1, 0]}]})"},
+          std::string{R"({"lights": [{"type": "spot", "inner_angle": 1, "outer_angle": 0.5}]})"},
+          std::string{R"({"lights": [{"type": "directional", "outer_angle": 0.5}]})"}}) {
+        ASSERT_THROW(scene::SceneLoader::LoadString(scene_text), scene::ParseError) << scene_text;
+    }
+}
+
+TEST(SceneLoaderTest, TestLoadingAreaLights) {
+    const auto description = scene::SceneLoader::LoadString(R"({"area_lights": [
+        {"corner": [-1, 2, 4], "uvec": [2, 0, 0], "usteps": 4, "vvec": [0, 2, 0], "vsteps": 2,
+         "intensity": [1.5, 1.5, 1.5]}]})");
+
+    ASSERT_TRUE(description.world_.lights().empty());
+    const auto& area_lights = description.world_.area_lights();
+    ASSERT_EQ(area_lights.size(), 1);
+    ASSERT_TRUE(area_lights[0] == lighting::AreaLight(commontypes::Point{-1, 2, 4},
+                                                      commontypes::Vector{2, 0, 0}, 4,
+                                                      commontypes::Vector{0, 2, 0}, 2,
+                                                      commontypes::Color{1.5, 1.5, 1.5}));
+
+    ASSERT_THROW(scene::SceneLoader::LoadString(R"({"area_lights": [{"usteps": 0}]})"),
+                 scene::ParseError);
+}
+
+TEST(SceneLoaderTest, TestTransformsAreAppliedInOrder) {
+    const auto description = scene::SceneLoader::LoadString(
+        std::string{"{"} + LIGHT + R"(, "shapes": [{"type": "sphere", "transform":
+            [["scale", 2, 2, 2], ["translate", 1, 0, 0]]}]})");
+
+    const auto objects = description.world_.objects();
+    ASSERT_EQ(objects.size(), 1);
+    ASSERT_TRUE(objects[0]->Transform() == commontypes::TranslationMatrix(1, 0, 0) *
+                                               commontypes::ScalingMatrix(2, 2, 2));
+}
+
+TEST(SceneLoaderTest, TestLoadingShapesAndGroups) {
+    const auto description = scene::SceneLoader::LoadString(std::string{"{"} + LIGHT + R"(,
+        "shapes": [
+            {"type": "plane"},
+            {"type": "group", "children": [
+                {"type": "cylinder", "minimum": 0, "maximum": 2, "closed": true},
+                {"type": "triangle", "p1": [0, 1, 0], "p2": [-1, 0, 0], "p3": [1, 0, 0]}]}]})");
+
+    const auto objects = description.world_.objects();
+    ASSERT_EQ(objects.size(), 2);
+
+    const auto group = std::dynamic_pointer_cast<geometry::Group>(objects[1]);
+    ASSERT_NE(group, nullptr);
+    const auto children = group->GetChildren();
+    ASSERT_EQ(children.size(), 2);
+    ASSERT_EQ(children[0]->GetParent(), group.get());
+
+    const auto cylinder = std::dynamic_pointer_cast<geometry::Cylinder>(children[0]);
+    ASSERT_NE(cylinder, nullptr);
+    ASSERT_DOUBLE_EQ(cylinder->Minimum(), 0);
+    ASSERT_DOUBLE_EQ(cylinder->Maximum(), 2);
+    ASSERT_TRUE(cylinder->IsCapped());
+}
+
+TEST(SceneLoaderTest, TestIdenticalMaterialsAndPatternsAreShared) {
+    const auto description = scene::SceneLoader::LoadString(std::string{"{"} + LIGHT + R"(,
+        "patterns": {"stripes": {"type": "stripe", "colors": [[1, 0, 0], [0, 0, 1]]}},
+        "materials": {
+            "red": {"color": [1, 0, 0], "diffuse": 0.7},
+            "shiny_red": {"extends": "red", "reflective": 0.5},
+            "striped": {"pattern": "stripes"}},
+        "shapes": [
+            {"type": "sphere", "material": "red"},
+            {"type": "cube", "material": {"color": [1, 0, 0], "diffuse": 0.7}},
+            {"type": "sphere", "material": "shiny_red"},
+            {"type": "plane", "material": "striped"},
+            {"type": "plane", "material": {"pattern":
+                {"type": "stripe", "colors": [[1, 0, 0], [0, 0, 1]]}, "ambient": 0.2}},
+            {"type": "sphere"},
+            {"type": "cube"}]})");
+
+    const auto objects = description.world_.objects();
+    ASSERT_EQ(objects.size(), 7);
+
+    // the named material and its inline duplicate
+    ASSERT_EQ(objects[0]->Material(), objects[1]->Material());
+    ASSERT_NE(objects[0]->Material(), objects[2]->Material());
+    ASSERT_DOUBLE_EQ(objects[2]->Material()->Diffuse(), 0.7);
+    ASSERT_DOUBLE_EQ(objects[2]->Material()->Reflective(), 0.5);
+
+    // distinct materials, sharing the named pattern and its inline duplicate
+    ASSERT_NE(objects[3]->Material(), objects[4]->Material());
+    ASSERT_EQ(objects[3]->Material()->Pattern(), objects[4]->Material()->Pattern());
+    const auto stripes =
+        std::dynamic_pointer_cast<pattern::StripePattern>(objects[3]->Material()->Pattern());
+    ASSERT_NE(stripes, nullptr);
+    ASSERT_TRUE(stripes->ColorA() == commontypes::Color(1, 0, 0));
+
+    // the default material
+    ASSERT_EQ(objects[5]->Material(), objects[6]->Material());
+    ASSERT_TRUE(*objects[5]->Material() == lighting::Material{});
+}
+
+TEST(SceneLoaderTest, TestUnknownCommentKeysAreSkipped) {
+    const auto description = scene::SceneLoader::LoadString(
+        std::string{R"({"comment": ["anything", {"at": 1}], )"} + LIGHT + "}");
+    ASSERT_FALSE(description.camera_.has_value());
+}
+
+TEST(SceneLoaderTest, TestInvalidScenes) {
+    const std::string light{LIGHT};
+    for (const std::string& scene_text :
+         {std::string{R"({"shapes": []})"},  // no light
+          "{" + light + R"(, "shapes": [{"type": "torus"}]})",
+          "{" + light + R"(, "shapes": [{"type": "sphere", "material": "undefined"}]})",
+          "{" + light + R"(, "shapes": [{"type": "sphere", "minimum": 1}]})",
+          "{" + light + R"(, "shapes": [{"type": "triangle", "p1": [0, 0, 0]}]})",
+          "{" + light +
+              R"(, "shapes": [{"type": "triangle", "p1": [0, 0, 0], "p1": [1, 0, 0],
+                               "p2": [0, 1, 0]}]})",
+          "{" + light + R"(, "shapes": [{"type": "sphere", "transform": [["scale", 1]]}]})",
+          "{" + light + R"(, "materials": {"m": {"diffuse": 1, "extends": "m"}}})",
+          "{" + light + R"(, "camera": {"width": 10}})"}) {
+        ASSERT_THROW(scene::SceneLoader::LoadString(scene_text), scene::ParseError) << scene_text;
+    }
+}
+
+TEST(SceneLoaderTest, TestLoadingMissingFile) {
+    ASSERT_THROW(scene::SceneLoader::LoadFile("does/not/exist.json"), std::runtime_error);
+}
+
+TEST(SceneLoaderTest, TestLoadingMeshRelativeToSceneFile) {
+    const auto dir = std::filesystem::temp_directory_path() / "sceneloader_test";
+    std::filesystem::create_directories(dir);
+    {
+        std::ofstream obj{dir / "square.obj"};
+        obj << "v -1 1 0\nv -1 0 0\nv 1 0 0\nv 1 1 0\nf 1 2 3 4\n";
+        std::ofstream scene{dir / "scene.json"};
+        scene << "{" << LIGHT << R"(, "shapes": [{"type": "mesh", "file": "square.obj",
+                                                  "material": {"color": [1, 0, 0]}}]})";
+    }
+
+    const auto description = scene::SceneLoader::LoadFile(dir / "scene.json");
+    std::filesystem::remove_all(dir);
+
+    const auto objects = description.world_.objects();
+    ASSERT_EQ(objects.size(), 1);
+    const auto mesh = std::dynamic_pointer_cast<geometry::TriangleMesh>(objects[0]);
+    ASSERT_NE(mesh, nullptr);
+    ASSERT_EQ(mesh->mesh()->n_triangles(), 2);
+    ASSERT_TRUE(mesh->Material()->Color() == commontypes::Color(1, 0, 0));
+}
+
+TEST(SceneLoaderTest, TestLoadingSharedTexture) {
+    const auto dir = std::filesystem::temp_directory_path() / "sceneloader_texture_test";
+    std::filesystem::create_directories(dir);
+    {
+        std::ofstream{dir / "red.ppm"} << "P3\n1 1\n255\n255 0 0\n";
+        std::ofstream scene{dir / "scene.json"};
+        scene << "{" << LIGHT << R"(, "shapes": [
+            {"type": "sphere", "material": {"pattern": {"type": "texture", "file": "red.ppm"}}},
+            {"type": "cube", "material": {"pattern": {"type": "texture", "file": "red.ppm",
+                                                      "mapping": "cubic", "mip_level": 1}}}]})";
+    }
+
+    const auto description = scene::SceneLoader::LoadFile(dir / "scene.json");
+    std::filesystem::remove_all(dir);
+
+    const auto objects = description.world_.objects();
+    const auto sphere_texture =
+        std::dynamic_pointer_cast<pattern::TextureMapPattern>(objects[0]->Material()->Pattern());
+    const auto cube_texture =
+        std::dynamic_pointer_cast<pattern::TextureMapPattern>(objects[1]->Material()->Pattern());
+    ASSERT_NE(sphere_texture, nullptr);
+    ASSERT_NE(cube_texture, nullptr);
+    ASSERT_EQ(sphere_texture->mapping(), pattern::UVMapping::kSpherical);
+    ASSERT_EQ(cube_texture->mapping(), pattern::UVMapping::kCubic);
+    ASSERT_EQ(cube_texture->mip_level(), 1);
+    ASSERT_EQ(sphere_texture->texture(), cube_texture->texture());
+
+    ASSERT_THROW(scene::SceneLoader::LoadString(std::string{"{"} + LIGHT + R"(,
+        "shapes": [{"type": "sphere", "material": {"pattern": {"type": "texture"}}}]})"),
+                 scene::ParseError);
+    ASSERT_THROW(scene::SceneLoader::LoadString(std::string{"{"} + LIGHT + R"(,
+        "shapes": [{"type": "sphere",
+                    "material": {"pattern": {"type": "texture", "file": "missing.ppm"}}}]})"),
+                 scene::ParseError);
+}
+
+TEST(SceneLoaderTest, TestLoadingPerturbedPattern) {
+    const auto description = scene::SceneLoader::LoadString(std::string{"{"} + LIGHT + R"(,
+        "patterns": {"stripes": {"type": "stripe", "colors": [[1, 0, 0], [0, 0, 1]]}},
+        "shapes": [
+            {"type": "sphere", "material": {"pattern": {"type": "perturbed", "pattern": "stripes",
+                                                        "scale": 0.5, "octaves": 2}}},
+            {"type": "plane", "material": {"pattern": {"type": "perturbed",
+                                                       "pattern": {"type": "checker"}}}}]})");
+
+    const auto objects = description.world_.objects();
+    const auto wavy =
+        std::dynamic_pointer_cast<pattern::PerturbedPattern>(objects[0]->Material()->Pattern());
+    ASSERT_NE(wavy, nullptr);
+    ASSERT_DOUBLE_EQ(wavy->scale(), 0.5);
+    ASSERT_EQ(wavy->octaves(), 2);
+    ASSERT_NE(std::dynamic_pointer_cast<const pattern::StripePattern>(wavy->pattern()), nullptr);
+    const auto rough =
+        std::dynamic_pointer_cast<pattern::PerturbedPattern>(objects[1]->Material()->Pattern());
+    ASSERT_NE(rough, nullptr);
+    ASSERT_DOUBLE_EQ(rough->scale(), 0.2);
+
+    ASSERT_THROW(scene::SceneLoader::LoadString(std::string{"{"} + LIGHT + R"(,
+        "shapes": [{"type": "sphere", "material": {"pattern": {"type": "perturbed"}}}]})"),
+                 scene::ParseError);
+}
+
+TEST(SceneLoaderTest, TestLoadingCompositePatterns) {
+    const auto description = scene::SceneLoader::LoadString(std::string{"{"} + LIGHT + R"(,
+        "patterns": {"stripes": {"type": "stripe", "colors": [[1, 0, 0], [0, 0, 1]]},
+                     "rings": {"type": "radial_gradient", "colors": [[1, 1, 1], [0, 1, 0]]}},
+        "shapes": [
+            {"type": "sphere", "material": {"pattern": {"type": "checker",
+                                                        "patterns": ["stripes", "rings"]}}},
+            {"type": "plane", "material": {"pattern": {"type": "blend", "weight": 0.25,
+                                                       "patterns": ["stripes", "rings"]}}}]})");
+
+    const auto objects = description.world_.objects();
+    const auto checkers =
+        std::dynamic_pointer_cast<pattern::NestedPattern>(objects[0]->Material()->Pattern());
+    ASSERT_NE(checkers, nullptr);
+    ASSERT_EQ(checkers->kind(), pattern::NestedPattern::Kind::kChecker);
+    const auto blend =
+        std::dynamic_pointer_cast<pattern::BlendPattern>(objects[1]->Material()->Pattern());
+    ASSERT_NE(blend, nullptr);
+    ASSERT_DOUBLE_EQ(blend->weight(), 0.25);
+    // the named patterns are shared between the two
+    ASSERT_EQ(checkers->PatternA(), blend->PatternA());
+    ASSERT_EQ(checkers->PatternB(), blend->PatternB());
+
+    ASSERT_THROW(scene::SceneLoader::LoadString(std::string{"{"} + LIGHT + R"(,
+        "shapes": [{"type": "sphere", "material": {"pattern": {"type": "blend"}}}]})"),
+                 scene::ParseError);
+    ASSERT_THROW(scene::SceneLoader::LoadString(std::string{"{"} + LIGHT + R"(,
+        "patterns": {"stripes": {"type": "stripe"}},
+        "shapes": [{"type": "sphere", "material": {"pattern": {
+            "type": "blend", "weight": 2, "patterns": ["stripes", "stripes"]}}}]})"),
+                 scene::ParseError);
+}
+
+TEST(SceneLoaderTest, TestLoadingCSG) {
+    auto description = scene::SceneLoader::LoadString(std::string{"{"} + LIGHT + R"(,
+        "shapes": [{"type": "csg", "operation": "difference", "children": [
+            {"type": "cube"},
+            {"type": "sphere", "transform": [["scale", 1.2, 1.2, 1.2]]}]}]})");
+
+    const auto csg = std::dynamic_pointer_cast<geometry::CSG>(description.world_.objects()[0]);
+    ASSERT_NE(csg, nullptr);
+    ASSERT_EQ(csg->operation(), geometry::CSG::Operation::kDifference);
+
+    // the cube's corner remains, and its faces' centers are cut away
+    description.world_.Finalize();
+    const auto corner = description.world_.Intersect(
+        commontypes::Ray{commontypes::Point{0.95, 0.95, -5}, commontypes::Vector{0, 0, 1}});
+    ASSERT_EQ(corner.size(), 2);
+    ASSERT_DOUBLE_EQ(corner[0].t_, 4);
+    ASSERT_TRUE(description.world_
+                    .Intersect(commontypes::Ray{commontypes::Point{0, 0, -5},
+                                                commontypes::Vector{0, 0, 1}})
+                    .empty());
+
+    ASSERT_THROW(scene::SceneLoader::LoadString(std::string{"{"} + LIGHT + R"(,
+        "shapes": [{"type": "csg", "operation": "union", "children": [{"type": "cube"}]}]})"),
+                 scene::ParseError);
+    ASSERT_THROW(scene::SceneLoader::LoadString(std::string{"{"} + LIGHT + R"(,
+        "shapes": [{"type": "csg", "operation": "xor",
+                    "children": [{"type": "cube"}, {"type": "sphere"}]}]})"),
+                 scene::ParseError);
+}
+
+TEST(SceneLoaderTest, TestLoadingInstancesOfPrototype) {
+    const auto description = scene::SceneLoader::LoadString(std::string{"{"} + LIGHT + R"(,
+        "prototypes": {"post": {"type": "cylinder", "minimum": 0, "maximum": 1,
+                                "material": {"color": [0, 1, 0]}}},
+        "shapes": [
+            {"type": "instance", "of": "post", "transform": [["translate", 2, 0, 0]]},
+            {"type": "instance", "of": "post", "material": {"color": [1, 0, 0]}}]})");
+
+    const auto objects = description.world_.objects();
+    ASSERT_EQ(objects.size(), 2);
+
+    const auto i1 = std::dynamic_pointer_cast<geometry::Instance>(objects[0]);
+    const auto i2 = std::dynamic_pointer_cast<geometry::Instance>(objects[1]);
+    ASSERT_NE(i1, nullptr);
+    ASSERT_NE(i2, nullptr);
+    ASSERT_EQ(i1->prototype(), i2->prototype());
+    ASSERT_EQ(i1->material_override(), nullptr);
+    ASSERT_TRUE(i2->material_override()->Color() == commontypes::Color(1, 0, 0));
+    ASSERT_TRUE(i1->Transform() == commontypes::TranslationMatrix(2, 0, 0));
+
+    const std::string undefined_prototype =
+        std::string{"{"} + LIGHT + R"(, "shapes": [{"type": "instance", "of": "x"}]})";
+    ASSERT_THROW(scene::SceneLoader::LoadString(undefined_prototype), scene::ParseError);
+}
@@ -0,0 +1,85 @@
+#include "workstealingscheduler.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include "camera.h"
+#include "viewtransform.h"
+#include "world.h"
+
+TEST(WorkStealingSchedulerTest, TestEveryTaskRunsExactlyOnce) {
+    scene::WorkStealingScheduler scheduler{4};
+    std::vector<size_t> tasks(1000);
+    std::iota(tasks.begin(), tasks.end(), 0);
+
+    std::vector<std::atomic<int>> run_counts(tasks.size());
+    std::atomic<size_t> n_exited{0};
+    scheduler.Run(
+        tasks, [&run_counts](const size_t, const size_t task) { ++run_counts[task]; },
+        [&n_exited](const size_t) { ++n_exited; });
+
+    for (const auto& run_count : run_counts) {
+        ASSERT_EQ(run_count.load(), 1);
+    }
+    ASSERT_EQ(n_exited.load(), 4);
+}
+
+TEST(WorkStealingSchedulerTest, TestSingleWorkerRunsTasksInOrder) {
+    scene::WorkStealingScheduler scheduler{1};
+    const std::vector<size_t> tasks{5, 3, 9, 0};
+    std::vector<size_t> ran{};
+
+    scheduler.Run(tasks, [&ran](const size_t worker_idx, const size_t task) {
+        ASSERT_EQ(worker_idx, 0);
+        ran.push_back(task);
+    });
+
+    ASSERT_EQ(ran, tasks);
+    ASSERT_EQ(scheduler.steal_count(), 0);
+}
+
+TEST(WorkStealingSchedulerTest, TestIdleWorkerStealsFromBusyWorker) {
+    // tasks are dealt {0, 2} to worker 0 and {1, 3} to worker 1. task 0 blocks until worker 1
+    // has run three tasks, which it can only do by stealing task 2 from worker 0
+    scene::WorkStealingScheduler scheduler{2};
+    const std::vector<size_t> tasks{0, 1, 2, 3};
+    std::atomic<size_t> n_run_by_1{0};
+
+    scheduler.Run(tasks, [&n_run_by_1](const size_t worker_idx, const size_t task) {
+        if (worker_idx == 1) {
+            ++n_run_by_1;
+        }
+        while (task == 0 && n_run_by_1.load() < 3) {
+            std::this_thread::yield();
+        }
+    });
+
+    ASSERT_GE(n_run_by_1.load(), 3);
+    ASSERT_GE(scheduler.steal_count(), 1);
+}
+
+TEST(WorkStealingSchedulerTest, TestRenderIsIndependentOfThreadsAndTileOrder) {
+    scene::World world = scene::World::DefaultWorld();
+    scene::Camera camera{37, 21, M_PI_2};
+    camera.SetTransform(commontypes::ViewTransform{
+        commontypes::Point{0, 0, -5}, commontypes::Point{0, 0, 0}, commontypes::Vector{0, 1, 0}});
+
+    camera.SetThreadCount(1);
+    const canvas::Canvas expected = camera.Render(world);
+
+    camera.SetThreadCount(4);
+    for (const auto tile_order : {scene::TileOrder::kScanline, scene::TileOrder::kPrepass,
+                                  scene::TileOrder::kPreviousFrame}) {
+        camera.SetTileOrder(tile_order);
+        scene::RenderStats stats{1, 1};
+        const canvas::Canvas first = camera.Render(world, stats);
+        const canvas::Canvas second = camera.Render(world, stats);  // reuses the frame's costs
+
+        for (size_t y = 0; y < camera.vsize(); ++y) {
+            for (size_t x = 0; x < camera.hsize(); ++x) {
+                ASSERT_TRUE(first.GetPixel(x, y) == expected.GetPixel(x, y));
+                ASSERT_TRUE(second.GetPixel(x, y) == expected.GetPixel(x, y));
+            }
+        }
+    }
+}
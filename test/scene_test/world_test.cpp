@@ -1,5 +1,8 @@
 #include "world.h"
 #include <gtest/gtest.h>
+#include <thread>
+#include "identitymatrix.h"
+#include "lighting.h"
 #include "pattern.h"
 #include "plane.h"
 #include "scalingmatrix.h"
@@ -144,6 +147,18 @@ TEST(WorldTest, TestNoShadowWhenNothingIsCollinearWithPointAndLight) {
     EXPECT_FALSE(is_shadowed);
 }
 
+TEST(WorldTest, TestNoShadowWithoutPointLight) {
+    scene::World w = scene::World::DefaultWorld();
+    // the World's own light, rather than a copy of it
+    ASSERT_EQ(w.light(), &w.lights().front());
+
+    w.SetLight(nullptr);
+    w.AddLight(lighting::DirectionalLight{commontypes::Vector{0, -1, 0},
+                                          commontypes::Color{1, 1, 1}});
+    ASSERT_TRUE(w.light() == nullptr);
+    EXPECT_FALSE(w.IsShadowed(commontypes::Point{10, -10, 10}));
+}
+
 TEST(WorldTest, TestTheShadowWhenObjectIsBetweenPointAndLight) {
     scene::World w = scene::World::DefaultWorld();
     const commontypes::Point p{10, -10, 10};
@@ -453,3 +468,346 @@ TEST(WorldTest, TestShadeHitWithReflectiveAndTransparentMaterial) {
 
     ASSERT_TRUE(color == commontypes::Color(0.93391, 0.69643, 0.69243));
 }
+
+TEST(WorldTest, TestSettingRecursionLimit) {
+    scene::World w = scene::World::DefaultWorld();
+    ASSERT_EQ(w.recursion_limit(), 5);
+    w.SetRecursionLimit(2);
+    ASSERT_EQ(w.recursion_limit(), 2);
+}
+
+TEST(WorldTest, TestFinalizingWorldCachesTransforms) {
+    scene::World w = scene::World::DefaultWorld();
+    commontypes::Ray r{commontypes::Point{0, 0, -5}, commontypes::Vector{0, 0, 1}};
+    const commontypes::Color expected = w.ColorAt(r);
+
+    w.Finalize();
+    for (const auto& object : w.objects()) {
+        ASSERT_TRUE(object->HasCachedTransforms());
+    }
+    ASSERT_TRUE(w.ColorAt(r) == expected);
+}
+
+TEST(WorldTest, TestFinalizedWorldIntersectsPrimitives) {
+    scene::World w = scene::World::DefaultWorld();
+    std::shared_ptr<geometry::Shape> plane = std::make_shared<geometry::Plane>();
+    plane->SetTransform(commontypes::TranslationMatrix{0, -1, 0});
+    w.AddObject(plane);
+    const commontypes::Ray r{commontypes::Point{0, 0, -5},
+                             commontypes::Vector{commontypes::Vector{0, -0.5, 1}.Normalize()}};
+    const auto expected = w.Intersect(r);
+
+    w.Finalize();
+    const auto xs = w.Intersect(r);
+    ASSERT_EQ(xs.size(), expected.size());
+    for (size_t i = 0; i < xs.size(); ++i) {
+        ASSERT_TRUE(xs[i] == expected[i] || *xs[i].object_ == *expected[i].object_);
+        ASSERT_NEAR(xs[i].t_, expected[i].t_, 1e-9);
+    }
+}
+
+TEST(WorldTest, TestFinalizingWorldIndexesMaterials) {
+    scene::World w = scene::World::DefaultWorld();
+    const auto material = w.objects().front()->Material();
+    auto sphere = std::make_shared<geometry::Sphere>();
+    sphere->SetMaterial(material);
+    // out of the Ray's path, so the hit is always the outer Sphere
+    sphere->SetTransform(commontypes::TranslationMatrix{5, 0, 0});
+    w.AddObject(sphere);
+    commontypes::Ray r{commontypes::Point{0, 0, -5}, commontypes::Vector{0, 0, 1}};
+    const commontypes::Color expected = w.ColorAt(r);
+
+    // Shapes that share a Material share its record
+    w.Finalize();
+    ASSERT_NE(sphere->material_index(), lighting::MaterialTable::NO_INDEX);
+    ASSERT_EQ(sphere->material_index(), w.objects().front()->material_index());
+    ASSERT_NE(w.objects()[1]->material_index(), sphere->material_index());
+    ASSERT_TRUE(w.ColorAt(r) == expected);
+
+    // a Material replaced since is shaded without a record
+    auto red = std::make_shared<lighting::Material>();
+    red->SetColor(commontypes::Color{1, 0, 0});
+    w.objects().front()->SetMaterial(red);
+    ASSERT_EQ(w.objects().front()->material_index(), lighting::MaterialTable::NO_INDEX);
+    const commontypes::Color replaced = w.ColorAt(r);
+    ASSERT_NEAR(replaced.Green(), 0.0, 1e-9);
+    ASSERT_GT(replaced.Red(), 0.0);
+}
+
+TEST(WorldTest, TestAddingObjectsConcurrently) {
+    scene::World w{};
+    std::vector<std::thread> threads{};
+    for (size_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&w]() {
+            for (size_t i = 0; i < 100; ++i) {
+                w.AddObjectConcurrently(std::make_shared<geometry::Sphere>());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_TRUE(w.objects().empty());
+    w.Finalize();
+    ASSERT_EQ(w.objects().size(), 400);
+
+    const commontypes::Ray r{commontypes::Point{0, 0, -5}, commontypes::Vector{0, 0, 1}};
+    ASSERT_EQ(w.Intersect(r).size(), 800);
+}
+
+TEST(WorldTest, TestShadingWithSeveralLights) {
+    scene::World w = scene::World::DefaultWorld();
+    const lighting::PointLight first = w.lights().front();
+    const lighting::PointLight second{commontypes::Point{10, 2, -10},
+                                      commontypes::Color{0.5, 0.5, 0.5}};
+    w.AddLight(second);
+    ASSERT_EQ(w.lights().size(), 2);
+
+    commontypes::Ray r{commontypes::Point{0, 0, -5}, commontypes::Vector{0, 0, 1}};
+    const auto shape = w.objects().at(0);
+    const geometry::Computations comps = geometry::Intersection{4, shape}.PrepareComputations(r);
+
+    // the sum of each light's contribution
+    commontypes::Color expected = commontypes::Color::MakeBlack();
+    for (const auto& light : {first, second}) {
+        expected = commontypes::Color{
+            expected + lighting::Lighting(shape->Material(), commontypes::IdentityMatrix{}, light,
+                                          comps.over_point_, comps.eye_vector_,
+                                          comps.normal_vector_,
+                                          w.IsShadowed(light, comps.over_point_))};
+    }
+    ASSERT_TRUE(w.ShadeHit(comps) == expected);
+    ASSERT_FALSE(w.ShadeHit(comps) == commontypes::Color(0.38066, 0.47583, 0.2855));
+
+    // SetLight replaces every light
+    w.SetLight(std::make_shared<lighting::PointLight>(first));
+    ASSERT_EQ(w.lights().size(), 1);
+    ASSERT_TRUE(w.ShadeHit(comps) == commontypes::Color(0.38066, 0.47583, 0.2855));
+}
+
+TEST(WorldTest, TestLightBehindSurfaceCastsNoShadowRay) {
+    scene::World w = scene::World::DefaultWorld();
+    w.AddLight(lighting::PointLight{commontypes::Point{0, 0, 10}, commontypes::Color{1, 1, 1}});
+
+    commontypes::Ray r{commontypes::Point{0, 0, -5}, commontypes::Vector{0, 0, 1}};
+    const geometry::Computations comps =
+        geometry::Intersection{4, w.objects().at(0)}.PrepareComputations(r);
+
+    // only the ambient term of the light behind the surface is added
+    const uint64_t rays_before = scene::World::ThreadRaysCast();
+    const commontypes::Color c = w.ShadeHit(comps);
+    ASSERT_EQ(scene::World::ThreadRaysCast() - rays_before, 1);
+    ASSERT_TRUE(c == commontypes::Color(0.46066, 0.57583, 0.3455));
+}
+
+TEST(WorldTest, TestFindingOccludedShadowRays) {
+    scene::World w = scene::World::DefaultWorld();
+    const std::vector<lighting::PointLight> lights{
+        lighting::PointLight{commontypes::Point{-10, 10, -10}, commontypes::Color{1, 1, 1}},
+        lighting::PointLight{commontypes::Point{10, -10, 10}, commontypes::Color{1, 1, 1}},
+        lighting::PointLight{commontypes::Point{0, 0, 0}, commontypes::Color{1, 1, 1}},
+        lighting::PointLight{commontypes::Point{-2, 2, -2}, commontypes::Color{1, 1, 1}}};
+
+    // the batched rays, both before and after finalizing, agree with a ray cast for each light
+    for (const auto& point : {commontypes::Point{10, -10, 10}, commontypes::Point{0, 10, 0},
+                              commontypes::Point{0, 0, -5}, commontypes::Point{3, 0.2, 0}}) {
+        for (const bool finalize : {false, true}) {
+            if (finalize) {
+                w.Finalize();
+            }
+
+            commontypes::ArenaVector<geometry::ShadowRay> rays{};
+            for (const auto& light : lights) {
+                const commontypes::Vector v = commontypes::Vector{light.position() - point};
+                rays.push_back({commontypes::Vector{v.Normalize()}, v.Magnitude(), false});
+            }
+            w.FindOccluded(point, rays);
+
+            for (size_t i = 0; i < lights.size(); ++i) {
+                ASSERT_EQ(rays[i].occluded_, w.IsShadowed(lights[i], point));
+            }
+        }
+    }
+}
+
+TEST(WorldTest, TestAreaLightIntensityIsSampledAdaptively) {
+    scene::World w = scene::World::DefaultWorld();
+    const lighting::AreaLight light{commontypes::Point{-0.5, -0.5, -5},
+                                    commontypes::Vector{1, 0, 0},
+                                    8,
+                                    commontypes::Vector{0, 1, 0},
+                                    8,
+                                    commontypes::Color{1, 1, 1}};
+
+    // fully lit and fully shadowed points need only the four corner samples, while a point in the
+    // penumbra needs every sample
+    for (const bool finalize : {false, true}) {
+        if (finalize) {
+            w.Finalize();
+        }
+
+        for (const auto& [point, expected_rays] :
+             {std::pair{commontypes::Point{0, 0, -2}, 4},
+              std::pair{commontypes::Point{0, 0, 2}, 4},
+              std::pair{commontypes::Point{1.5, 0, 2}, 64}}) {
+            const uint64_t rays_before = scene::World::ThreadRaysCast();
+            const double intensity = w.IntensityAt(light, point);
+            ASSERT_EQ(scene::World::ThreadRaysCast() - rays_before, expected_rays);
+            ASSERT_DOUBLE_EQ(intensity, w.IntensityAt(light, point));
+
+            if (point.z() < 0) {
+                ASSERT_DOUBLE_EQ(intensity, 1.0);
+            } else if (point.x() == 0) {
+                ASSERT_DOUBLE_EQ(intensity, 0.0);
+            } else {
+                ASSERT_GT(intensity, 0.1);
+                ASSERT_LT(intensity, 0.9);
+            }
+        }
+    }
+}
+
+TEST(WorldTest, TestShadingWithAreaLight) {
+    scene::World w = scene::World::DefaultWorld();
+    w.SetLight(nullptr);
+    const lighting::AreaLight light{commontypes::Point{-10.5, 9.5, -10},
+                                    commontypes::Vector{1, 0, 0},
+                                    4,
+                                    commontypes::Vector{0, 1, 0},
+                                    4,
+                                    commontypes::Color{1, 1, 1}};
+    w.AddAreaLight(light);
+
+    commontypes::Ray r{commontypes::Point{0, 0, -5}, commontypes::Vector{0, 0, 1}};
+    const auto shape = w.objects().at(0);
+    const geometry::Computations comps = geometry::Intersection{4, shape}.PrepareComputations(r);
+
+    // nothing is between the point and the light
+    const commontypes::Color expected =
+        lighting::Lighting(shape->Material(), commontypes::IdentityMatrix{}, light,
+                           comps.over_point_, comps.eye_vector_, comps.normal_vector_, 1.0);
+    ASSERT_TRUE(w.ShadeHit(comps) == expected);
+
+    // a light behind the surface casts no shadow rays
+    w.AddAreaLight(lighting::AreaLight{commontypes::Point{-0.5, -0.5, 10},
+                                       commontypes::Vector{1, 0, 0}, 4,
+                                       commontypes::Vector{0, 1, 0}, 4,
+                                       commontypes::Color{1, 1, 1}});
+    const uint64_t rays_before = scene::World::ThreadRaysCast();
+    const commontypes::Color c = w.ShadeHit(comps);
+    ASSERT_EQ(scene::World::ThreadRaysCast() - rays_before, 4);
+    const commontypes::Color ambient{0.08, 0.1, 0.06};
+    ASSERT_TRUE(c == commontypes::Color(expected + ambient));
+}
+
+TEST(WorldTest, TestOccluderCacheMatchesUncachedShadows) {
+    scene::World w{};
+    w.AddLight(lighting::PointLight{commontypes::Point{0, 10, 0}, commontypes::Color{1, 1, 1}});
+    w.AddLight(lighting::PointLight{commontypes::Point{10, 10, 0}, commontypes::Color{1, 1, 1}});
+
+    auto floor = std::make_shared<geometry::Plane>();
+    auto blocker = std::make_shared<geometry::Sphere>();
+    blocker->SetTransform(commontypes::TranslationMatrix{0, 5, 0} *
+                          commontypes::ScalingMatrix{2, 2, 2});
+    w.AddObjects({floor, blocker});
+
+    // the expected shadows, without the cache
+    std::vector<commontypes::Point> points{};
+    std::vector<bool> expected{};
+    for (double x = -3; x <= 3; x += 0.25) {
+        for (const auto& light : w.lights()) {
+            points.emplace_back(x, 0.001, 0.1);
+            expected.push_back(w.IsShadowed(light, points.back()));
+        }
+    }
+
+    w.Finalize();
+    const scene::OccluderCacheStats before = scene::World::ThreadOccluderCacheStats();
+    size_t n_shadowed = 0;
+    for (size_t i = 0; i < points.size(); ++i) {
+        const lighting::PointLight& light = w.lights()[i % 2];
+        const commontypes::Vector v = commontypes::Vector{light.position() - points[i]};
+        commontypes::ArenaVector<geometry::ShadowRay> rays{
+            {commontypes::Vector{v.Normalize()}, v.Magnitude(), false,
+             static_cast<uint32_t>(i % 2)}};
+        w.FindOccluded(points[i], rays);
+        ASSERT_EQ(rays[0].occluded_, expected[i]) << i;
+        n_shadowed += expected[i] ? 1 : 0;
+    }
+    const scene::OccluderCacheStats after = scene::World::ThreadOccluderCacheStats();
+
+    // every shadowed point after the first for each light finds its occluder in the cache
+    ASSERT_GT(n_shadowed, 4);
+    ASSERT_EQ(after.lookups_ - before.lookups_, points.size());
+    ASSERT_GE(after.hits_ - before.hits_, n_shadowed - 2);
+
+    // IsShadowed looks up the slot it's given in the same way
+    for (size_t i = 0; i < points.size(); ++i) {
+        ASSERT_EQ(w.IsShadowed(w.lights()[i % 2], points[i], static_cast<uint32_t>(i % 2)),
+                  expected[i])
+            << i;
+    }
+    const scene::OccluderCacheStats after_is_shadowed = scene::World::ThreadOccluderCacheStats();
+    ASSERT_EQ(after_is_shadowed.lookups_ - after.lookups_, points.size());
+    ASSERT_GE(after_is_shadowed.hits_ - after.hits_, n_shadowed);
+
+    // finalizing again discards the cache
+    w.Finalize();
+    const scene::OccluderCacheStats before_refinalize = scene::World::ThreadOccluderCacheStats();
+    ASSERT_TRUE(w.IsShadowed(commontypes::Point{0, 0.001, 0}));
+    ASSERT_EQ(scene::World::ThreadOccluderCacheStats().hits_, before_refinalize.hits_);
+}
+
+TEST(WorldTest, TestShadingWithSpotAndDirectionalLights) {
+    scene::World w = scene::World::DefaultWorld();
+    commontypes::Ray r{commontypes::Point{0, 0, -5}, commontypes::Vector{0, 0, 1}};
+    const auto shape = w.objects().at(0);
+    const geometry::Computations comps = geometry::Intersection{4, shape}.PrepareComputations(r);
+    const commontypes::Color point_lit = w.ShadeHit(comps);
+
+    // a SpotLight pointed away from the point adds its ambient term without a shadow ray
+    w.AddLight(lighting::SpotLight{commontypes::Point{0, 0, -10}, commontypes::Vector{0, 1, 0},
+                                   0.2, 0.4, commontypes::Color{1, 1, 1}});
+    uint64_t rays_before = scene::World::ThreadRaysCast();
+    const commontypes::Color spot_lit = w.ShadeHit(comps);
+    ASSERT_EQ(scene::World::ThreadRaysCast() - rays_before, 1);
+    const commontypes::Color ambient{0.08, 0.1, 0.06};
+    ASSERT_TRUE(spot_lit == commontypes::Color(point_lit + ambient));
+
+    // sunlight from behind the camera adds its full contribution
+    const lighting::DirectionalLight sun{commontypes::Vector{0, 0, 1},
+                                         commontypes::Color{1, 1, 1}};
+    w.AddLight(sun);
+    ASSERT_EQ(w.spot_lights().size(), 1);
+    ASSERT_EQ(w.directional_lights().size(), 1);
+    rays_before = scene::World::ThreadRaysCast();
+    const commontypes::Color sun_lit = w.ShadeHit(comps);
+    ASSERT_EQ(scene::World::ThreadRaysCast() - rays_before, 2);
+    const commontypes::Color sun_contribution =
+        lighting::Lighting(shape->Material(), commontypes::IdentityMatrix{}, sun,
+                           comps.over_point_, comps.eye_vector_, comps.normal_vector_);
+    ASSERT_TRUE(sun_lit == commontypes::Color(spot_lit + sun_contribution));
+
+    // the sun is blocked by everything along its direction, however far
+    ASSERT_TRUE(w.IsShadowed(sun, commontypes::Point{0, 0, 100}));
+    ASSERT_FALSE(w.IsShadowed(sun, commontypes::Point{0, 5, 100}));
+}
+
+TEST(WorldTest, TestRefittingOnlyUpdatesTransformedShapes) {
+    scene::World w = scene::World::DefaultWorld();
+    ASSERT_EQ(w.Refit(), 2);  // finalizes a World that isn't yet
+    ASSERT_EQ(w.Refit(), 0);
+
+    w.objects()[1]->SetTransform(commontypes::TranslationMatrix{0, 0, -2});
+    ASSERT_EQ(w.Refit(), 1);
+    const auto xs =
+        w.Intersect(commontypes::Ray{commontypes::Point{0, 0, -5}, commontypes::Vector{0, 0, 1}});
+    ASSERT_EQ(xs.size(), 4);
+    ASSERT_DOUBLE_EQ(xs[0].t_, 2);
+    ASSERT_DOUBLE_EQ(xs[1].t_, 4);
+
+    w.ReplaceLight(0, lighting::PointLight{commontypes::Point{0, 10, 0}, commontypes::Color{}});
+    ASSERT_TRUE(w.lights()[0].position() == commontypes::Point(0, 10, 0));
+    ASSERT_THROW(w.ReplaceLight(1, lighting::PointLight{}), std::out_of_range);
+}